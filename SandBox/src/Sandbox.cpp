@@ -1,9 +1,12 @@
 #include <Vex.h>
 
+#include <cstdlib>
+
 class Sandbox : public Vex::Application
 {
 public:
-	Sandbox()
+	Sandbox(const Vex::ApplicationSpecification& specification, uint64_t frameLimit)
+		: Application(specification), m_FrameLimit(frameLimit)
 	{
 		
 	}
@@ -12,9 +15,44 @@ public:
 	{
 		
 	}
+
+	void OnUpdate([[maybe_unused]] Vex::Timestep ts) override
+	{
+		if (m_FrameLimit && ++m_Frames >= m_FrameLimit)
+			Close();
+	}
+
+private:
+	uint64_t m_FrameLimit;	// 0 runs until the window is closed
+	uint64_t m_Frames = 0;
 };
 
-Vex::Application* Vex::CreateApplication()
+Vex::LogSpecification Vex::GetLogSpecification()
+{
+	// Engine defaults: synchronous in Debug, asynchronous otherwise
+	return Vex::LogSpecification();
+}
+
+Vex::Application* Vex::CreateApplication(Vex::ApplicationCommandLineArgs args)
 {
-	return new Sandbox();
+	Vex::ApplicationSpecification specification;
+
+	// `--headless` runs without a window and logs frame times and CPU use every second,
+	// e.g. `Sandbox --headless --frames 600 --fps 60` to see what the frame pacer costs
+	if (args.Find("--headless") > 0)
+	{
+		specification.Headless = true;
+		specification.FrameStatsReportInterval = 1.0;
+	}
+
+	int fps = args.Find("--fps");
+	if (fps > 0 && fps + 1 < args.Count)
+		specification.TargetFrameRate = std::strtod(args[fps + 1], nullptr);
+
+	uint64_t frameLimit = 0;
+	int frames = args.Find("--frames");
+	if (frames > 0 && frames + 1 < args.Count)
+		frameLimit = std::strtoull(args[frames + 1], nullptr, 10);
+
+	return new Sandbox(specification, frameLimit);
 }
\ No newline at end of file
@@ -0,0 +1,28 @@
+﻿#include "VexPch.h"
+#include "HeadlessRenderer2DBackend.h"
+
+namespace Vex
+{
+    TextureHandle HeadlessRenderer2DBackend::CreateTexture(const uint32_t*, uint32_t, uint32_t)
+    {
+        return ++m_LastTexture;
+    }
+
+    QuadVertex* HeadlessRenderer2DBackend::MapVertices(uint32_t vertexCount)
+    {
+        std::vector<QuadVertex>& buffer = m_VertexBuffers[m_Frame++ % FramesInFlight];
+
+        // Only ever grows, like a GPU buffer reallocated for a larger scene
+        if (buffer.size() < vertexCount)
+            buffer.resize(vertexCount);
+
+        m_MappedVertices = buffer.data();
+        return m_MappedVertices;
+    }
+
+    void HeadlessRenderer2DBackend::Submit(const Renderer2DDrawCall* drawCalls, uint32_t drawCallCount)
+    {
+        m_DrawCalls.assign(drawCalls, drawCalls + drawCallCount);
+        m_SubmittedVertices = m_MappedVertices;
+    }
+}
@@ -0,0 +1,40 @@
+﻿#pragma once
+
+#include "Vex/Renderer/Renderer2DBackend.h"
+
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * Renderer2D backend that draws nothing.
+     *
+     * Vertex memory is a set of plain buffers standing in for persistently mapped ones, one per frame in
+     * flight, so Renderer2D does the same work as with a GPU backend. The last frame's draw calls and
+     * vertices can be inspected, which is what benchmarks and headless runs need.
+     */
+    class VEX_API HeadlessRenderer2DBackend : public Renderer2DBackend
+    {
+    public:
+        static constexpr uint32_t FramesInFlight = 2;
+
+        TextureHandle CreateTexture(const uint32_t* pixels, uint32_t width, uint32_t height) override;
+        QuadVertex* MapVertices(uint32_t vertexCount) override;
+        void Submit(const Renderer2DDrawCall* drawCalls, uint32_t drawCallCount) override;
+
+        /** @return Draw calls of the last frame submitted. */
+        const std::vector<Renderer2DDrawCall>& GetDrawCalls() const { return m_DrawCalls; }
+
+        /** @return Vertices of the last frame submitted. */
+        const QuadVertex* GetVertices() const { return m_SubmittedVertices; }
+
+    private:
+        std::vector<QuadVertex> m_VertexBuffers[FramesInFlight];
+        uint32_t m_Frame = 0;
+        QuadVertex* m_MappedVertices = nullptr;
+        const QuadVertex* m_SubmittedVertices = nullptr;
+
+        std::vector<Renderer2DDrawCall> m_DrawCalls;
+        TextureHandle m_LastTexture = 0;
+    };
+}
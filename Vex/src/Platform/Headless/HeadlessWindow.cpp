@@ -0,0 +1,203 @@
+﻿#include "VexPch.h"
+#include "HeadlessWindow.h"
+
+#include "Vex/Events/ApplicationEvent.h"
+#include "Vex/Events/KeyEvent.h"
+#include "Vex/Events/MouseEvent.h"
+#include "Vex/Input/Input.h"
+#include "Vex/Log.h"
+#include "Vex/Debug/Instrumentor.h"
+
+namespace Vex
+{
+    HeadlessWindow::HeadlessWindow(const WindowProps& props)
+    {
+        m_Data.Width = props.Width;
+        m_Data.Height = props.Height;
+        m_Data.UpdateInputState = props.UpdateInputState;
+
+        VEX_CORE_INFO("Creating headless window {0} ({1}, {2})", props.Title, props.Width, props.Height);
+    }
+
+    HeadlessWindow::~HeadlessWindow()
+    {
+        if (m_Coalescer.IsEnabled())
+        {
+            VEX_CORE_INFO("Coalesced away {0} mouse move and {1} mouse scroll events",
+                m_Coalescer.GetStats().MouseMovedMerged, m_Coalescer.GetStats().MouseScrolledMerged);
+        }
+    }
+
+    void HeadlessWindow::OnUpdate()
+    {
+        VEX_PROFILE_FUNCTION();
+
+        if (m_Data.UpdateInputState)
+            Input::BeginFrame();
+
+        if (m_InputGenerator)
+            m_InputGenerator(*this, m_PumpCount);
+        m_PumpCount++;
+
+        {
+            std::lock_guard<std::mutex> lock(m_InjectMutex);
+            m_Delivering.swap(m_Injected);
+        }
+
+        uint32_t enabledTypes = m_Data.EnabledEventTypes.load(std::memory_order_relaxed);
+
+        m_Coalescer.BeginPump();
+
+        for (const InjectedInput& input : m_Delivering)
+        {
+            if (!(enabledTypes & EventTypeBit(input.Type)))
+                continue;
+
+            uint64_t timestamp = input.Timestamp;
+
+            // Anything other than motion or scroll must not overtake the mouse events held back so far
+            if (input.Type != EventType::MouseMoved && input.Type != EventType::MouseScrolled)
+                FlushCoalescedEvents();
+
+            switch (input.Type)
+            {
+            case EventType::WindowClose:
+                Emit<WindowCloseEvent>(timestamp);
+                break;
+
+            case EventType::WindowResize:
+                m_Data.Width = static_cast<unsigned int>(input.X);
+                m_Data.Height = static_cast<unsigned int>(input.Y);
+                Emit<WindowResizeEvent>(timestamp, static_cast<unsigned int>(input.X), static_cast<unsigned int>(input.Y));
+                break;
+
+            case EventType::KeyPressed:
+                if (m_Data.UpdateInputState)
+                    Input::UpdateKey(Input::GetScancode(static_cast<KeyCode>(input.Code)), true);
+                Emit<KeyPressedEvent>(timestamp, static_cast<KeyCode>(input.Code), input.IsRepeat);
+                break;
+
+            case EventType::KeyReleased:
+                if (m_Data.UpdateInputState)
+                    Input::UpdateKey(Input::GetScancode(static_cast<KeyCode>(input.Code)), false);
+                Emit<KeyReleasedEvent>(timestamp, static_cast<KeyCode>(input.Code));
+                break;
+
+            case EventType::KeyTyped:
+                Emit<KeyTypedEvent>(timestamp, static_cast<KeyCode>(input.Code));
+                break;
+
+            case EventType::MouseMoved:
+            {
+                float deltaX = input.X - m_MouseX;
+                float deltaY = input.Y - m_MouseY;
+                m_MouseX = input.X;
+                m_MouseY = input.Y;
+                if (m_Data.UpdateInputState)
+                    Input::UpdateMousePosition(input.X, input.Y, deltaX, deltaY);
+
+                if (!m_Coalescer.AddMotion(timestamp, input.X, input.Y, deltaX, deltaY))
+                    Emit<MouseMovedEvent>(timestamp, input.X, input.Y, deltaX, deltaY);
+                break;
+            }
+
+            case EventType::MouseScrolled:
+                if (m_Data.UpdateInputState)
+                    Input::UpdateScroll(input.X, input.Y);
+
+                if (!m_Coalescer.AddScroll(timestamp, input.X, input.Y))
+                    Emit<MouseScrolledEvent>(timestamp, input.X, input.Y);
+                break;
+
+            case EventType::MouseButtonPressed:
+                if (m_Data.UpdateInputState)
+                    Input::UpdateMouseButton(static_cast<MouseCode>(input.Code), true);
+                Emit<MouseButtonPressedEvent>(timestamp, static_cast<MouseCode>(input.Code));
+                break;
+
+            case EventType::MouseButtonReleased:
+                if (m_Data.UpdateInputState)
+                    Input::UpdateMouseButton(static_cast<MouseCode>(input.Code), false);
+                Emit<MouseButtonReleasedEvent>(timestamp, static_cast<MouseCode>(input.Code));
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        m_Delivering.clear();
+
+        // One motion and one scroll event per frame at most when coalescing
+        FlushCoalescedEvents();
+    }
+
+    void HeadlessWindow::FlushCoalescedEvents()
+    {
+        m_Coalescer.Flush(
+            [this](uint64_t timestamp, float x, float y, float deltaX, float deltaY) { Emit<MouseMovedEvent>(timestamp, x, y, deltaX, deltaY); },
+            [this](uint64_t timestamp, float xOffset, float yOffset) { Emit<MouseScrolledEvent>(timestamp, xOffset, yOffset); });
+    }
+
+    void HeadlessWindow::SetEventTypeEnabled(EventType type, bool enabled)
+    {
+        if (type == EventType::WindowClose)
+            return;
+
+        if (enabled)
+            m_Data.EnabledEventTypes.fetch_or(EventTypeBit(type), std::memory_order_relaxed);
+        else
+            m_Data.EnabledEventTypes.fetch_and(~EventTypeBit(type), std::memory_order_relaxed);
+    }
+
+    void HeadlessWindow::Inject(const InjectedInput& input)
+    {
+        std::lock_guard<std::mutex> lock(m_InjectMutex);
+        m_Injected.push_back(input);
+    }
+
+    void HeadlessWindow::InjectKeyPressed(KeyCode key, bool isRepeat)
+    {
+        Inject({ EventType::KeyPressed, Event::Now(), static_cast<uint32_t>(key), isRepeat, 0.0f, 0.0f });
+    }
+
+    void HeadlessWindow::InjectKeyReleased(KeyCode key)
+    {
+        Inject({ EventType::KeyReleased, Event::Now(), static_cast<uint32_t>(key), false, 0.0f, 0.0f });
+    }
+
+    void HeadlessWindow::InjectKeyTyped(KeyCode key)
+    {
+        Inject({ EventType::KeyTyped, Event::Now(), static_cast<uint32_t>(key), false, 0.0f, 0.0f });
+    }
+
+    void HeadlessWindow::InjectMouseMoved(float x, float y)
+    {
+        Inject({ EventType::MouseMoved, Event::Now(), 0, false, x, y });
+    }
+
+    void HeadlessWindow::InjectMouseScrolled(float xOffset, float yOffset)
+    {
+        Inject({ EventType::MouseScrolled, Event::Now(), 0, false, xOffset, yOffset });
+    }
+
+    void HeadlessWindow::InjectMouseButtonPressed(MouseCode button)
+    {
+        Inject({ EventType::MouseButtonPressed, Event::Now(), static_cast<uint32_t>(button), false, 0.0f, 0.0f });
+    }
+
+    void HeadlessWindow::InjectMouseButtonReleased(MouseCode button)
+    {
+        Inject({ EventType::MouseButtonReleased, Event::Now(), static_cast<uint32_t>(button), false, 0.0f, 0.0f });
+    }
+
+    void HeadlessWindow::InjectResize(unsigned int width, unsigned int height)
+    {
+        Inject({ EventType::WindowResize, Event::Now(), 0, false, static_cast<float>(width), static_cast<float>(height) });
+    }
+
+    void HeadlessWindow::InjectClose()
+    {
+        Inject({ EventType::WindowClose, Event::Now(), 0, false, 0.0f, 0.0f });
+    }
+}
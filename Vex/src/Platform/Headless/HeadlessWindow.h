@@ -0,0 +1,153 @@
+﻿#pragma once
+
+#include "Vex/Window.h"
+#include "Vex/Events/EventQueue.h"
+#include "Vex/Input/KeyCodes.h"
+#include "Vex/Input/MouseCodes.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * Window implementation with no display and no SDL dependency.
+     *
+     * Used on Linux and for benchmarks: nothing is ever rendered, and the only input is what gets
+     * injected through the Inject* functions or the input generator. Injected input is buffered like an
+     * OS event queue and delivered in order on the next OnUpdate, with the same mouse coalescing rules
+     * as the SDL backend. The Inject* functions may be called from any thread, and every event carries
+     * the time it was injected as its timestamp.
+     */
+    class VEX_API HeadlessWindow : public Window
+    {
+    public:
+        /**
+         * Called at the start of every OnUpdate, before buffered input is delivered.
+         * Receives the window to inject into and the number of pumps so far.
+         */
+        using InputGeneratorFn = std::function<void(HeadlessWindow& window, uint64_t pump)>;
+
+        /**
+         * Constructs a new HeadlessWindow with the specified properties.
+         * @param props The properties to initialize the window with; only the size is used.
+         */
+        HeadlessWindow(const WindowProps& props);
+
+        virtual ~HeadlessWindow();
+
+        /**
+         * Runs the input generator and delivers all input injected since the last call.
+         */
+        void OnUpdate() override;
+
+        /**
+         * @return The current width of the window.
+         */
+        unsigned int GetWidth() override { return m_Data.Width; }
+
+        /**
+         * @return The current height of the window.
+         */
+        unsigned int GetHeight() override { return m_Data.Height; }
+
+        /**
+         * @return Always nullptr; there is no platform window.
+         */
+        void* GetNativeWindow() const override { return nullptr; }
+
+        inline void SetEventCallback(const EventCallbackFn& callback) override { m_Data.EventCallback = callback; }
+        inline void SetEventQueue(EventQueue* queue) override { m_Data.Queue = queue; }
+        inline void SetEventCoalescing(bool enabled) override { m_Coalescer.SetEnabled(enabled); }
+        inline bool IsEventCoalescing() const override { return m_Coalescer.IsEnabled(); }
+        inline const EventCoalescingStats& GetCoalescingStats() const override { return m_Coalescer.GetStats(); }
+
+        /** Disabled types are discarded when the injected input is delivered, as if the OS had dropped them. */
+        void SetEventTypeEnabled(EventType type, bool enabled) override;
+        bool IsEventTypeEnabled(EventType type) const override { return m_Data.EnabledEventTypes.load(std::memory_order_relaxed) & EventTypeBit(type); }
+
+        /**
+         * Installs a callback that injects synthetic input at the start of every pump.
+         * @param generator The generator, or an empty function to remove it.
+         */
+        void SetInputGenerator(const InputGeneratorFn& generator) { m_InputGenerator = generator; }
+
+        void InjectKeyPressed(KeyCode key, bool isRepeat = false);
+        void InjectKeyReleased(KeyCode key);
+        void InjectKeyTyped(KeyCode key);
+        void InjectMouseMoved(float x, float y);
+        void InjectMouseScrolled(float xOffset, float yOffset);
+        void InjectMouseButtonPressed(MouseCode button);
+        void InjectMouseButtonReleased(MouseCode button);
+
+        /** Queues a WindowResizeEvent; the window takes the new size when the event is delivered. */
+        void InjectResize(unsigned int width, unsigned int height);
+
+        /** Queues a WindowCloseEvent, e.g. to end a benchmark after a fixed number of frames. */
+        void InjectClose();
+
+        /** @return Number of times OnUpdate has run. */
+        uint64_t GetPumpCount() const { return m_PumpCount; }
+
+    private:
+        /**
+         * Emits any mouse motion or scroll events held back by coalescing, in the order they started.
+         */
+        void FlushCoalescedEvents();
+
+        /**
+         * Delivers an event: appended to the event queue when one is set,
+         * otherwise constructed on the stack and passed to the event callback.
+         * @param timestamp When the input was injected, on the Event::Now() clock.
+         * @param args Arguments forwarded to the event constructor.
+         */
+        template<typename T, typename... Args>
+        void Emit(uint64_t timestamp, Args&&... args)
+        {
+            if (m_Data.Queue)
+            {
+                m_Data.Queue->Push<T>(std::forward<Args>(args)...).Timestamp = timestamp;
+                return;
+            }
+
+            T e(std::forward<Args>(args)...);
+            e.Timestamp = timestamp;
+            if (m_Data.EventCallback)
+                m_Data.EventCallback(e);
+        }
+
+    private:
+        /**
+         * Injected input waiting for the next pump. Plain data, so injecting never constructs events.
+         */
+        struct InjectedInput
+        {
+            EventType Type;
+            uint64_t Timestamp; ///< Event::Now() at injection.
+            uint32_t Code;      ///< Key or mouse button.
+            bool IsRepeat;
+            float X, Y;         ///< Mouse position, scroll offsets or window size.
+        };
+
+        struct WindowData
+        {
+            unsigned int Width = 0, Height = 0;
+            EventCallbackFn EventCallback;
+            EventQueue* Queue = nullptr;
+            bool UpdateInputState = true;
+            std::atomic<uint32_t> EnabledEventTypes{ AllEventTypes };
+        };
+
+        WindowData m_Data;
+        void Inject(const InjectedInput& input);
+
+        std::mutex m_InjectMutex;
+        std::vector<InjectedInput> m_Injected;      ///< Filled by Inject*; guarded by m_InjectMutex.
+        std::vector<InjectedInput> m_Delivering;    ///< Swapped with m_Injected each pump; both keep their capacity.
+        InputGeneratorFn m_InputGenerator;
+        MouseEventCoalescer m_Coalescer;
+        float m_MouseX = 0.0f, m_MouseY = 0.0f;   ///< Last delivered mouse position, used to derive motion deltas.
+        uint64_t m_PumpCount = 0;
+    };
+}
@@ -0,0 +1,56 @@
+﻿#include "VexPch.h"
+#include "Vex/Memory/MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Vex
+{
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    bool MappedFile::Open(const std::string& path)
+    {
+        Close();
+
+        int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0)
+            return false;
+
+        struct stat info;
+        if (fstat(file, &info) != 0 || info.st_size == 0)
+        {
+            close(file);
+            return false;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+        // The mapping keeps its own reference to the file
+        close(file);
+
+        if (view == MAP_FAILED)
+            return false;
+
+        madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+        m_Data = static_cast<const std::byte*>(view);
+        m_Size = static_cast<size_t>(info.st_size);
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data)
+            munmap(const_cast<std::byte*>(m_Data), m_Size);
+
+        m_Data = nullptr;
+        m_Size = 0;
+        m_FileHandle = nullptr;
+        m_MappingHandle = nullptr;
+    }
+}
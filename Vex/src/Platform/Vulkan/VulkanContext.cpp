@@ -0,0 +1,324 @@
+﻿#include "VexPch.h"
+
+#ifdef VEX_VULKAN
+
+#include "VulkanContext.h"
+
+#include "Vex/Log.h"
+
+#ifdef VEX_PLATFORM_WINDOWS
+    #include <SDL.h>
+    #include <SDL_vulkan.h>
+#endif
+
+#include <atomic>
+#include <cstring>
+
+namespace Vex
+{
+    static std::atomic<uint32_t> s_ValidationErrors{ 0 };
+    static std::atomic<uint32_t> s_ValidationWarnings{ 0 };
+
+    /**
+     * Receives validation layer messages, possibly on driver threads.
+     */
+    static VKAPI_ATTR VkBool32 VKAPI_CALL OnValidationMessage(VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+        VkDebugUtilsMessageTypeFlagsEXT, const VkDebugUtilsMessengerCallbackDataEXT* data, void*)
+    {
+        const char* message = data && data->pMessage ? data->pMessage : "";
+
+        if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)
+        {
+            s_ValidationErrors.fetch_add(1, std::memory_order_relaxed);
+            VEX_CORE_ERROR("Vulkan validation: {0}", message);
+        }
+        else
+        {
+            s_ValidationWarnings.fetch_add(1, std::memory_order_relaxed);
+            VEX_CORE_WARN("Vulkan validation: {0}", message);
+        }
+
+        // Returning true would make the offending call fail, which the same call without the layer would not
+        return VK_FALSE;
+    }
+
+    uint32_t VulkanContext::GetValidationErrorCount()
+    {
+        return s_ValidationErrors.load(std::memory_order_relaxed);
+    }
+
+    uint32_t VulkanContext::GetValidationWarningCount()
+    {
+        return s_ValidationWarnings.load(std::memory_order_relaxed);
+    }
+
+    bool VulkanCheck(VkResult result, const char* call)
+    {
+        if (result == VK_SUCCESS)
+            return true;
+
+        VEX_CORE_ERROR("{0} failed with VkResult {1}", call, static_cast<int>(result));
+        return false;
+    }
+
+    VulkanContext::~VulkanContext()
+    {
+        Shutdown();
+    }
+
+    bool VulkanContext::Init(const char* applicationName, void* nativeWindow)
+    {
+        m_NativeWindow = nativeWindow;
+
+        if (!CreateInstance(applicationName))
+        {
+            Shutdown();
+            return false;
+        }
+
+#ifdef VEX_PLATFORM_WINDOWS
+        if (m_NativeWindow && !SDL_Vulkan_CreateSurface(static_cast<SDL_Window*>(m_NativeWindow), m_Instance, &m_Surface))
+        {
+            VEX_CORE_ERROR("SDL_Vulkan_CreateSurface failed: {0}", SDL_GetError());
+            Shutdown();
+            return false;
+        }
+#endif
+
+        if (!PickPhysicalDevice() || !CreateDevice())
+        {
+            Shutdown();
+            return false;
+        }
+
+        VEX_CORE_INFO("Vulkan device: {0} (API {1}.{2}.{3}){4}", m_Properties.deviceName,
+            VK_VERSION_MAJOR(m_Properties.apiVersion), VK_VERSION_MINOR(m_Properties.apiVersion), VK_VERSION_PATCH(m_Properties.apiVersion),
+            m_Surface ? "" : ", offscreen");
+        return true;
+    }
+
+    void VulkanContext::Shutdown()
+    {
+        if (m_Device)
+        {
+            vkDeviceWaitIdle(m_Device);
+            vkDestroyDevice(m_Device, nullptr);
+        }
+
+        if (m_Surface)
+            vkDestroySurfaceKHR(m_Instance, m_Surface, nullptr);
+
+        if (m_Messenger)
+        {
+            auto destroyMessenger = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(
+                vkGetInstanceProcAddr(m_Instance, "vkDestroyDebugUtilsMessengerEXT"));
+            if (destroyMessenger)
+                destroyMessenger(m_Instance, m_Messenger, nullptr);
+        }
+
+        // Objects leaked past this point are still reported, through the messenger chained to the instance
+        if (m_Instance)
+            vkDestroyInstance(m_Instance, nullptr);
+
+        m_Device = VK_NULL_HANDLE;
+        m_Messenger = VK_NULL_HANDLE;
+        m_Surface = VK_NULL_HANDLE;
+        m_Instance = VK_NULL_HANDLE;
+        m_PhysicalDevice = VK_NULL_HANDLE;
+        m_Queue = VK_NULL_HANDLE;
+    }
+
+    bool VulkanContext::CreateInstance(const char* applicationName)
+    {
+        std::vector<const char*> extensions;
+
+#ifdef VEX_PLATFORM_WINDOWS
+        if (m_NativeWindow)
+        {
+            SDL_Window* window = static_cast<SDL_Window*>(m_NativeWindow);
+
+            unsigned int count = 0;
+            SDL_Vulkan_GetInstanceExtensions(window, &count, nullptr);
+            extensions.resize(count);
+            if (!SDL_Vulkan_GetInstanceExtensions(window, &count, extensions.data()))
+            {
+                VEX_CORE_ERROR("SDL_Vulkan_GetInstanceExtensions failed: {0}", SDL_GetError());
+                return false;
+            }
+        }
+#endif
+
+        std::vector<const char*> layers;
+        VkDebugUtilsMessengerCreateInfoEXT messengerInfo = { VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT };
+        messengerInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+        messengerInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT |
+            VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+        messengerInfo.pfnUserCallback = &OnValidationMessage;
+
+#ifdef VEX_DEBUG
+        // Validation is optional: use it where the layer is installed, run without it elsewhere
+        uint32_t layerCount = 0;
+        vkEnumerateInstanceLayerProperties(&layerCount, nullptr);
+        std::vector<VkLayerProperties> availableLayers(layerCount);
+        vkEnumerateInstanceLayerProperties(&layerCount, availableLayers.data());
+
+        for (const VkLayerProperties& layer : availableLayers)
+        {
+            if (std::strcmp(layer.layerName, "VK_LAYER_KHRONOS_validation") == 0)
+                layers.push_back("VK_LAYER_KHRONOS_validation");
+        }
+
+        // The layer implements VK_EXT_debug_utils itself
+        if (!layers.empty())
+            extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+        else
+            VEX_CORE_WARN("VK_LAYER_KHRONOS_validation is not installed; running without Vulkan validation");
+#endif
+
+        VkApplicationInfo applicationInfo = { VK_STRUCTURE_TYPE_APPLICATION_INFO };
+        applicationInfo.pApplicationName = applicationName;
+        applicationInfo.pEngineName = "Vex";
+        applicationInfo.apiVersion = VK_API_VERSION_1_2;
+
+        VkInstanceCreateInfo createInfo = { VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO };
+        createInfo.pNext = layers.empty() ? nullptr : &messengerInfo;  // Covers vkCreateInstance and vkDestroyInstance
+        createInfo.pApplicationInfo = &applicationInfo;
+        createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+        createInfo.ppEnabledExtensionNames = extensions.data();
+        createInfo.enabledLayerCount = static_cast<uint32_t>(layers.size());
+        createInfo.ppEnabledLayerNames = layers.data();
+
+        if (!VulkanCheck(vkCreateInstance(&createInfo, nullptr, &m_Instance), "vkCreateInstance"))
+            return false;
+
+        if (!layers.empty())
+        {
+            auto createMessenger = reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(
+                vkGetInstanceProcAddr(m_Instance, "vkCreateDebugUtilsMessengerEXT"));
+            if (!createMessenger || !VulkanCheck(createMessenger(m_Instance, &messengerInfo, nullptr, &m_Messenger), "vkCreateDebugUtilsMessengerEXT"))
+                VEX_CORE_WARN("Validation layer active, but its messages are not being counted");
+        }
+
+        return true;
+    }
+
+    /**
+     * Ranks device types; 0 means unusable.
+     */
+    static uint32_t DeviceTypeScore(VkPhysicalDeviceType type)
+    {
+        switch (type)
+        {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:   return 4;
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return 3;
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:    return 2;
+        default:                                     return 1;  // CPU (lavapipe, SwiftShader) and others
+        }
+    }
+
+    bool VulkanContext::PickPhysicalDevice()
+    {
+        uint32_t deviceCount = 0;
+        vkEnumeratePhysicalDevices(m_Instance, &deviceCount, nullptr);
+        std::vector<VkPhysicalDevice> devices(deviceCount);
+        vkEnumeratePhysicalDevices(m_Instance, &deviceCount, devices.data());
+
+        uint32_t bestScore = 0;
+        for (VkPhysicalDevice device : devices)
+        {
+            VkPhysicalDeviceProperties properties;
+            vkGetPhysicalDeviceProperties(device, &properties);
+            if (properties.apiVersion < VK_API_VERSION_1_2)
+                continue;
+
+            VkPhysicalDeviceVulkan12Features features12 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
+            VkPhysicalDeviceFeatures2 features = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
+            features.pNext = &features12;
+            vkGetPhysicalDeviceFeatures2(device, &features);
+            if (!features12.timelineSemaphore)
+                continue;
+
+            uint32_t familyCount = 0;
+            vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, nullptr);
+            std::vector<VkQueueFamilyProperties> families(familyCount);
+            vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, families.data());
+
+            for (uint32_t family = 0; family < familyCount; family++)
+            {
+                if (!(families[family].queueFlags & VK_QUEUE_GRAPHICS_BIT))
+                    continue;
+
+                if (m_Surface)
+                {
+                    VkBool32 canPresent = VK_FALSE;
+                    vkGetPhysicalDeviceSurfaceSupportKHR(device, family, m_Surface, &canPresent);
+                    if (!canPresent)
+                        continue;
+                }
+
+                uint32_t score = DeviceTypeScore(properties.deviceType);
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    m_PhysicalDevice = device;
+                    m_QueueFamily = family;
+                    m_Properties = properties;
+                }
+                break;
+            }
+        }
+
+        if (!m_PhysicalDevice)
+        {
+            VEX_CORE_ERROR("No Vulkan 1.2 device with timeline semaphores{0}", m_Surface ? " that can present to the window" : "");
+            return false;
+        }
+
+        vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &m_MemoryProperties);
+
+        VkPhysicalDeviceProperties2 properties2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+        properties2.pNext = &m_IDProperties;
+        vkGetPhysicalDeviceProperties2(m_PhysicalDevice, &properties2);
+        return true;
+    }
+
+    bool VulkanContext::CreateDevice()
+    {
+        float priority = 1.0f;
+        VkDeviceQueueCreateInfo queueInfo = { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
+        queueInfo.queueFamilyIndex = m_QueueFamily;
+        queueInfo.queueCount = 1;
+        queueInfo.pQueuePriorities = &priority;
+
+        VkPhysicalDeviceVulkan12Features features12 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
+        features12.timelineSemaphore = VK_TRUE;
+
+        const char* swapchainExtension = VK_KHR_SWAPCHAIN_EXTENSION_NAME;
+
+        VkDeviceCreateInfo createInfo = { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
+        createInfo.pNext = &features12;
+        createInfo.queueCreateInfoCount = 1;
+        createInfo.pQueueCreateInfos = &queueInfo;
+        createInfo.enabledExtensionCount = m_Surface ? 1 : 0;
+        createInfo.ppEnabledExtensionNames = &swapchainExtension;
+
+        if (!VulkanCheck(vkCreateDevice(m_PhysicalDevice, &createInfo, nullptr, &m_Device), "vkCreateDevice"))
+            return false;
+
+        vkGetDeviceQueue(m_Device, m_QueueFamily, 0, &m_Queue);
+        return true;
+    }
+
+    uint32_t VulkanContext::FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const
+    {
+        for (uint32_t i = 0; i < m_MemoryProperties.memoryTypeCount; i++)
+        {
+            if ((typeBits & (1u << i)) && (m_MemoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+                return i;
+        }
+
+        return UINT32_MAX;
+    }
+}
+
+#endif
@@ -0,0 +1,83 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <vulkan/vulkan.h>
+
+namespace Vex
+{
+    /**
+     * Logs a failed Vulkan call. Returns true if the call succeeded.
+     */
+    bool VulkanCheck(VkResult result, const char* call);
+
+    /**
+     * @class VulkanContext
+     * @brief Instance, device and queue shared by the Vulkan renderer.
+     *
+     * Requires Vulkan 1.2 with timeline semaphores. Given an SDL window, also creates a surface and picks
+     * a queue that can present to it; without one (headless, e.g. lavapipe on a GPU-less machine) the
+     * context renders offscreen only. Any device type is accepted, preferring discrete GPUs; CPU
+     * implementations come last but still qualify.
+     *
+     * Debug builds enable the Khronos validation layer where it is installed. Its warnings and errors go to
+     * the core logger and are counted, so a run can check that it finished without any.
+     */
+    class VulkanContext
+    {
+    public:
+        VulkanContext() = default;
+        ~VulkanContext();
+
+        VulkanContext(const VulkanContext&) = delete;
+        VulkanContext& operator=(const VulkanContext&) = delete;
+
+        /**
+         * @param applicationName Reported to the driver.
+         * @param nativeWindow SDL_Window to present to, or nullptr to render offscreen.
+         * @return False if no usable device was found; the context is left empty.
+         */
+        bool Init(const char* applicationName, void* nativeWindow);
+        void Shutdown();
+
+        /** @return A memory type allowed by typeBits with all the given properties, or UINT32_MAX. */
+        uint32_t FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
+
+        VkInstance GetInstance() const { return m_Instance; }
+        VkPhysicalDevice GetPhysicalDevice() const { return m_PhysicalDevice; }
+        VkDevice GetDevice() const { return m_Device; }
+        VkQueue GetQueue() const { return m_Queue; }
+        uint32_t GetQueueFamily() const { return m_QueueFamily; }
+        VkSurfaceKHR GetSurface() const { return m_Surface; }
+        void* GetNativeWindow() const { return m_NativeWindow; }
+        const VkPhysicalDeviceProperties& GetProperties() const { return m_Properties; }
+
+        /** @return Device and driver UUIDs, used to tell whether cached driver data still applies. */
+        const VkPhysicalDeviceIDProperties& GetIDProperties() const { return m_IDProperties; }
+
+        /** @return True if the validation layer is active and reporting to the logger. */
+        bool IsValidationEnabled() const { return m_Messenger != VK_NULL_HANDLE; }
+
+        /** @return Validation errors reported by every context since startup, including during shutdown. */
+        static uint32_t GetValidationErrorCount();
+        static uint32_t GetValidationWarningCount();
+
+    private:
+        bool CreateInstance(const char* applicationName);
+        bool PickPhysicalDevice();
+        bool CreateDevice();
+
+        VkInstance m_Instance = VK_NULL_HANDLE;
+        VkDebugUtilsMessengerEXT m_Messenger = VK_NULL_HANDLE;
+        VkSurfaceKHR m_Surface = VK_NULL_HANDLE;
+        VkPhysicalDevice m_PhysicalDevice = VK_NULL_HANDLE;
+        VkDevice m_Device = VK_NULL_HANDLE;
+        VkQueue m_Queue = VK_NULL_HANDLE;
+        uint32_t m_QueueFamily = 0;
+
+        VkPhysicalDeviceProperties m_Properties = {};
+        VkPhysicalDeviceMemoryProperties m_MemoryProperties = {};
+        VkPhysicalDeviceIDProperties m_IDProperties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES };
+        void* m_NativeWindow = nullptr;
+    };
+}
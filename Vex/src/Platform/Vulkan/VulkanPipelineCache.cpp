@@ -0,0 +1,288 @@
+﻿#include "VexPch.h"
+
+#ifdef VEX_VULKAN
+
+#include "VulkanPipelineCache.h"
+
+#include "Vex/Log.h"
+#include "Vex/Memory/MappedFile.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace Vex
+{
+    static uint64_t Fnv1a(const void* data, size_t size, uint64_t hash = 0xCBF29CE484222325ull)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    VulkanPipelineCache::~VulkanPipelineCache()
+    {
+        Shutdown();
+    }
+
+    uint64_t VulkanPipelineCache::HashSource(std::string_view source)
+    {
+        return Fnv1a(source.data(), source.size());
+    }
+
+    void VulkanPipelineCache::Load(const std::string& path, JobSystem* jobSystem)
+    {
+        m_Path = path;
+        m_JobSystem = jobSystem;
+
+        if (m_JobSystem)
+            m_JobSystem->Submit([this]() { ReadFile(); }, &m_LoadJob);
+        else
+            ReadFile();
+    }
+
+    void VulkanPipelineCache::ReadFile()
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        MappedFile file;
+        if (!file.Open(m_Path))
+            return;
+
+        const std::byte* data = file.GetData();
+        size_t size = file.GetSize();
+
+        if (size < sizeof(PipelineCacheFileHeader))
+        {
+            VEX_CORE_WARN("Pipeline cache '{0}' is truncated; ignoring it", m_Path);
+            return;
+        }
+
+        PipelineCacheFileHeader header;
+        std::memcpy(&header, data, sizeof(header));
+
+        if (header.Magic != PipelineCacheFileHeader::MagicValue || header.Version != PipelineCacheFileHeader::CurrentVersion)
+        {
+            VEX_CORE_WARN("Pipeline cache '{0}' has an unsupported format; ignoring it", m_Path);
+            return;
+        }
+
+        const std::byte* payload = data + sizeof(header);
+        size_t payloadSize = size - sizeof(header);
+
+        if (header.PipelineDataSize > payloadSize || Fnv1a(payload, payloadSize) != header.Checksum)
+        {
+            VEX_CORE_WARN("Pipeline cache '{0}' is corrupt; ignoring it", m_Path);
+            return;
+        }
+
+        m_PipelineData.assign(reinterpret_cast<const uint8_t*>(payload), reinterpret_cast<const uint8_t*>(payload) + header.PipelineDataSize);
+
+        size_t offset = header.PipelineDataSize;
+        for (uint32_t i = 0; i < header.ShaderCount; i++)
+        {
+            CachedShaderHeader shader;
+            if (payloadSize - offset < sizeof(shader))
+                break;
+
+            std::memcpy(&shader, payload + offset, sizeof(shader));
+            offset += sizeof(shader);
+
+            if (shader.WordCount > (payloadSize - offset) / sizeof(uint32_t))
+                break;
+
+            std::vector<uint32_t>& words = m_Shaders[shader.SourceHash];
+            words.resize(shader.WordCount);
+            std::memcpy(words.data(), payload + offset, shader.WordCount * sizeof(uint32_t));
+            offset += shader.WordCount * sizeof(uint32_t);
+        }
+
+        m_FileHeader = header;
+        m_Loaded = true;
+        m_LoadMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    bool VulkanPipelineCache::MatchesDevice() const
+    {
+        const PipelineCacheFileHeader& file = m_FileHeader;
+        const PipelineCacheFileHeader& device = m_DeviceHeader;
+
+        return file.VendorID == device.VendorID && file.DeviceID == device.DeviceID && file.DriverVersion == device.DriverVersion
+            && std::memcmp(file.PipelineCacheUUID, device.PipelineCacheUUID, VK_UUID_SIZE) == 0
+            && std::memcmp(file.DeviceUUID, device.DeviceUUID, VK_UUID_SIZE) == 0
+            && std::memcmp(file.DriverUUID, device.DriverUUID, VK_UUID_SIZE) == 0;
+    }
+
+    bool VulkanPipelineCache::Init(const VulkanContext& context)
+    {
+        if (m_JobSystem)
+            m_JobSystem->Wait(m_LoadJob);
+
+        m_Device = context.GetDevice();
+
+        const VkPhysicalDeviceProperties& properties = context.GetProperties();
+        const VkPhysicalDeviceIDProperties& ids = context.GetIDProperties();
+        m_DeviceHeader.VendorID = properties.vendorID;
+        m_DeviceHeader.DeviceID = properties.deviceID;
+        m_DeviceHeader.DriverVersion = properties.driverVersion;
+        std::memcpy(m_DeviceHeader.PipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+        std::memcpy(m_DeviceHeader.DeviceUUID, ids.deviceUUID, VK_UUID_SIZE);
+        std::memcpy(m_DeviceHeader.DriverUUID, ids.driverUUID, VK_UUID_SIZE);
+
+        if (m_Loaded && !MatchesDevice())
+        {
+            VEX_CORE_INFO("Pipeline cache '{0}' was written by another device or driver; pipelines start cold", m_Path);
+            m_PipelineData.clear();
+        }
+
+        VkPipelineCacheCreateInfo createInfo = { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+        createInfo.initialDataSize = m_PipelineData.size();
+        createInfo.pInitialData = m_PipelineData.empty() ? nullptr : m_PipelineData.data();
+
+        if (vkCreatePipelineCache(m_Device, &createInfo, nullptr, &m_Cache) != VK_SUCCESS)
+        {
+            // The driver checks the data again; one that still rejects it gets an empty cache
+            createInfo.initialDataSize = 0;
+            createInfo.pInitialData = nullptr;
+            m_PipelineData.clear();
+
+            if (!VulkanCheck(vkCreatePipelineCache(m_Device, &createInfo, nullptr, &m_Cache), "vkCreatePipelineCache"))
+                return false;
+        }
+
+        m_Warm = !m_PipelineData.empty();
+
+        if (!m_Path.empty())
+        {
+            VEX_CORE_INFO("Pipeline cache {0}: {1} bytes of pipeline data, {2} shaders, read in {3:.2f} ms",
+                m_Warm ? "warm" : "cold", m_PipelineData.size(), m_Shaders.size(), m_LoadMilliseconds);
+        }
+
+        // The driver keeps its own copy
+        std::vector<uint8_t>().swap(m_PipelineData);
+        return true;
+    }
+
+    bool VulkanPipelineCache::Save()
+    {
+        if (!m_Cache || m_Path.empty())
+            return false;
+
+        size_t pipelineDataSize = 0;
+        if (!VulkanCheck(vkGetPipelineCacheData(m_Device, m_Cache, &pipelineDataSize, nullptr), "vkGetPipelineCacheData"))
+            return false;
+
+        std::vector<uint8_t> payload(pipelineDataSize);
+        if (!VulkanCheck(vkGetPipelineCacheData(m_Device, m_Cache, &pipelineDataSize, payload.data()), "vkGetPipelineCacheData"))
+            return false;
+        payload.resize(pipelineDataSize);
+
+        for (const auto& [hash, words] : m_Shaders)
+        {
+            CachedShaderHeader shader = { hash, words.size() };
+            size_t offset = payload.size();
+            payload.resize(offset + sizeof(shader) + words.size() * sizeof(uint32_t));
+            std::memcpy(payload.data() + offset, &shader, sizeof(shader));
+            std::memcpy(payload.data() + offset + sizeof(shader), words.data(), words.size() * sizeof(uint32_t));
+        }
+
+        PipelineCacheFileHeader header = m_DeviceHeader;
+        header.ShaderCount = static_cast<uint32_t>(m_Shaders.size());
+        header.PipelineDataSize = pipelineDataSize;
+        header.Checksum = Fnv1a(payload.data(), payload.size());
+
+        // Write beside the old file and swap it in, so an interrupted save leaves the previous cache intact
+        std::string temporaryPath = m_Path + ".tmp";
+        std::FILE* file = std::fopen(temporaryPath.c_str(), "wb");
+        if (!file)
+        {
+            VEX_CORE_ERROR("Failed to open pipeline cache '{0}' for writing", temporaryPath);
+            return false;
+        }
+
+        bool written = std::fwrite(&header, sizeof(header), 1, file) == 1
+            && std::fwrite(payload.data(), 1, payload.size(), file) == payload.size();
+        written = std::fclose(file) == 0 && written;
+
+        std::error_code error;
+        if (written)
+            std::filesystem::rename(temporaryPath, m_Path, error);
+
+        if (!written || error)
+        {
+            VEX_CORE_ERROR("Failed to write pipeline cache '{0}'", m_Path);
+            std::filesystem::remove(temporaryPath, error);
+            return false;
+        }
+
+        VEX_CORE_INFO("Saved pipeline cache '{0}': {1} bytes of pipeline data, {2} shaders", m_Path, pipelineDataSize, m_Shaders.size());
+        return true;
+    }
+
+    void VulkanPipelineCache::Shutdown()
+    {
+        // The load job writes into this object; it has to finish even if Init() never ran
+        if (m_JobSystem)
+        {
+            m_JobSystem->Wait(m_LoadJob);
+            m_JobSystem = nullptr;
+        }
+
+        if (m_Cache)
+            vkDestroyPipelineCache(m_Device, m_Cache, nullptr);
+        m_Cache = VK_NULL_HANDLE;
+    }
+
+    VkShaderModule VulkanPipelineCache::CreateShaderModule(std::string_view source, const ShaderCompileFunction& compile)
+    {
+        uint64_t hash = HashSource(source);
+
+        const std::vector<uint32_t>* spirv = FindShader(hash);
+        if (spirv)
+        {
+            m_ShaderHits++;
+        }
+        else
+        {
+            m_ShaderMisses++;
+
+            std::vector<uint32_t> compiled;
+            if (!compile(source, compiled) || compiled.empty())
+            {
+                VEX_CORE_ERROR("Shader compilation failed (source hash {0:016x})", hash);
+                return VK_NULL_HANDLE;
+            }
+
+            StoreShader(hash, std::move(compiled));
+            spirv = FindShader(hash);
+        }
+
+        VkShaderModuleCreateInfo createInfo = { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
+        createInfo.codeSize = spirv->size() * sizeof(uint32_t);
+        createInfo.pCode = spirv->data();
+
+        VkShaderModule module = VK_NULL_HANDLE;
+        if (!VulkanCheck(vkCreateShaderModule(m_Device, &createInfo, nullptr, &module), "vkCreateShaderModule"))
+            return VK_NULL_HANDLE;
+
+        return module;
+    }
+
+    const std::vector<uint32_t>* VulkanPipelineCache::FindShader(uint64_t sourceHash) const
+    {
+        auto it = m_Shaders.find(sourceHash);
+        return it != m_Shaders.end() ? &it->second : nullptr;
+    }
+
+    void VulkanPipelineCache::StoreShader(uint64_t sourceHash, std::vector<uint32_t> spirv)
+    {
+        m_Shaders[sourceHash] = std::move(spirv);
+    }
+}
+
+#endif
@@ -0,0 +1,145 @@
+﻿#pragma once
+
+#include "Platform/Vulkan/VulkanContext.h"
+#include "Vex/Jobs/JobSystem.h"
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * @brief Header at the start of every pipeline cache file.
+     *
+     * Followed by PipelineDataSize bytes of VkPipelineCache data, then ShaderCount entries of a
+     * CachedShaderHeader and its SPIR-V words. Checksum covers everything after the header.
+     */
+    struct PipelineCacheFileHeader
+    {
+        static constexpr uint32_t MagicValue = 0x50584556; ///< "VEXP"
+        static constexpr uint32_t CurrentVersion = 1;
+
+        uint32_t Magic = MagicValue;
+        uint32_t Version = CurrentVersion;
+        uint32_t VendorID = 0;
+        uint32_t DeviceID = 0;
+        uint32_t DriverVersion = 0;
+        uint32_t ShaderCount = 0;
+        uint64_t PipelineDataSize = 0;
+        uint64_t Checksum = 0;
+        uint8_t PipelineCacheUUID[VK_UUID_SIZE] = {};
+        uint8_t DeviceUUID[VK_UUID_SIZE] = {};
+        uint8_t DriverUUID[VK_UUID_SIZE] = {};
+    };
+
+    static_assert(sizeof(PipelineCacheFileHeader) == 88, "PipelineCacheFileHeader is part of the cache file format");
+
+    struct CachedShaderHeader
+    {
+        uint64_t SourceHash;
+        uint64_t WordCount;
+    };
+
+    /**
+     * Compiles shader source to SPIR-V. Returns false on a compile error.
+     */
+    using ShaderCompileFunction = std::function<bool(std::string_view source, std::vector<uint32_t>& spirv)>;
+
+    /**
+     * @class VulkanPipelineCache
+     * @brief VkPipelineCache and compiled SPIR-V, persisted to one versioned file between runs.
+     *
+     * Load() reads and checks the file on the job system while the caller goes on creating the instance
+     * and device; Init() waits for it and creates the VkPipelineCache. The pipeline data is only
+     * handed to the driver if the file was written by the same device and driver (vendor, device ID,
+     * driver version, pipeline cache, device and driver UUIDs); otherwise the cache starts cold. SPIR-V
+     * does not depend on the device, so compiled shaders are kept across driver updates.
+     *
+     * Shaders are keyed by a 64-bit hash of their source: CreateShaderModule() only calls the compiler on a
+     * miss. Save() writes the file next to a temporary one and renames it over the old file, so a crash
+     * while saving never leaves a truncated cache behind. Main thread only, apart from the load job.
+     */
+    class VulkanPipelineCache
+    {
+    public:
+        VulkanPipelineCache() = default;
+        ~VulkanPipelineCache();
+
+        VulkanPipelineCache(const VulkanPipelineCache&) = delete;
+        VulkanPipelineCache& operator=(const VulkanPipelineCache&) = delete;
+
+        /**
+         * @brief Starts reading the cache file. A missing or mismatched file is not an error; the cache starts cold.
+         * @param path Cache file to read now and to write on Save().
+         * @param jobSystem Reads the file in the background if given, and must then outlive Init() or Shutdown();
+         * otherwise the file is read before returning.
+         */
+        void Load(const std::string& path, JobSystem* jobSystem = nullptr);
+
+        /**
+         * @brief Waits for the load and creates the VkPipelineCache, seeded from the file if it matches the device.
+         *
+         * Without a prior Load() the cache only lives in memory.
+         * @return False if the VkPipelineCache could not be created.
+         */
+        bool Init(const VulkanContext& context);
+
+        /** Writes the pipeline cache data and all shaders to the file given to Load(). */
+        bool Save();
+
+        void Shutdown();
+
+        /**
+         * @brief Returns a shader module for the source, compiling it only if its SPIR-V is not cached.
+         * @return VK_NULL_HANDLE if compiling or creating the module failed. The caller destroys the module.
+         */
+        VkShaderModule CreateShaderModule(std::string_view source, const ShaderCompileFunction& compile);
+
+        /** @return Cached SPIR-V for a source hash, or nullptr. */
+        const std::vector<uint32_t>* FindShader(uint64_t sourceHash) const;
+
+        /** Adds SPIR-V compiled elsewhere; it is written on the next Save(). */
+        void StoreShader(uint64_t sourceHash, std::vector<uint32_t> spirv);
+
+        /** FNV-1a hash of shader source, the key shaders are cached under. */
+        static uint64_t HashSource(std::string_view source);
+
+        /** Pass to vkCreate*Pipelines. */
+        VkPipelineCache GetHandle() const { return m_Cache; }
+
+        /** @return True if the driver was given pipeline data from a previous run. */
+        bool IsWarm() const { return m_Warm; }
+
+        uint32_t GetShaderHits() const { return m_ShaderHits; }
+        uint32_t GetShaderMisses() const { return m_ShaderMisses; }
+
+        /** @return Time the load job spent reading and checking the file, in milliseconds. */
+        float GetLoadMilliseconds() const { return m_LoadMilliseconds; }
+
+    private:
+        /** Runs on the job system. Reads the file into m_FileHeader, m_PipelineData and m_Shaders. */
+        void ReadFile();
+        bool MatchesDevice() const;
+
+        std::string m_Path;
+        JobSystem* m_JobSystem = nullptr;
+        JobCounter m_LoadJob;
+
+        // Written by the load job, read after Init() has waited for it
+        PipelineCacheFileHeader m_FileHeader;
+        std::vector<uint8_t> m_PipelineData;
+        std::unordered_map<uint64_t, std::vector<uint32_t>> m_Shaders;
+        float m_LoadMilliseconds = 0.0f;
+        bool m_Loaded = false;
+
+        VkDevice m_Device = VK_NULL_HANDLE;
+        VkPipelineCache m_Cache = VK_NULL_HANDLE;
+        PipelineCacheFileHeader m_DeviceHeader;     ///< Identity of the current device, written by Save().
+        bool m_Warm = false;
+        uint32_t m_ShaderHits = 0;
+        uint32_t m_ShaderMisses = 0;
+    };
+}
@@ -0,0 +1,753 @@
+﻿#include "VexPch.h"
+
+#ifdef VEX_VULKAN
+
+#include "VulkanRenderer.h"
+
+#include "Platform/Vulkan/VulkanShaders.h"
+#include "Vex/Debug/Instrumentor.h"
+#include "Vex/Log.h"
+#include "Vex/Window.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+namespace Vex
+{
+    static void TransitionImage(VkCommandBuffer commandBuffer, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
+        VkPipelineStageFlags sourceStage, VkAccessFlags sourceAccess, VkPipelineStageFlags destinationStage, VkAccessFlags destinationAccess)
+    {
+        VkImageMemoryBarrier barrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+        barrier.srcAccessMask = sourceAccess;
+        barrier.dstAccessMask = destinationAccess;
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+        vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    }
+
+    /**
+     * Creates a built-in shader's module through the cache, which on a miss only has to copy the shipped SPIR-V.
+     */
+    static VkShaderModule CreateBuiltinShaderModule(VulkanPipelineCache& cache, const VulkanBuiltinShader& shader)
+    {
+        return cache.CreateShaderModule(shader.Source, [&shader](std::string_view, std::vector<uint32_t>& spirv)
+        {
+            spirv.assign(shader.Spirv, shader.Spirv + shader.WordCount);
+            return true;
+        });
+    }
+
+    VulkanRenderer::VulkanRenderer(Window& window, const VulkanRendererSpecification& specification, JobSystem* jobSystem)
+        : m_Specification(specification), m_Width(window.GetWidth()), m_Height(window.GetHeight())
+    {
+        m_Specification.FramesInFlight = std::max(m_Specification.FramesInFlight, 1u);
+
+        // Reading the cache overlaps instance and device creation
+        if (!m_Specification.PipelineCachePath.empty())
+            m_PipelineCache.Load(m_Specification.PipelineCachePath, jobSystem);
+
+        if (!m_Context.Init("Vex", window.GetNativeWindow()))
+            return;
+
+        if (!m_PipelineCache.Init(m_Context) || !m_StagingRing.Init(m_Context, m_Specification.StagingRingSize) || !CreateFrames()
+            || !CreateTarget() || !CreateQuadPipeline() || !CreateQuadIndexBuffer())
+        {
+            Destroy();
+            return;
+        }
+
+        m_Valid = true;
+    }
+
+    VulkanRenderer::~VulkanRenderer()
+    {
+        Destroy();
+    }
+
+    bool VulkanRenderer::CreateFrames()
+    {
+        VkDevice device = m_Context.GetDevice();
+
+        VkSemaphoreTypeCreateInfo timelineInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO };
+        timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        timelineInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo timelineCreateInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+        timelineCreateInfo.pNext = &timelineInfo;
+
+        if (!VulkanCheck(vkCreateSemaphore(device, &timelineCreateInfo, nullptr, &m_Timeline), "vkCreateSemaphore"))
+            return false;
+
+        m_Frames.resize(m_Specification.FramesInFlight);
+        for (FrameData& frame : m_Frames)
+        {
+            // Transient: command buffers are re-recorded every time the slot comes around
+            VkCommandPoolCreateInfo poolInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+            poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            poolInfo.queueFamilyIndex = m_Context.GetQueueFamily();
+
+            if (!VulkanCheck(vkCreateCommandPool(device, &poolInfo, nullptr, &frame.CommandPool), "vkCreateCommandPool"))
+                return false;
+
+            VkCommandBufferAllocateInfo allocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+            allocateInfo.commandPool = frame.CommandPool;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandBufferCount = 1;
+
+            if (!VulkanCheck(vkAllocateCommandBuffers(device, &allocateInfo, &frame.CommandBuffer), "vkAllocateCommandBuffers"))
+                return false;
+
+            if (m_Context.GetSurface())
+            {
+                VkSemaphoreCreateInfo semaphoreInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+                if (!VulkanCheck(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &frame.ImageAvailable), "vkCreateSemaphore"))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool VulkanRenderer::CreateTarget()
+    {
+        VkDevice device = m_Context.GetDevice();
+
+        if (m_Context.GetSurface())
+        {
+            if (!m_Swapchain.Create(m_Context, m_Width, m_Height, m_Specification.VSync))
+                return false;
+
+            m_Width = m_Swapchain.GetExtent().width;
+            m_Height = m_Swapchain.GetExtent().height;
+
+            // Present waits on a semaphore per image: the image index, not the frame slot, says when it is free again
+            VkSemaphoreCreateInfo semaphoreInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+            m_RenderFinished.resize(m_Swapchain.GetImageCount(), VK_NULL_HANDLE);
+            for (VkSemaphore& semaphore : m_RenderFinished)
+            {
+                if (!VulkanCheck(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &semaphore), "vkCreateSemaphore"))
+                    return false;
+            }
+
+            return CreateFramebuffers();
+        }
+
+        if (m_Width == 0 || m_Height == 0)
+            return false;
+
+        VkImageCreateInfo imageInfo = { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+        imageInfo.extent = { m_Width, m_Height, 1 };
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        if (!VulkanCheck(vkCreateImage(device, &imageInfo, nullptr, &m_OffscreenImage), "vkCreateImage"))
+            return false;
+
+        VkMemoryRequirements requirements;
+        vkGetImageMemoryRequirements(device, m_OffscreenImage, &requirements);
+
+        VkMemoryAllocateInfo allocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+        allocateInfo.allocationSize = requirements.size;
+        allocateInfo.memoryTypeIndex = m_Context.FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        if (allocateInfo.memoryTypeIndex == UINT32_MAX)
+            allocateInfo.memoryTypeIndex = m_Context.FindMemoryType(requirements.memoryTypeBits, 0);
+
+        if (!VulkanCheck(vkAllocateMemory(device, &allocateInfo, nullptr, &m_OffscreenMemory), "vkAllocateMemory")
+            || !VulkanCheck(vkBindImageMemory(device, m_OffscreenImage, m_OffscreenMemory, 0), "vkBindImageMemory"))
+            return false;
+
+        VkImageViewCreateInfo viewInfo = { VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+        viewInfo.image = m_OffscreenImage;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = imageInfo.format;
+        viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+        if (!VulkanCheck(vkCreateImageView(device, &viewInfo, nullptr, &m_OffscreenView), "vkCreateImageView"))
+            return false;
+
+        return CreateFramebuffers();
+    }
+
+    bool VulkanRenderer::CreateRenderPass(VkFormat format)
+    {
+        // Draws load what BeginFrame() cleared and hand the target back in the layout they found it in
+        VkAttachmentDescription attachment = {};
+        attachment.format = format;
+        attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+        attachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+        attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachment.initialLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        attachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+
+        VkAttachmentReference colorReference = { 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+
+        VkSubpassDescription subpass = {};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = 1;
+        subpass.pColorAttachments = &colorReference;
+
+        // Everything else that touches the target within a frame is a transfer: the clear, the transition
+        // in EndFrame(), and the previous draw's render pass as seen through its own outgoing dependency
+        VkSubpassDependency dependencies[2] = {};
+        dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[0].dstSubpass = 0;
+        dependencies[0].srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependencies[0].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+        dependencies[1].srcSubpass = 0;
+        dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependencies[1].dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        dependencies[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        VkRenderPassCreateInfo createInfo = { VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO };
+        createInfo.attachmentCount = 1;
+        createInfo.pAttachments = &attachment;
+        createInfo.subpassCount = 1;
+        createInfo.pSubpasses = &subpass;
+        createInfo.dependencyCount = 2;
+        createInfo.pDependencies = dependencies;
+
+        if (!VulkanCheck(vkCreateRenderPass(m_Context.GetDevice(), &createInfo, nullptr, &m_RenderPass), "vkCreateRenderPass"))
+            return false;
+
+        m_TargetFormat = format;
+        return true;
+    }
+
+    bool VulkanRenderer::CreateFramebuffers()
+    {
+        std::vector<VkImageView> views;
+        VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+
+        if (m_Context.GetSurface())
+        {
+            format = m_Swapchain.GetFormat();
+            for (uint32_t i = 0; i < m_Swapchain.GetImageCount(); i++)
+                views.push_back(m_Swapchain.GetImageView(i));
+        }
+        else
+        {
+            views.push_back(m_OffscreenView);
+        }
+
+        if (!m_RenderPass && !CreateRenderPass(format))
+            return false;
+
+        // The swapchain picks the same surface format every time, so this only fails if the surface changes
+        if (format != m_TargetFormat)
+        {
+            VEX_CORE_ERROR("The render target changed format; the quad pipeline cannot draw to it");
+            return false;
+        }
+
+        m_Framebuffers.resize(views.size(), VK_NULL_HANDLE);
+        for (size_t i = 0; i < views.size(); i++)
+        {
+            VkFramebufferCreateInfo createInfo = { VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO };
+            createInfo.renderPass = m_RenderPass;
+            createInfo.attachmentCount = 1;
+            createInfo.pAttachments = &views[i];
+            createInfo.width = m_Width;
+            createInfo.height = m_Height;
+            createInfo.layers = 1;
+
+            if (!VulkanCheck(vkCreateFramebuffer(m_Context.GetDevice(), &createInfo, nullptr, &m_Framebuffers[i]), "vkCreateFramebuffer"))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool VulkanRenderer::CreateQuadPipeline()
+    {
+        VkDevice device = m_Context.GetDevice();
+
+        VkPushConstantRange pushConstants = { VK_SHADER_STAGE_VERTEX_BIT, 0, 4 * sizeof(float) };
+
+        VkPipelineLayoutCreateInfo layoutInfo = { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushConstants;
+
+        if (!VulkanCheck(vkCreatePipelineLayout(device, &layoutInfo, nullptr, &m_QuadPipelineLayout), "vkCreatePipelineLayout"))
+            return false;
+
+        VkShaderModule vertexShader = CreateBuiltinShaderModule(m_PipelineCache, QuadVertexShader);
+        VkShaderModule fragmentShader = CreateBuiltinShaderModule(m_PipelineCache, QuadFragmentShader);
+
+        VkPipelineShaderStageCreateInfo stages[2] = {};
+        stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+        stages[0].module = vertexShader;
+        stages[0].pName = "main";
+        stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+        stages[1].module = fragmentShader;
+        stages[1].pName = "main";
+
+        // PackColor() puts red in the lowest byte, which is the byte order of R8G8B8A8
+        VkVertexInputBindingDescription binding = { 0, sizeof(QuadVertex), VK_VERTEX_INPUT_RATE_VERTEX };
+        VkVertexInputAttributeDescription attributes[2] =
+        {
+            { 0, 0, VK_FORMAT_R32G32B32_SFLOAT, static_cast<uint32_t>(offsetof(QuadVertex, X)) },
+            { 1, 0, VK_FORMAT_R8G8B8A8_UNORM, static_cast<uint32_t>(offsetof(QuadVertex, Color)) },
+        };
+
+        VkPipelineVertexInputStateCreateInfo vertexInput = { VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO };
+        vertexInput.vertexBindingDescriptionCount = 1;
+        vertexInput.pVertexBindingDescriptions = &binding;
+        vertexInput.vertexAttributeDescriptionCount = 2;
+        vertexInput.pVertexAttributeDescriptions = attributes;
+
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly = { VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO };
+        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        // Viewport and scissor are dynamic so the pipeline survives resizes
+        VkPipelineViewportStateCreateInfo viewport = { VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO };
+        viewport.viewportCount = 1;
+        viewport.scissorCount = 1;
+
+        VkDynamicState dynamicStates[2] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+        VkPipelineDynamicStateCreateInfo dynamic = { VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO };
+        dynamic.dynamicStateCount = 2;
+        dynamic.pDynamicStates = dynamicStates;
+
+        VkPipelineRasterizationStateCreateInfo rasterization = { VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO };
+        rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+        rasterization.cullMode = VK_CULL_MODE_NONE;
+        rasterization.frontFace = VK_FRONT_FACE_CLOCKWISE;
+        rasterization.lineWidth = 1.0f;
+
+        VkPipelineMultisampleStateCreateInfo multisample = { VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO };
+        multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+        VkPipelineColorBlendAttachmentState blend = {};
+        blend.blendEnable = VK_TRUE;
+        blend.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+        blend.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        blend.colorBlendOp = VK_BLEND_OP_ADD;
+        blend.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        blend.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        blend.alphaBlendOp = VK_BLEND_OP_ADD;
+        blend.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+        VkPipelineColorBlendStateCreateInfo colorBlend = { VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO };
+        colorBlend.attachmentCount = 1;
+        colorBlend.pAttachments = &blend;
+
+        VkGraphicsPipelineCreateInfo createInfo = { VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO };
+        createInfo.stageCount = 2;
+        createInfo.pStages = stages;
+        createInfo.pVertexInputState = &vertexInput;
+        createInfo.pInputAssemblyState = &inputAssembly;
+        createInfo.pViewportState = &viewport;
+        createInfo.pRasterizationState = &rasterization;
+        createInfo.pMultisampleState = &multisample;
+        createInfo.pColorBlendState = &colorBlend;
+        createInfo.pDynamicState = &dynamic;
+        createInfo.layout = m_QuadPipelineLayout;
+        createInfo.renderPass = m_RenderPass;
+        createInfo.subpass = 0;
+        createInfo.basePipelineIndex = -1;
+
+        // A warm cache lets the driver skip compiling the pipeline
+        bool created = vertexShader && fragmentShader &&
+            VulkanCheck(vkCreateGraphicsPipelines(device, m_PipelineCache.GetHandle(), 1, &createInfo, nullptr, &m_QuadPipeline), "vkCreateGraphicsPipelines");
+
+        // The pipeline keeps what it needs from the modules
+        if (vertexShader)
+            vkDestroyShaderModule(device, vertexShader, nullptr);
+        if (fragmentShader)
+            vkDestroyShaderModule(device, fragmentShader, nullptr);
+
+        return created;
+    }
+
+    bool VulkanRenderer::CreateQuadIndexBuffer()
+    {
+        VkDevice device = m_Context.GetDevice();
+
+        VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+        bufferInfo.size = MaxQuadsPerDraw * 6 * sizeof(uint16_t);
+        bufferInfo.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (!VulkanCheck(vkCreateBuffer(device, &bufferInfo, nullptr, &m_QuadIndexBuffer), "vkCreateBuffer"))
+            return false;
+
+        VkMemoryRequirements requirements;
+        vkGetBufferMemoryRequirements(device, m_QuadIndexBuffer, &requirements);
+
+        // Written once, from the CPU, so it lives where the CPU can write it instead of going through the ring
+        VkMemoryAllocateInfo allocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+        allocateInfo.allocationSize = requirements.size;
+        allocateInfo.memoryTypeIndex = m_Context.FindMemoryType(requirements.memoryTypeBits,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+        if (allocateInfo.memoryTypeIndex == UINT32_MAX)
+        {
+            VEX_CORE_ERROR("No host-visible, coherent memory for the quad index buffer");
+            return false;
+        }
+
+        void* mapped = nullptr;
+        if (!VulkanCheck(vkAllocateMemory(device, &allocateInfo, nullptr, &m_QuadIndexMemory), "vkAllocateMemory")
+            || !VulkanCheck(vkBindBufferMemory(device, m_QuadIndexBuffer, m_QuadIndexMemory, 0), "vkBindBufferMemory")
+            || !VulkanCheck(vkMapMemory(device, m_QuadIndexMemory, 0, VK_WHOLE_SIZE, 0, &mapped), "vkMapMemory"))
+            return false;
+
+        // Two triangles per quad over its corners in Renderer2D order: top-left, top-right, bottom-right, bottom-left
+        const uint16_t pattern[6] = { 0, 1, 2, 2, 3, 0 };
+        uint16_t* indices = static_cast<uint16_t*>(mapped);
+        for (uint32_t quad = 0; quad < MaxQuadsPerDraw; quad++)
+        {
+            for (uint16_t corner : pattern)
+                *indices++ = static_cast<uint16_t>(quad * 4 + corner);
+        }
+
+        vkUnmapMemory(device, m_QuadIndexMemory);
+        return true;
+    }
+
+    void VulkanRenderer::DestroyTarget()
+    {
+        VkDevice device = m_Context.GetDevice();
+
+        for (VkSemaphore semaphore : m_RenderFinished)
+        {
+            if (semaphore)
+                vkDestroySemaphore(device, semaphore, nullptr);
+        }
+        m_RenderFinished.clear();
+
+        for (VkFramebuffer framebuffer : m_Framebuffers)
+        {
+            if (framebuffer)
+                vkDestroyFramebuffer(device, framebuffer, nullptr);
+        }
+        m_Framebuffers.clear();
+
+        if (m_OffscreenView)
+            vkDestroyImageView(device, m_OffscreenView, nullptr);
+        if (m_OffscreenImage)
+            vkDestroyImage(device, m_OffscreenImage, nullptr);
+        if (m_OffscreenMemory)
+            vkFreeMemory(device, m_OffscreenMemory, nullptr);
+
+        m_OffscreenView = VK_NULL_HANDLE;
+        m_OffscreenImage = VK_NULL_HANDLE;
+        m_OffscreenMemory = VK_NULL_HANDLE;
+    }
+
+    void VulkanRenderer::Destroy()
+    {
+        VkDevice device = m_Context.GetDevice();
+        if (!device)
+            return;
+
+        vkDeviceWaitIdle(device);
+
+        if (m_Valid)
+            m_PipelineCache.Save();
+        m_PipelineCache.Shutdown();
+
+        DestroyTarget();
+        m_Swapchain.Destroy();
+        m_StagingRing.Shutdown();
+
+        if (m_QuadPipeline)
+            vkDestroyPipeline(device, m_QuadPipeline, nullptr);
+        if (m_QuadPipelineLayout)
+            vkDestroyPipelineLayout(device, m_QuadPipelineLayout, nullptr);
+        if (m_RenderPass)
+            vkDestroyRenderPass(device, m_RenderPass, nullptr);
+        if (m_QuadIndexBuffer)
+            vkDestroyBuffer(device, m_QuadIndexBuffer, nullptr);
+        if (m_QuadIndexMemory)
+            vkFreeMemory(device, m_QuadIndexMemory, nullptr);
+
+        m_QuadPipeline = VK_NULL_HANDLE;
+        m_QuadPipelineLayout = VK_NULL_HANDLE;
+        m_RenderPass = VK_NULL_HANDLE;
+        m_QuadIndexBuffer = VK_NULL_HANDLE;
+        m_QuadIndexMemory = VK_NULL_HANDLE;
+
+        for (FrameData& frame : m_Frames)
+        {
+            if (frame.CommandPool)
+                vkDestroyCommandPool(device, frame.CommandPool, nullptr);
+            if (frame.ImageAvailable)
+                vkDestroySemaphore(device, frame.ImageAvailable, nullptr);
+        }
+        m_Frames.clear();
+
+        if (m_Timeline)
+            vkDestroySemaphore(device, m_Timeline, nullptr);
+        m_Timeline = VK_NULL_HANDLE;
+
+        m_Context.Shutdown();
+        m_Valid = false;
+    }
+
+    VkImage VulkanRenderer::GetTargetImage() const
+    {
+        return m_Context.GetSurface() ? m_Swapchain.GetImage(m_ImageIndex) : m_OffscreenImage;
+    }
+
+    void VulkanRenderer::SetClearColor(float r, float g, float b, float a)
+    {
+        m_ClearColor.float32[0] = r;
+        m_ClearColor.float32[1] = g;
+        m_ClearColor.float32[2] = b;
+        m_ClearColor.float32[3] = a;
+    }
+
+    void VulkanRenderer::OnWindowResize(uint32_t width, uint32_t height)
+    {
+        m_Width = width;
+        m_Height = height;
+        m_TargetDirty = true;
+    }
+
+    bool VulkanRenderer::BeginFrame()
+    {
+        VEX_PROFILE_FUNCTION();
+
+        VkDevice device = m_Context.GetDevice();
+        FrameData& frame = m_Frames[m_FrameIndex % m_Frames.size()];
+
+        // The only wait in the loop: for this slot's previous submission, FramesInFlight frames ago
+        {
+            VEX_PROFILE_SCOPE("Wait for frame slot");
+            auto start = std::chrono::steady_clock::now();
+
+            VkSemaphoreWaitInfo waitInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &m_Timeline;
+            waitInfo.pValues = &frame.TimelineValue;
+            VulkanCheck(vkWaitSemaphores(device, &waitInfo, UINT64_MAX), "vkWaitSemaphores");
+
+            m_LastWaitMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        uint64_t completed = 0;
+        vkGetSemaphoreCounterValue(device, m_Timeline, &completed);
+        m_StagingRing.Reclaim(completed);
+
+        if (m_TargetDirty)
+        {
+            // Resizing is rare enough to drain the GPU rather than track the old target's last use
+            vkDeviceWaitIdle(device);
+            DestroyTarget();
+
+            if (!CreateTarget())
+                return false;   // Minimized; try again next frame
+            m_TargetDirty = false;
+        }
+
+        VkImage target = m_OffscreenImage;
+        if (m_Context.GetSurface())
+        {
+            VkResult result = vkAcquireNextImageKHR(device, m_Swapchain.GetHandle(), UINT64_MAX, frame.ImageAvailable, VK_NULL_HANDLE, &m_ImageIndex);
+            if (result == VK_ERROR_OUT_OF_DATE_KHR)
+            {
+                m_TargetDirty = true;
+                return false;
+            }
+
+            if (result == VK_SUBOPTIMAL_KHR)
+                m_TargetDirty = true;   // Still presentable; recreate after this frame
+            else if (!VulkanCheck(result, "vkAcquireNextImageKHR"))
+                return false;
+
+            target = m_Swapchain.GetImage(m_ImageIndex);
+        }
+
+        // Everything the pool allocated last time round is recycled at once
+        vkResetCommandPool(device, frame.CommandPool, 0);
+
+        VkCommandBufferBeginInfo beginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(frame.CommandBuffer, &beginInfo);
+
+        TransitionImage(frame.CommandBuffer, target, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, 0, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+        VkImageSubresourceRange range = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        vkCmdClearColorImage(frame.CommandBuffer, target, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &m_ClearColor, 1, &range);
+
+        m_InFrame = true;
+        return true;
+    }
+
+    void VulkanRenderer::EndFrame()
+    {
+        VEX_PROFILE_FUNCTION();
+
+        if (!m_InFrame)
+            return;
+        m_InFrame = false;
+
+        FrameData& frame = m_Frames[m_FrameIndex % m_Frames.size()];
+        bool presenting = m_Context.GetSurface() != VK_NULL_HANDLE;
+
+        if (presenting)
+        {
+            TransitionImage(frame.CommandBuffer, GetTargetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0);
+        }
+        else
+        {
+            // Ready to be copied out, e.g. for a screenshot
+            TransitionImage(frame.CommandBuffer, m_OffscreenImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+        }
+
+        vkEndCommandBuffer(frame.CommandBuffer);
+
+        frame.TimelineValue = ++m_TimelineValue;
+        m_StagingRing.Retire(frame.TimelineValue);
+
+        // Binary semaphores ignore their value entries; the timeline one gets this frame's value
+        VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        uint64_t waitValue = 0;
+        VkSemaphore signalSemaphores[2] = { m_Timeline, presenting ? m_RenderFinished[m_ImageIndex] : VK_NULL_HANDLE };
+        uint64_t signalValues[2] = { frame.TimelineValue, 0 };
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo = { VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+        timelineInfo.waitSemaphoreValueCount = presenting ? 1 : 0;
+        timelineInfo.pWaitSemaphoreValues = &waitValue;
+        timelineInfo.signalSemaphoreValueCount = presenting ? 2 : 1;
+        timelineInfo.pSignalSemaphoreValues = signalValues;
+
+        VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.waitSemaphoreCount = presenting ? 1 : 0;
+        submitInfo.pWaitSemaphores = &frame.ImageAvailable;
+        submitInfo.pWaitDstStageMask = &waitStage;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &frame.CommandBuffer;
+        submitInfo.signalSemaphoreCount = presenting ? 2 : 1;
+        submitInfo.pSignalSemaphores = signalSemaphores;
+
+        VulkanCheck(vkQueueSubmit(m_Context.GetQueue(), 1, &submitInfo, VK_NULL_HANDLE), "vkQueueSubmit");
+
+        if (presenting)
+        {
+            VkSwapchainKHR swapchain = m_Swapchain.GetHandle();
+
+            VkPresentInfoKHR presentInfo = { VK_STRUCTURE_TYPE_PRESENT_INFO_KHR };
+            presentInfo.waitSemaphoreCount = 1;
+            presentInfo.pWaitSemaphores = &m_RenderFinished[m_ImageIndex];
+            presentInfo.swapchainCount = 1;
+            presentInfo.pSwapchains = &swapchain;
+            presentInfo.pImageIndices = &m_ImageIndex;
+
+            VkResult result = vkQueuePresentKHR(m_Context.GetQueue(), &presentInfo);
+            if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+                m_TargetDirty = true;
+            else
+                VulkanCheck(result, "vkQueuePresentKHR");
+        }
+
+        m_FrameIndex++;
+    }
+
+    bool VulkanRenderer::Upload(VkBuffer destination, VkDeviceSize offset, const void* data, VkDeviceSize size)
+    {
+        if (!m_InFrame)
+        {
+            VEX_CORE_ERROR("VulkanRenderer::Upload called outside BeginFrame/EndFrame");
+            return false;
+        }
+
+        VulkanStagingRing::Allocation allocation;
+        if (!m_StagingRing.Allocate(size, 16, allocation))
+            return false;
+
+        std::memcpy(allocation.Data, data, static_cast<size_t>(size));
+
+        VkCommandBuffer commandBuffer = GetCommandBuffer();
+
+        // Draws of earlier frames may still be reading the destination; a write-after-read only needs them done
+        vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+        VkBufferCopy region = { allocation.Offset, offset, size };
+        vkCmdCopyBuffer(commandBuffer, allocation.Buffer, destination, 1, &region);
+
+        VkMemoryBarrier barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            0, 1, &barrier, 0, nullptr, 0, nullptr);
+        return true;
+    }
+
+    void VulkanRenderer::DrawQuads(VkBuffer vertices, uint32_t firstVertex, uint32_t quadCount)
+    {
+        if (!m_InFrame)
+        {
+            VEX_CORE_ERROR("VulkanRenderer::DrawQuads called outside BeginFrame/EndFrame");
+            return;
+        }
+
+        if (quadCount == 0)
+            return;
+
+        VkCommandBuffer commandBuffer = GetCommandBuffer();
+
+        VkRenderPassBeginInfo beginInfo = { VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
+        beginInfo.renderPass = m_RenderPass;
+        beginInfo.framebuffer = m_Framebuffers[m_Context.GetSurface() ? m_ImageIndex : 0];
+        beginInfo.renderArea = { { 0, 0 }, { m_Width, m_Height } };
+        vkCmdBeginRenderPass(commandBuffer, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_QuadPipeline);
+
+        VkViewport viewport = { 0.0f, 0.0f, static_cast<float>(m_Width), static_cast<float>(m_Height), 0.0f, 1.0f };
+        VkRect2D scissor = { { 0, 0 }, { m_Width, m_Height } };
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+        // Pixels to clip space; both have y pointing down
+        float scaleOffset[4] = { 2.0f / m_Width, 2.0f / m_Height, -1.0f, -1.0f };
+        vkCmdPushConstants(commandBuffer, m_QuadPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(scaleOffset), scaleOffset);
+
+        VkDeviceSize offset = 0;
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertices, &offset);
+        vkCmdBindIndexBuffer(commandBuffer, m_QuadIndexBuffer, 0, VK_INDEX_TYPE_UINT16);
+
+        // The index pattern covers MaxQuadsPerDraw quads; longer runs move the vertex offset along
+        for (uint32_t drawn = 0; drawn < quadCount; drawn += MaxQuadsPerDraw)
+        {
+            uint32_t count = std::min(quadCount - drawn, MaxQuadsPerDraw);
+            vkCmdDrawIndexed(commandBuffer, count * 6, 1, 0, static_cast<int32_t>(firstVertex + drawn * 4), 0);
+        }
+
+        vkCmdEndRenderPass(commandBuffer);
+    }
+}
+
+#endif
@@ -0,0 +1,165 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanPipelineCache.h"
+#include "Platform/Vulkan/VulkanStagingRing.h"
+#include "Platform/Vulkan/VulkanSwapchain.h"
+#include "Vex/Renderer/Renderer2DBackend.h"
+
+#include <vector>
+
+namespace Vex
+{
+    class Window;
+
+    /**
+     * Options for a VulkanRenderer.
+     */
+    struct VulkanRendererSpecification
+    {
+        uint32_t FramesInFlight = 2;                    ///< Frames the CPU may record ahead of the GPU.
+        VkDeviceSize StagingRingSize = 32ull << 20;     ///< Bytes of persistently mapped upload memory.
+        bool VSync = true;
+        std::string PipelineCachePath;                  ///< Pipeline and shader cache kept between runs; empty disables it.
+    };
+
+    /**
+     * @class VulkanRenderer
+     * @brief Vulkan frame loop: frames in flight, per-frame command pools and a staging ring.
+     *
+     * Each of the FramesInFlight frame slots owns a command pool, reset wholesale when the slot comes
+     * around again, and remembers the value a single timeline semaphore reaches once its submission has
+     * executed. BeginFrame() waits only until the slot's previous submission is done, which is
+     * FramesInFlight frames back, so the CPU records ahead of the GPU instead of waiting on it; binary
+     * semaphores are used only where the swapchain requires them. Uploads go through a persistently
+     * mapped staging ring whose space is reclaimed by timeline value.
+     *
+     * With a window that has a native SDL window the renderer presents to a swapchain, recreated after a
+     * resize or when the driver reports it out of date. Headless windows get an offscreen target of the
+     * window's size, which is how it runs on GPU-less machines through a software ICD such as lavapipe.
+     * The target is cleared at BeginFrame() and stays in TRANSFER_DST_OPTIMAL layout until EndFrame(),
+     * apart from the render pass of each DrawQuads().
+     *
+     * The quad pipeline and its shaders are created through the pipeline cache when the renderer starts.
+     * Given a job system, the cache file is read on it while the instance and device are created, and it
+     * is written back when the renderer is destroyed.
+     *
+     * Main thread only.
+     */
+    class VEX_API VulkanRenderer
+    {
+    public:
+        static constexpr uint32_t MaxQuadsPerDraw = 16384;  ///< 65536 vertices, addressable with 16-bit indices.
+
+        VulkanRenderer(Window& window, const VulkanRendererSpecification& specification = VulkanRendererSpecification(),
+            JobSystem* jobSystem = nullptr);
+        ~VulkanRenderer();
+
+        VulkanRenderer(const VulkanRenderer&) = delete;
+        VulkanRenderer& operator=(const VulkanRenderer&) = delete;
+
+        /** @return False if initialization failed; nothing else may be called then. */
+        bool IsValid() const { return m_Valid; }
+
+        /**
+         * @brief Starts recording a frame into the next frame slot.
+         * @return False if there is nothing to render to this frame (minimized, or the swapchain was out
+         * of date and will be recreated); skip EndFrame() then.
+         */
+        bool BeginFrame();
+
+        /** Submits the frame and presents it. */
+        void EndFrame();
+
+        /** Sets the color the target is cleared to. */
+        void SetClearColor(float r, float g, float b, float a = 1.0f);
+
+        /**
+         * @brief Copies data into a buffer through the staging ring, as part of the current frame.
+         *
+         * The copy waits for earlier draws to stop reading and is followed by a barrier that makes it visible
+         * to vertex input and shaders. Only between BeginFrame() and EndFrame().
+         * @return False if the ring has no room this frame; nothing is recorded.
+         */
+        bool Upload(VkBuffer destination, VkDeviceSize offset, const void* data, VkDeviceSize size);
+
+        /**
+         * @brief Draws colored quads, four QuadVertex each in the order Renderer2D writes them, in target pixels.
+         *
+         * Texture coordinates are ignored and colors are alpha blended. Records a render pass of its own, so
+         * uploads may be recorded between draws. Only between BeginFrame() and EndFrame().
+         */
+        void DrawQuads(VkBuffer vertices, uint32_t firstVertex, uint32_t quadCount);
+
+        /** Call on WindowResizeEvent; the swapchain or offscreen target is recreated before the next frame. */
+        void OnWindowResize(uint32_t width, uint32_t height);
+
+        VkCommandBuffer GetCommandBuffer() const { return m_Frames[m_FrameIndex % m_Frames.size()].CommandBuffer; }
+        VkImage GetTargetImage() const;
+        VkExtent2D GetTargetExtent() const { return { m_Width, m_Height }; }
+
+        VulkanContext& GetContext() { return m_Context; }
+        const VulkanStagingRing& GetStagingRing() const { return m_StagingRing; }
+
+        /** Pass its handle when creating pipelines, and create shader modules through it. */
+        VulkanPipelineCache& GetPipelineCache() { return m_PipelineCache; }
+
+        /** @return Frames submitted so far; also the timeline value the last one signals. */
+        uint64_t GetFramesSubmitted() const { return m_TimelineValue; }
+
+        /** @return Time the last BeginFrame() spent waiting for its frame slot, in milliseconds. */
+        float GetLastWaitMilliseconds() const { return m_LastWaitMilliseconds; }
+
+    private:
+        struct FrameData
+        {
+            VkCommandPool CommandPool = VK_NULL_HANDLE;
+            VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+            VkSemaphore ImageAvailable = VK_NULL_HANDLE;    ///< Binary; signaled by the swapchain acquire.
+            uint64_t TimelineValue = 0;                     ///< Reached once the slot's last submission has executed.
+        };
+
+        bool CreateFrames();
+        bool CreateTarget();
+        void DestroyTarget();
+        bool CreateRenderPass(VkFormat format);
+        bool CreateFramebuffers();
+        bool CreateQuadPipeline();
+        bool CreateQuadIndexBuffer();
+        void Destroy();
+
+        VulkanRendererSpecification m_Specification;
+        VulkanContext m_Context;
+        VulkanSwapchain m_Swapchain;
+        VulkanStagingRing m_StagingRing;
+        VulkanPipelineCache m_PipelineCache;
+
+        std::vector<FrameData> m_Frames;
+        std::vector<VkSemaphore> m_RenderFinished;  ///< Binary, one per swapchain image, waited on by present.
+        VkSemaphore m_Timeline = VK_NULL_HANDLE;
+        uint64_t m_TimelineValue = 0;
+        uint64_t m_FrameIndex = 0;
+        uint32_t m_ImageIndex = 0;
+
+        // Offscreen target, used when there is no surface
+        VkImage m_OffscreenImage = VK_NULL_HANDLE;
+        VkImageView m_OffscreenView = VK_NULL_HANDLE;
+        VkDeviceMemory m_OffscreenMemory = VK_NULL_HANDLE;
+
+        VkRenderPass m_RenderPass = VK_NULL_HANDLE;
+        VkFormat m_TargetFormat = VK_FORMAT_UNDEFINED;      ///< The render pass and pipeline are made for it.
+        std::vector<VkFramebuffer> m_Framebuffers;          ///< One per swapchain image, or one for the offscreen target.
+        VkPipelineLayout m_QuadPipelineLayout = VK_NULL_HANDLE;
+        VkPipeline m_QuadPipeline = VK_NULL_HANDLE;
+        VkBuffer m_QuadIndexBuffer = VK_NULL_HANDLE;        ///< 0 1 2 2 3 0 per quad, for MaxQuadsPerDraw quads.
+        VkDeviceMemory m_QuadIndexMemory = VK_NULL_HANDLE;
+
+        uint32_t m_Width = 0, m_Height = 0;
+        VkClearColorValue m_ClearColor = {};
+        float m_LastWaitMilliseconds = 0.0f;
+        bool m_TargetDirty = false;
+        bool m_InFrame = false;
+        bool m_Valid = false;
+    };
+}
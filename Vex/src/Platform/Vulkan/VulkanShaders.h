@@ -0,0 +1,27 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Vex
+{
+    /**
+     * @brief A shader the renderer ships with.
+     *
+     * The pipeline cache keys shaders by source, so Source is what VulkanPipelineCache::CreateShaderModule()
+     * is given; compiling it only copies Spirv, since there is no GLSL compiler at runtime.
+     */
+    struct VulkanBuiltinShader
+    {
+        std::string_view Source;
+        const uint32_t* Spirv;
+        size_t WordCount;
+    };
+
+    /** Colored quads: QuadVertex position in pixels, scaled and offset to clip space by a push constant. */
+    extern const VulkanBuiltinShader QuadVertexShader;
+
+    /** Writes the interpolated vertex color. */
+    extern const VulkanBuiltinShader QuadFragmentShader;
+}
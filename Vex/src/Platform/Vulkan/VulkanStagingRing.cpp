@@ -0,0 +1,126 @@
+﻿#include "VexPch.h"
+
+#ifdef VEX_VULKAN
+
+#include "VulkanStagingRing.h"
+
+#include "Vex/Log.h"
+
+namespace Vex
+{
+    VulkanStagingRing::~VulkanStagingRing()
+    {
+        Shutdown();
+    }
+
+    bool VulkanStagingRing::Init(const VulkanContext& context, VkDeviceSize capacity)
+    {
+        m_Device = context.GetDevice();
+        m_Capacity = capacity;
+
+        VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+        bufferInfo.size = capacity;
+        bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (!VulkanCheck(vkCreateBuffer(m_Device, &bufferInfo, nullptr, &m_Buffer), "vkCreateBuffer"))
+            return false;
+
+        VkMemoryRequirements requirements;
+        vkGetBufferMemoryRequirements(m_Device, m_Buffer, &requirements);
+
+        VkMemoryAllocateInfo allocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+        allocateInfo.allocationSize = requirements.size;
+        allocateInfo.memoryTypeIndex = context.FindMemoryType(requirements.memoryTypeBits,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+        if (allocateInfo.memoryTypeIndex == UINT32_MAX)
+        {
+            VEX_CORE_ERROR("No host-visible, coherent memory for the staging ring");
+            Shutdown();
+            return false;
+        }
+
+        if (!VulkanCheck(vkAllocateMemory(m_Device, &allocateInfo, nullptr, &m_Memory), "vkAllocateMemory")
+            || !VulkanCheck(vkBindBufferMemory(m_Device, m_Buffer, m_Memory, 0), "vkBindBufferMemory"))
+        {
+            Shutdown();
+            return false;
+        }
+
+        // Mapped once for the lifetime of the ring
+        void* mapped = nullptr;
+        if (!VulkanCheck(vkMapMemory(m_Device, m_Memory, 0, VK_WHOLE_SIZE, 0, &mapped), "vkMapMemory"))
+        {
+            Shutdown();
+            return false;
+        }
+
+        m_Mapped = static_cast<uint8_t*>(mapped);
+        return true;
+    }
+
+    void VulkanStagingRing::Shutdown()
+    {
+        if (!m_Device)
+            return;
+
+        if (m_Mapped)
+            vkUnmapMemory(m_Device, m_Memory);
+        if (m_Buffer)
+            vkDestroyBuffer(m_Device, m_Buffer, nullptr);
+        if (m_Memory)
+            vkFreeMemory(m_Device, m_Memory, nullptr);
+
+        m_Mapped = nullptr;
+        m_Buffer = VK_NULL_HANDLE;
+        m_Memory = VK_NULL_HANDLE;
+        m_Device = VK_NULL_HANDLE;
+        m_Head = m_Tail = m_RetiredHead = 0;
+        m_Retired.clear();
+    }
+
+    bool VulkanStagingRing::Allocate(VkDeviceSize size, VkDeviceSize alignment, Allocation& allocation)
+    {
+        if (!m_Mapped || size > m_Capacity)
+            return false;
+
+        VkDeviceSize position = m_Head % m_Capacity;
+        VkDeviceSize start = (position + alignment - 1) & ~(alignment - 1);
+
+        // An allocation never straddles the end of the buffer; the rest of the lap is skipped instead
+        if (start + size > m_Capacity)
+            start = m_Capacity;
+
+        VkDeviceSize newHead = m_Head - position + start + size;
+        if (newHead - m_Tail > m_Capacity)
+            return false;
+
+        allocation.Buffer = m_Buffer;
+        allocation.Offset = start == m_Capacity ? 0 : start;
+        allocation.Data = m_Mapped + allocation.Offset;
+
+        m_Head = newHead;
+        return true;
+    }
+
+    void VulkanStagingRing::Retire(uint64_t timelineValue)
+    {
+        if (m_Head == m_RetiredHead)
+            return;
+
+        m_Retired.push_back({ timelineValue, m_Head });
+        m_RetiredHead = m_Head;
+    }
+
+    void VulkanStagingRing::Reclaim(uint64_t completedValue)
+    {
+        while (!m_Retired.empty() && m_Retired.front().TimelineValue <= completedValue)
+        {
+            m_Tail = m_Retired.front().End;
+            m_Retired.pop_front();
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,71 @@
+﻿#pragma once
+
+#include "Platform/Vulkan/VulkanContext.h"
+
+#include <deque>
+
+namespace Vex
+{
+    /**
+     * @class VulkanStagingRing
+     * @brief Persistently mapped upload buffer handed out as a ring.
+     *
+     * Allocations are carved from the head; when GPU work that reads them is submitted, Retire() tags
+     * everything allocated so far with the timeline value that work signals. Reclaim() moves the tail past
+     * every retired range whose value the GPU has reached. Allocate() never waits: a full ring returns
+     * false and the caller decides whether to defer the upload or grow the ring.
+     */
+    class VulkanStagingRing
+    {
+    public:
+        struct Allocation
+        {
+            VkBuffer Buffer = VK_NULL_HANDLE;
+            VkDeviceSize Offset = 0;
+            void* Data = nullptr;   ///< Mapped, host-coherent memory at Offset.
+        };
+
+        VulkanStagingRing() = default;
+        ~VulkanStagingRing();
+
+        VulkanStagingRing(const VulkanStagingRing&) = delete;
+        VulkanStagingRing& operator=(const VulkanStagingRing&) = delete;
+
+        bool Init(const VulkanContext& context, VkDeviceSize capacity);
+        void Shutdown();
+
+        /**
+         * @brief Reserves size bytes aligned to alignment (a power of two).
+         * @return False if the ring has no room until the GPU catches up.
+         */
+        bool Allocate(VkDeviceSize size, VkDeviceSize alignment, Allocation& allocation);
+
+        /** Marks everything allocated since the last call as read by work that signals timelineValue. */
+        void Retire(uint64_t timelineValue);
+
+        /** Frees the ranges of work up to completedValue. */
+        void Reclaim(uint64_t completedValue);
+
+        VkDeviceSize GetCapacity() const { return m_Capacity; }
+        VkDeviceSize GetUsed() const { return m_Head - m_Tail; }
+
+    private:
+        struct RetiredRange
+        {
+            uint64_t TimelineValue;
+            VkDeviceSize End;       ///< Head when the range was retired.
+        };
+
+        VkDevice m_Device = VK_NULL_HANDLE;
+        VkBuffer m_Buffer = VK_NULL_HANDLE;
+        VkDeviceMemory m_Memory = VK_NULL_HANDLE;
+        uint8_t* m_Mapped = nullptr;
+        VkDeviceSize m_Capacity = 0;
+
+        // Positions grow without wrapping; the offset into the buffer is position % capacity
+        VkDeviceSize m_Head = 0;
+        VkDeviceSize m_Tail = 0;
+        VkDeviceSize m_RetiredHead = 0;
+        std::deque<RetiredRange> m_Retired;
+    };
+}
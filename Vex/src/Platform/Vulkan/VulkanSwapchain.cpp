@@ -0,0 +1,175 @@
+﻿#include "VexPch.h"
+
+#ifdef VEX_VULKAN
+
+#include "VulkanSwapchain.h"
+
+#include "Vex/Log.h"
+
+namespace Vex
+{
+    VulkanSwapchain::~VulkanSwapchain()
+    {
+        Destroy();
+    }
+
+    /**
+     * Prefers 8-bit BGRA or RGBA in sRGB color space; otherwise takes what the surface lists first.
+     */
+    static VkSurfaceFormatKHR ChooseSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& formats)
+    {
+        for (const VkSurfaceFormatKHR& format : formats)
+        {
+            if ((format.format == VK_FORMAT_B8G8R8A8_UNORM || format.format == VK_FORMAT_R8G8B8A8_UNORM)
+                && format.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR)
+                return format;
+        }
+
+        return formats[0];
+    }
+
+    /**
+     * FIFO always exists and is vsynced; without vsync, mailbox avoids tearing and immediate is the fallback.
+     */
+    static VkPresentModeKHR ChoosePresentMode(const std::vector<VkPresentModeKHR>& modes, bool vsync)
+    {
+        if (vsync)
+            return VK_PRESENT_MODE_FIFO_KHR;
+
+        for (VkPresentModeKHR preferred : { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR })
+        {
+            if (std::find(modes.begin(), modes.end(), preferred) != modes.end())
+                return preferred;
+        }
+
+        return VK_PRESENT_MODE_FIFO_KHR;
+    }
+
+    bool VulkanSwapchain::Create(const VulkanContext& context, uint32_t width, uint32_t height, bool vsync)
+    {
+        m_Device = context.GetDevice();
+        VkPhysicalDevice physicalDevice = context.GetPhysicalDevice();
+        VkSurfaceKHR surface = context.GetSurface();
+
+        VkSurfaceCapabilitiesKHR capabilities;
+        if (!VulkanCheck(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, surface, &capabilities), "vkGetPhysicalDeviceSurfaceCapabilitiesKHR"))
+            return false;
+
+        VkExtent2D extent = capabilities.currentExtent;
+        if (extent.width == UINT32_MAX)
+        {
+            extent.width = std::clamp(width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+            extent.height = std::clamp(height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+        }
+
+        if (extent.width == 0 || extent.height == 0)
+            return false;
+
+        uint32_t formatCount = 0;
+        vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, nullptr);
+        std::vector<VkSurfaceFormatKHR> formats(formatCount);
+        vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, formats.data());
+
+        uint32_t modeCount = 0;
+        vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &modeCount, nullptr);
+        std::vector<VkPresentModeKHR> modes(modeCount);
+        vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &modeCount, modes.data());
+
+        if (formats.empty())
+        {
+            VEX_CORE_ERROR("Surface reports no formats");
+            return false;
+        }
+
+        VkSurfaceFormatKHR surfaceFormat = ChooseSurfaceFormat(formats);
+
+        // One image more than the minimum so acquiring rarely waits on the presentation engine
+        uint32_t imageCount = capabilities.minImageCount + 1;
+        if (capabilities.maxImageCount > 0)
+            imageCount = std::min(imageCount, capabilities.maxImageCount);
+
+        VkSwapchainKHR oldSwapchain = m_Swapchain;
+
+        VkSwapchainCreateInfoKHR createInfo = { VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR };
+        createInfo.surface = surface;
+        createInfo.minImageCount = imageCount;
+        createInfo.imageFormat = surfaceFormat.format;
+        createInfo.imageColorSpace = surfaceFormat.colorSpace;
+        createInfo.imageExtent = extent;
+        createInfo.imageArrayLayers = 1;
+        createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.preTransform = capabilities.currentTransform;
+        createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+        createInfo.presentMode = ChoosePresentMode(modes, vsync);
+        createInfo.clipped = VK_TRUE;
+        createInfo.oldSwapchain = oldSwapchain;
+
+        VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+        VkResult result = vkCreateSwapchainKHR(m_Device, &createInfo, nullptr, &swapchain);
+
+        // The old swapchain is retired either way
+        DestroyImageViews();
+        if (oldSwapchain)
+            vkDestroySwapchainKHR(m_Device, oldSwapchain, nullptr);
+        m_Swapchain = VK_NULL_HANDLE;
+        m_Images.clear();
+
+        if (!VulkanCheck(result, "vkCreateSwapchainKHR"))
+            return false;
+
+        m_Swapchain = swapchain;
+        m_Format = surfaceFormat.format;
+        m_Extent = extent;
+
+        uint32_t count = 0;
+        vkGetSwapchainImagesKHR(m_Device, m_Swapchain, &count, nullptr);
+        m_Images.resize(count);
+        vkGetSwapchainImagesKHR(m_Device, m_Swapchain, &count, m_Images.data());
+
+        m_ImageViews.resize(count, VK_NULL_HANDLE);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            VkImageViewCreateInfo viewInfo = { VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+            viewInfo.image = m_Images[i];
+            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format = m_Format;
+            viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+            if (!VulkanCheck(vkCreateImageView(m_Device, &viewInfo, nullptr, &m_ImageViews[i]), "vkCreateImageView"))
+            {
+                Destroy();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void VulkanSwapchain::Destroy()
+    {
+        if (!m_Device)
+            return;
+
+        DestroyImageViews();
+        if (m_Swapchain)
+            vkDestroySwapchainKHR(m_Device, m_Swapchain, nullptr);
+
+        m_Swapchain = VK_NULL_HANDLE;
+        m_Images.clear();
+        m_Extent = { 0, 0 };
+    }
+
+    void VulkanSwapchain::DestroyImageViews()
+    {
+        for (VkImageView view : m_ImageViews)
+        {
+            if (view)
+                vkDestroyImageView(m_Device, view, nullptr);
+        }
+
+        m_ImageViews.clear();
+    }
+}
+
+#endif
@@ -0,0 +1,51 @@
+﻿#pragma once
+
+#include "Platform/Vulkan/VulkanContext.h"
+
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * @class VulkanSwapchain
+     * @brief Swapchain of the context's surface and a view per image.
+     *
+     * Images can be cleared and copied to (TRANSFER_DST) as well as rendered to.
+     */
+    class VulkanSwapchain
+    {
+    public:
+        VulkanSwapchain() = default;
+        ~VulkanSwapchain();
+
+        VulkanSwapchain(const VulkanSwapchain&) = delete;
+        VulkanSwapchain& operator=(const VulkanSwapchain&) = delete;
+
+        /**
+         * @brief Creates the swapchain, or recreates it in place, passing the old one to the driver.
+         *
+         * The caller makes sure the GPU no longer uses the old images.
+         * @param width,height Used when the surface leaves the extent to the swapchain.
+         * @return False on failure, or if the surface currently has no area (minimized window).
+         */
+        bool Create(const VulkanContext& context, uint32_t width, uint32_t height, bool vsync);
+        void Destroy();
+
+        VkSwapchainKHR GetHandle() const { return m_Swapchain; }
+        VkFormat GetFormat() const { return m_Format; }
+        VkExtent2D GetExtent() const { return m_Extent; }
+        uint32_t GetImageCount() const { return static_cast<uint32_t>(m_Images.size()); }
+        VkImage GetImage(uint32_t index) const { return m_Images[index]; }
+        VkImageView GetImageView(uint32_t index) const { return m_ImageViews[index]; }
+
+    private:
+        void DestroyImageViews();
+
+        VkDevice m_Device = VK_NULL_HANDLE;
+        VkSwapchainKHR m_Swapchain = VK_NULL_HANDLE;
+        VkFormat m_Format = VK_FORMAT_UNDEFINED;
+        VkExtent2D m_Extent = { 0, 0 };
+        std::vector<VkImage> m_Images;
+        std::vector<VkImageView> m_ImageViews;
+    };
+}
@@ -4,19 +4,46 @@
 #include "Vex/Events/ApplicationEvent.h"
 #include "Vex/Events/KeyEvent.h"
 #include "Vex/Events/MouseEvent.h"
+#include "Vex/Input/Input.h"
 #include "Vex/Log.h"
+#include "Vex/Debug/Instrumentor.h"
 
 namespace Vex
 {
     static bool s_SDLInitialized = false;
 
     /**
-     * Factory method for creating a platform-specific Window instance.
+     * SDL event type behind each engine event type that can be switched off at the source.
      */
-    Window* Window::Create(const WindowProps& props)
+    struct SDLEventTypeMapping
     {
-        return new WindowsWindow(props);
-    }
+        EventType Type;
+        Uint32 SDLType;
+    };
+
+    static constexpr SDLEventTypeMapping s_SDLEventTypes[] =
+    {
+        { EventType::KeyPressed,          SDL_KEYDOWN },
+        { EventType::KeyReleased,         SDL_KEYUP },
+        { EventType::KeyTyped,            SDL_TEXTINPUT },
+        { EventType::MouseMoved,          SDL_MOUSEMOTION },
+        { EventType::MouseScrolled,       SDL_MOUSEWHEEL },
+        { EventType::MouseButtonPressed,  SDL_MOUSEBUTTONDOWN },
+        { EventType::MouseButtonReleased, SDL_MOUSEBUTTONUP },
+    };
+
+    /**
+     * SDL event types the window never translates; SDL is told not to queue them at all.
+     */
+    static constexpr Uint32 s_UntranslatedSDLEventTypes[] =
+    {
+        SDL_SYSWMEVENT, SDL_TEXTEDITING, SDL_KEYMAPCHANGED,
+        SDL_FINGERDOWN, SDL_FINGERUP, SDL_FINGERMOTION,
+        SDL_DOLLARGESTURE, SDL_DOLLARRECORD, SDL_MULTIGESTURE,
+        SDL_CLIPBOARDUPDATE,
+        SDL_DROPFILE, SDL_DROPTEXT, SDL_DROPBEGIN, SDL_DROPCOMPLETE,
+        SDL_AUDIODEVICEADDED, SDL_AUDIODEVICEREMOVED,
+    };
 
     /**
      * Constructor: Initializes the SDL window with given properties.
@@ -39,93 +66,197 @@ namespace Vex
  */
     void WindowsWindow::OnUpdate()
     {
-        SDL_Event event;
-        while (SDL_PollEvent(&event))
+        VEX_PROFILE_FUNCTION();
+
+        if (m_Data.UpdateInputState)
+            Input::BeginFrame();
+
+        ApplyEventTypeFilter();
+
+        m_Coalescer.BeginPump();
+
+        // Pump the OS queue once, then take SDL's events in batches; SDL_PollEvent would pump again for every event
+        SDL_PumpEvents();
+
+        int count;
+        do
         {
-            switch (event.type)
-            {
-            case SDL_QUIT:
-                // Handle quit event if needed
-                VEX_CORE_INFO("Window Closed Event Detected");
-                break;
-
-            case SDL_WINDOWEVENT:
-                if (event.window.event == SDL_WINDOWEVENT_RESIZED)
-                {
-                    int newWidth = event.window.data1;
-                    int newHeight = event.window.data2;
-
-                    WindowResizeEvent e(newWidth, newHeight);
-                    m_Data.EventCallback(e);
-                }
-                break;
-
-            case SDL_KEYDOWN:
-            {
-                bool isRepeat = event.key.repeat != 0;
-                KeyPressedEvent e(static_cast<Vex::KeyCode>(event.key.keysym.sym), isRepeat);
-                m_Data.EventCallback(e);
-                break;
-            }
+            count = SDL_PeepEvents(m_EventBatch, EventBatchSize, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
 
-            case SDL_KEYUP:
-            {
-                KeyReleasedEvent e(static_cast<Vex::KeyCode>(event.key.keysym.sym));
-                m_Data.EventCallback(e);
-                break;
-            }
+            for (int i = 0; i < count; i++)
+                TranslateEvent(m_EventBatch[i]);
+        } while (count == EventBatchSize);
 
-            case SDL_TEXTINPUT:
-            {
-                char inputChar = event.text.text[0];
-                KeyTypedEvent e(static_cast<Vex::KeyCode>(inputChar));
-                m_Data.EventCallback(e);
-                break;
-            }
+        // One motion and one scroll event per frame at most when coalescing
+        FlushCoalescedEvents();
+    }
 
-            // ** Mouse Events Handling **
-            case SDL_MOUSEMOTION:
-            {
-                // Mouse movement event
-                float x = static_cast<float>(event.motion.x);
-                float y = static_cast<float>(event.motion.y);
-                MouseMovedEvent e(x, y);
-                m_Data.EventCallback(e);
-                break;
-            }
+    /**
+     * Translates one SDL event into engine events.
+     */
+    void WindowsWindow::TranslateEvent(const SDL_Event& event)
+    {
+        uint64_t timestamp = ToEventTime(event.common.timestamp);
 
-            case SDL_MOUSEWHEEL:
-            {
-                // Mouse scroll event
-                float xOffset = static_cast<float>(event.wheel.x);
-                float yOffset = static_cast<float>(event.wheel.y);
-                MouseScrolledEvent e(xOffset, yOffset);
-                m_Data.EventCallback(e);
-                break;
-            }
+        // Anything other than motion or scroll must not overtake the mouse events held back so far
+        if (event.type != SDL_MOUSEMOTION && event.type != SDL_MOUSEWHEEL)
+            FlushCoalescedEvents();
 
-            case SDL_MOUSEBUTTONDOWN:
-            {
-                // Mouse button press event
-                MouseCode button = static_cast<MouseCode>(event.button.button);
-                MouseButtonPressedEvent e(button);
-                m_Data.EventCallback(e);
-                break;
-            }
+        switch (event.type)
+        {
+        case SDL_QUIT:
+            VEX_CORE_INFO("Window Closed Event Detected");
+            Emit<WindowCloseEvent>(timestamp);
+            break;
 
-            case SDL_MOUSEBUTTONUP:
+        case SDL_WINDOWEVENT:
+            // Resizes are filtered here: ignoring SDL_WINDOWEVENT would drop close, focus and expose events as well
+            if (event.window.event == SDL_WINDOWEVENT_RESIZED && (m_AppliedEventTypes & EventTypeBit(EventType::WindowResize)))
             {
-                // Mouse button release event
-                MouseCode button = static_cast<MouseCode>(event.button.button);
-                MouseButtonReleasedEvent e(button);
-                m_Data.EventCallback(e);
-                break;
-            }
+                int newWidth = event.window.data1;
+                int newHeight = event.window.data2;
+
+                Emit<WindowResizeEvent>(timestamp, newWidth, newHeight);
             }
+            break;
+
+        case SDL_KEYDOWN:
+        {
+            bool isRepeat = event.key.repeat != 0;
+            if (m_Data.UpdateInputState)
+                Input::UpdateKey(static_cast<uint32_t>(event.key.keysym.scancode), true);
+            Emit<KeyPressedEvent>(timestamp, static_cast<Vex::KeyCode>(event.key.keysym.sym), isRepeat);
+            break;
         }
+
+        case SDL_KEYUP:
+        {
+            if (m_Data.UpdateInputState)
+                Input::UpdateKey(static_cast<uint32_t>(event.key.keysym.scancode), false);
+            Emit<KeyReleasedEvent>(timestamp, static_cast<Vex::KeyCode>(event.key.keysym.sym));
+            break;
+        }
+
+        case SDL_TEXTINPUT:
+        {
+            char inputChar = event.text.text[0];
+            Emit<KeyTypedEvent>(timestamp, static_cast<Vex::KeyCode>(inputChar));
+            break;
+        }
+
+        // ** Mouse Events Handling **
+        case SDL_MOUSEMOTION:
+        {
+            // Mouse movement event
+            float x = static_cast<float>(event.motion.x);
+            float y = static_cast<float>(event.motion.y);
+            float deltaX = static_cast<float>(event.motion.xrel);
+            float deltaY = static_cast<float>(event.motion.yrel);
+            if (m_Data.UpdateInputState)
+                Input::UpdateMousePosition(x, y, deltaX, deltaY);
+
+            if (!m_Coalescer.AddMotion(timestamp, x, y, deltaX, deltaY))
+                Emit<MouseMovedEvent>(timestamp, x, y, deltaX, deltaY);
+            break;
+        }
+
+        case SDL_MOUSEWHEEL:
+        {
+            // Mouse scroll event
+            float xOffset = static_cast<float>(event.wheel.x);
+            float yOffset = static_cast<float>(event.wheel.y);
+            if (m_Data.UpdateInputState)
+                Input::UpdateScroll(xOffset, yOffset);
+
+            if (!m_Coalescer.AddScroll(timestamp, xOffset, yOffset))
+                Emit<MouseScrolledEvent>(timestamp, xOffset, yOffset);
+            break;
+        }
+
+        case SDL_MOUSEBUTTONDOWN:
+        {
+            // Mouse button press event
+            MouseCode button = static_cast<MouseCode>(event.button.button);
+            if (m_Data.UpdateInputState)
+                Input::UpdateMouseButton(button, true);
+            Emit<MouseButtonPressedEvent>(timestamp, button);
+            break;
+        }
+
+        case SDL_MOUSEBUTTONUP:
+        {
+            // Mouse button release event
+            MouseCode button = static_cast<MouseCode>(event.button.button);
+            if (m_Data.UpdateInputState)
+                Input::UpdateMouseButton(button, false);
+            Emit<MouseButtonReleasedEvent>(timestamp, button);
+            break;
+        }
+        }
+    }
+
+    /**
+     * Records the requested state; the pumping thread hands it to SDL on its next update.
+     */
+    void WindowsWindow::SetEventTypeEnabled(EventType type, bool enabled)
+    {
+        if (type == EventType::WindowClose)
+            return;
+
+        if (enabled)
+            m_Data.EnabledEventTypes.fetch_or(EventTypeBit(type), std::memory_order_relaxed);
+        else
+            m_Data.EnabledEventTypes.fetch_and(~EventTypeBit(type), std::memory_order_relaxed);
+    }
+
+    /**
+     * Switches SDL event types on or off to match the enabled engine event types.
+     */
+    void WindowsWindow::ApplyEventTypeFilter()
+    {
+        uint32_t enabledTypes = m_Data.EnabledEventTypes.load(std::memory_order_relaxed);
+        uint32_t changed = enabledTypes ^ m_AppliedEventTypes;
+        if (!changed)
+            return;
+
+        for (const SDLEventTypeMapping& mapping : s_SDLEventTypes)
+        {
+            if (changed & EventTypeBit(mapping.Type))
+                SDL_EventState(mapping.SDLType, (enabledTypes & EventTypeBit(mapping.Type)) ? SDL_ENABLE : SDL_IGNORE);
+        }
+
+        // Text input also drives the IME, so stop it entirely rather than just ignoring its events
+        if (changed & EventTypeBit(EventType::KeyTyped))
+        {
+            if (enabledTypes & EventTypeBit(EventType::KeyTyped))
+                SDL_StartTextInput();
+            else
+                SDL_StopTextInput();
+        }
+
+        m_AppliedEventTypes = enabledTypes;
+    }
+
+    /**
+     * Emits pending coalesced mouse events, preserving the order in which they started.
+     */
+    void WindowsWindow::FlushCoalescedEvents()
+    {
+        m_Coalescer.Flush(
+            [this](uint64_t timestamp, float x, float y, float deltaX, float deltaY) { Emit<MouseMovedEvent>(timestamp, x, y, deltaX, deltaY); },
+            [this](uint64_t timestamp, float xOffset, float yOffset) { Emit<MouseScrolledEvent>(timestamp, xOffset, yOffset); });
     }
 
+    /**
+     * Converts an SDL event timestamp (milliseconds since SDL_Init) to the Event::Now() clock.
+     */
+    uint64_t WindowsWindow::ToEventTime(uint32_t sdlTimestamp) const
+    {
+        uint64_t timestamp = m_SDLEpoch + static_cast<uint64_t>(sdlTimestamp) * 1000000ull;
 
+        // SDL only has millisecond resolution; never report an input as happening in the future
+        return std::min(timestamp, Event::Now());
+    }
 
     /**
      * Initializes the SDL window with the provided properties.
@@ -135,6 +266,7 @@ namespace Vex
         m_Data.Title = props.Title;
         m_Data.Width = props.Width;
         m_Data.Height = props.Height;
+        m_Data.UpdateInputState = props.UpdateInputState;
 
         VEX_CORE_INFO("Creating window {0} ({1}, {2})", props.Title, props.Width, props.Height);
 
@@ -149,8 +281,14 @@ namespace Vex
             }
 
             s_SDLInitialized = true;
+
+            for (Uint32 type : s_UntranslatedSDLEventTypes)
+                SDL_EventState(type, SDL_IGNORE);
         }
 
+        // Anchor SDL's millisecond tick counter to the event clock so events carry comparable timestamps
+        m_SDLEpoch = Event::Now() - SDL_GetTicks64() * 1000000ull;
+
         m_Window = SDL_CreateWindow(
             m_Data.Title.c_str(),
             SDL_WINDOWPOS_CENTERED,
@@ -174,6 +312,12 @@ namespace Vex
      */
     void WindowsWindow::Shutdown()
     {
+        if (m_Coalescer.IsEnabled())
+        {
+            VEX_CORE_INFO("Coalesced away {0} mouse move and {1} mouse scroll events",
+                m_Coalescer.GetStats().MouseMovedMerged, m_Coalescer.GetStats().MouseScrolledMerged);
+        }
+
         SDL_DestroyWindow(m_Window);
         m_Window = nullptr;
     }
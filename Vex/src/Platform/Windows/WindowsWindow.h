@@ -1,8 +1,11 @@
 ﻿#pragma once
 
 #include "Vex/Window.h"
+#include "Vex/Events/EventQueue.h"
 #include <SDL.h>
 
+#include <atomic>
+
 namespace Vex
 {
     /**
@@ -37,13 +40,55 @@ namespace Vex
          */
         unsigned int GetHeight() override { return m_Data.Height; }
 
+        /**
+         * @return The underlying SDL_Window.
+         */
+        void* GetNativeWindow() const override { return m_Window; }
+
         /**
          * Sets the callback function that will be used to handle events.
          * @param callback The function to call when events are dispatched.
          */
         inline void SetEventCallback(const EventCallbackFn& callback) override { m_Data.EventCallback = callback; }
 
+        /**
+         * Sets the queue that translated events are appended to.
+         * @param queue The queue to push into, or nullptr to dispatch through the callback.
+         */
+        inline void SetEventQueue(EventQueue* queue) override { m_Data.Queue = queue; }
+
+        /**
+         * Enables or disables merging of consecutive mouse motion and scroll events within a pump.
+         * @param enabled True to coalesce mouse events.
+         */
+        inline void SetEventCoalescing(bool enabled) override { m_Coalescer.SetEnabled(enabled); }
+
+        /**
+         * @return True if mouse events are being coalesced.
+         */
+        inline bool IsEventCoalescing() const override { return m_Coalescer.IsEnabled(); }
+
+        /**
+         * @return Counters of how many mouse events have been merged away.
+         */
+        inline const EventCoalescingStats& GetCoalescingStats() const override { return m_Coalescer.GetStats(); }
+
+        /**
+         * Enables or disables an event type; disabled types are switched off with SDL_EventState,
+         * except window resizes, which share SDL_WINDOWEVENT with other window events and are dropped on translation.
+         * @param type The event type.
+         * @param enabled False to have SDL drop the type.
+         */
+        void SetEventTypeEnabled(EventType type, bool enabled) override;
+
+        /**
+         * @return False if the event type is dropped by SDL.
+         */
+        bool IsEventTypeEnabled(EventType type) const override { return m_Data.EnabledEventTypes.load(std::memory_order_relaxed) & EventTypeBit(type); }
+
     private:
+        static constexpr int EventBatchSize = 64;  ///< SDL events fetched per SDL_PeepEvents call.
+
         /**
          * Initializes the window with the given properties.
          * @param props The properties to initialize with.
@@ -55,6 +100,47 @@ namespace Vex
          */
         void Shutdown();
 
+        /**
+         * Converts an SDL event timestamp to the Event::Now() clock.
+         * @param sdlTimestamp Milliseconds since SDL was initialized.
+         */
+        uint64_t ToEventTime(uint32_t sdlTimestamp) const;
+
+        /**
+         * Emits any mouse motion or scroll events held back by coalescing, in the order they started.
+         */
+        void FlushCoalescedEvents();
+
+        /**
+         * Translates one SDL event into engine events.
+         */
+        void TranslateEvent(const SDL_Event& event);
+
+        /**
+         * Hands changes to the enabled event types to SDL. Runs on the pumping thread, as SDL requires.
+         */
+        void ApplyEventTypeFilter();
+
+        /**
+         * Delivers a translated event: appended to the event queue when one is set,
+         * otherwise constructed on the stack and passed to the event callback.
+         * @param timestamp When the input happened, on the Event::Now() clock.
+         * @param args Arguments forwarded to the event constructor.
+         */
+        template<typename T, typename... Args>
+        void Emit(uint64_t timestamp, Args&&... args)
+        {
+            if (m_Data.Queue)
+            {
+                m_Data.Queue->Push<T>(std::forward<Args>(args)...).Timestamp = timestamp;
+                return;
+            }
+
+            T e(std::forward<Args>(args)...);
+            e.Timestamp = timestamp;
+            m_Data.EventCallback(e);
+        }
+
     private:
         SDL_Window* m_Window = nullptr;
 
@@ -63,8 +149,15 @@ namespace Vex
             std::string Title;
             unsigned int Width = 0, Height = 0;
             EventCallbackFn EventCallback;
+            EventQueue* Queue = nullptr;
+            bool UpdateInputState = true;
+            std::atomic<uint32_t> EnabledEventTypes{ AllEventTypes };
         };
 
         WindowData m_Data;
+        MouseEventCoalescer m_Coalescer;
+        uint64_t m_SDLEpoch = 0;    ///< Event::Now() time at which SDL's tick counter read zero.
+        uint32_t m_AppliedEventTypes = AllEventTypes;   ///< Enabled types as last handed to SDL.
+        SDL_Event m_EventBatch[EventBatchSize];
     };
 }
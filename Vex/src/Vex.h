@@ -2,7 +2,15 @@
 
 // For use by vex applications
 #include "Vex/Application.h"
+#include "Vex/Layer.h"
 #include "Vex/Log.h"
+#include "Vex/BinaryLog.h"
+#include "Vex/Debug/BenchmarkRunner.h"
+#include "Vex/Debug/Instrumentor.h"
+#include "Vex/Input/Input.h"
+#include "Vex/Renderer/Renderer2D.h"
+#include "Vex/Renderer/SoftwareRasterizer.h"
+#include "Vex/Scene/World.h"
 
 // ----------------------------------- Entry Point ------------------------------------
 #include "Vex/EntryPoint.h"
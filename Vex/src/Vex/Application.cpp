@@ -1,38 +1,356 @@
 ﻿#include "VexPch.h"
 #include "Application.h"
 
+#include "BinaryLog.h"
 #include "Log.h"
 #include "Window.h"
+#include "Vex/Debug/Instrumentor.h"
+#include "Vex/Events/ApplicationEvent.h"
+#include "Vex/Input/Input.h"
+
+#ifdef VEX_VULKAN
+    #include "Platform/Vulkan/VulkanRenderer.h"
+#else
+namespace Vex
+{
+    // Never created without Vulkan; only complete so that std::unique_ptr can destroy it
+    class VulkanRenderer {};
+}
+#endif
+
+#include <chrono>
 
 namespace Vex
 {
 
 #define BIND_EVENT_FN(x) std::bind(&Application::x, this, std::placeholders::_1)
 
-    Application::Application() 
+    Application::Application(const ApplicationSpecification& specification)
+        : m_CreationTimestamp(Event::Now()),
+          m_Specification(specification),
+          m_JobSystem(specification.WorkerThreadCount),
+          m_Pacer(specification.TargetFrameRate),
+          m_FixedTimestep(specification.FixedUpdateRate > 0.0 ? static_cast<float>(1.0 / specification.FixedUpdateRate) : 1.0f / 60.0f)
     {
-        m_Window = std::unique_ptr<Window>(Window::Create());
-        m_Window->SetEventCallback(BIND_EVENT_FN(OnEvent));
+        WindowProps windowProps(m_Specification.Name);
+        windowProps.Headless = m_Specification.Headless;
+
+        if (m_Specification.DedicatedInputThread)
+        {
+            m_InputThread = std::make_unique<InputThread>(windowProps, m_Specification.InputPollRate);
+            if (!m_InputThread->IsValid())
+            {
+                VEX_CORE_ERROR("Dedicated input thread failed to start; pumping the window on the main thread");
+                m_InputThread.reset();
+            }
+#ifdef VEX_VULKAN
+            // SDL's Vulkan surface calls must run on the thread that owns the window, and the renderer lives on this one
+            else if (m_Specification.UseVulkan && m_InputThread->GetWindow().GetNativeWindow())
+            {
+                VEX_CORE_ERROR("DedicatedInputThread cannot be combined with UseVulkan on a native window; pumping the window on the main thread");
+                m_InputThread.reset();
+            }
+#endif
+        }
+
+        if (!m_InputThread)
+        {
+            m_Window = std::unique_ptr<Window>(Window::Create(windowProps));
+            m_Window->SetEventCallback(BIND_EVENT_FN(OnEvent));
+            m_Window->SetEventQueue(&m_EventQueue);
+        }
+
+        m_EventRegistry.Subscribe<WindowCloseEvent, &Application::OnWindowClose>(this);
+        m_EventRegistry.Subscribe<WindowResizeEvent, &Application::OnWindowResize>(this);
+
+        if (m_Specification.UseVulkan)
+        {
+#ifdef VEX_VULKAN
+            // The pipeline cache is read on the job system while the device is being created
+            VulkanRendererSpecification rendererSpecification;
+            rendererSpecification.PipelineCachePath = m_Specification.PipelineCachePath;
+
+            m_Renderer = std::make_unique<VulkanRenderer>(GetWindow(), rendererSpecification, &m_JobSystem);
+            if (!m_Renderer->IsValid())
+            {
+                VEX_CORE_ERROR("Vulkan renderer failed to initialize; running without it");
+                m_Renderer.reset();
+            }
+#else
+            VEX_CORE_WARN("UseVulkan is set, but Vex was built without Vulkan (premake --vulkan)");
+#endif
+        }
+
+        if (m_Specification.FrameStatsReportInterval > 0.0)
+            m_FrameStats.SetReporting(m_Specification.FrameStatsReportInterval, m_Specification.FrameStatsCsvPath);
     }
 
     Application::~Application()
     {
+        // Every frame that ran belongs to an unfinished recording
+        m_Recorder.Stop(m_FrameIndex);
+
+        // Before the allocator report, so anything it logs on shutdown comes first
+        m_Renderer.reset();
+
+#ifdef VEX_DEBUG
+        VEX_CORE_INFO("Frame allocator high-water mark: {0} of {1} bytes", m_FrameAllocator.GetPeakUsed(), m_FrameAllocator.GetCapacity());
+        VEX_CORE_INFO("Double-buffered allocator high-water mark: {0} / {1} bytes",
+            m_DoubleBufferedAllocator.GetCurrent().GetPeakUsed(), m_DoubleBufferedAllocator.GetPrevious().GetPeakUsed());
+#endif
+    }
+
+    static uint32_t MicrosecondsBetween(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+    {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
     }
 
     void Application::Run()
 	{
+        VEX_PROFILE_FUNCTION();
+
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point lastFrame = Clock::now();
 
-        // Main loop (just for illustration)
         while (m_Running)
         {
-            m_Window->OnUpdate();
+            VEX_PROFILE_SCOPE("Frame");
+
+            Clock::time_point frameStart = Clock::now();
+            Timestep ts = std::chrono::duration<float>(frameStart - lastFrame).count();
+            lastFrame = frameStart;
+
+            // Last frame's transient memory is dead; the double-buffered side keeps one frame of history
+            m_FrameAllocator.Reset();
+            m_DoubleBufferedAllocator.Swap();
+
+            ProcessEvents();
+            m_InputActions.Update(Input::GetState());
+
+            RunFixedUpdates(ts);
 
+#ifdef VEX_VULKAN
+            // Waits only for the GPU frame that last used this frame slot
+            bool rendering = m_Renderer && m_Renderer->BeginFrame();
+#endif
+
+            m_LayerStack.Update(ts);
+            OnUpdate(ts);
+
+            // Work kicked off during the update belongs to this frame
+            {
+                VEX_PROFILE_SCOPE("Wait for frame jobs");
+                m_JobSystem.Wait(m_FrameJobs);
+            }
+
+#ifdef VEX_VULKAN
+            if (rendering)
+                m_Renderer->EndFrame();
+#endif
+
+            m_LayerStack.EndFrame();
+
+            if (m_FrameIndex == 0)
+                LogTimeToFirstFrame();
+
+            m_FrameIndex++;
+
+            // Sleep off the rest of the frame budget instead of spinning
+            {
+                VEX_PROFILE_SCOPE("FramePacer::Wait");
+                m_Pacer.Wait();
+            }
+
+            m_FrameStats.RecordFrame(MicrosecondsBetween(frameStart, Clock::now()), m_PumpMicroseconds, m_DispatchMicroseconds);
         }
 	}
 
+    void Application::LogTimeToFirstFrame() const
+    {
+        double milliseconds = static_cast<double>(Event::Now() - m_CreationTimestamp) / 1.0e6;
+
+#ifdef VEX_VULKAN
+        if (m_Renderer)
+        {
+            const VulkanPipelineCache& cache = m_Renderer->GetPipelineCache();
+            VEX_CORE_INFO("First frame after {0:.1f} ms (pipeline cache {1}, {2} shaders compiled, {3} cached)",
+                milliseconds, cache.IsWarm() ? "warm" : "cold", cache.GetShaderMisses(), cache.GetShaderHits());
+            return;
+        }
+#endif
+
+        VEX_CORE_INFO("First frame after {0:.1f} ms", milliseconds);
+    }
+
+    void Application::UpdateEventTypeFilter()
+    {
+        // The polled Input state is built from these, whether or not a handler wants them
+        constexpr uint32_t inputStateTypes =
+            EventTypeBit(EventType::KeyPressed) | EventTypeBit(EventType::KeyReleased) |
+            EventTypeBit(EventType::MouseButtonPressed) | EventTypeBit(EventType::MouseButtonReleased) |
+            EventTypeBit(EventType::MouseMoved) | EventTypeBit(EventType::MouseScrolled);
+
+        uint32_t wanted = m_EventRegistry.GetEventMask() | m_LayerStack.GetEventMask() | inputStateTypes;
+        if (m_Specification.TextInput)
+            wanted |= EventTypeBit(EventType::KeyTyped);
+
+        // A recording has to capture everything a later replay might subscribe to
+        if (m_Recorder.IsRecording())
+            wanted = AllEventTypes;
+
+        uint32_t changed = wanted ^ m_WantedEventTypes;
+        if (!changed)
+            return;
+
+        for (uint32_t type = 1; type < static_cast<uint32_t>(EventType::Count); type++)
+        {
+            if (changed & EventTypeBit(static_cast<EventType>(type)))
+                GetWindow().SetEventTypeEnabled(static_cast<EventType>(type), wanted & EventTypeBit(static_cast<EventType>(type)));
+        }
+
+        m_WantedEventTypes = wanted;
+    }
+
+    void Application::ProcessEvents()
+    {
+        VEX_PROFILE_FUNCTION();
+
+        UpdateEventTypeFilter();
+
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point pumpStart = Clock::now();
+        m_PumpTimestamp = Event::Now();
+
+        bool replaying = m_Player.IsPlaying();
+        if (replaying)
+        {
+            // Recorded input replaces the window pump entirely, so the polled Input state is advanced here
+            Input::BeginFrame();
+            m_Player.Feed(m_ReplayFrame++, m_EventQueue);
+        }
+        else if (!m_InputThread)
+        {
+            m_Window->OnUpdate();
+        }
+
+        Clock::time_point dispatchStart = Clock::now();
+        m_PumpMicroseconds = MicrosecondsBetween(pumpStart, dispatchStart);
+
+        auto dispatchWindowEvent = [this, replaying](Event& e)
+        {
+            // A pumped window has applied its events to Input already; replayed ones have not
+            if (replaying)
+                Input::ApplyEvent(e);
+
+            if (m_Recorder.IsRecording())
+                m_Recorder.Record(e, m_FrameIndex);
+
+            OnEvent(e);
+        };
+
+        if (m_InputThread)
+        {
+            // The input thread already pumped; everything it collected since the last frame is waiting.
+            // Live input is dropped while a replay drives the application, as it is when the window is not pumped.
+            if (!replaying)
+                Input::BeginFrame();
+
+            m_InputThread->Drain([&](Event& e)
+            {
+                if (replaying)
+                    return;
+
+                Input::ApplyEvent(e);
+                dispatchWindowEvent(e);
+            });
+        }
+
+        // Dispatch everything the pump collected this frame in one batch
+        m_EventQueue.Drain(dispatchWindowEvent);
+        m_PostedEvents.Drain([this](Event& e) { OnEvent(e); });
+
+        m_DispatchMicroseconds = MicrosecondsBetween(dispatchStart, Clock::now());
+
+        if (m_Player.IsPlaying() && m_Player.IsFinished())
+        {
+            VEX_CORE_INFO("Replay finished after {0} frames", m_ReplayFrame);
+            m_Player.Close();
+            m_Running = false;
+        }
+    }
+
+    void Application::RunFixedUpdates(Timestep ts)
+    {
+        VEX_PROFILE_FUNCTION();
+
+        // Clamp so a long stall (debugger, window drag) doesn't trigger a spiral of catch-up steps
+        float maxAccumulated = m_FixedTimestep * static_cast<float>(m_Specification.MaxFixedStepsPerFrame);
+        m_Accumulator = std::min(m_Accumulator + ts.GetSeconds(), maxAccumulated);
+
+        while (m_Accumulator >= m_FixedTimestep)
+        {
+            m_LayerStack.FixedUpdate(m_FixedTimestep);
+            OnFixedUpdate(m_FixedTimestep);
+            m_Accumulator -= m_FixedTimestep;
+        }
+
+        m_InterpolationAlpha = m_Accumulator / m_FixedTimestep;
+    }
+
+    bool Application::StartRecording(const std::string& path)
+    {
+        return m_Recorder.Start(path, m_FrameIndex);
+    }
+
+    void Application::StopRecording()
+    {
+        // The frame in progress is part of the recording
+        m_Recorder.Stop(m_FrameIndex + 1);
+    }
+
+    bool Application::StartReplay(const std::string& path)
+    {
+        m_ReplayFrame = 0;
+        return m_Player.Open(path);
+    }
+
+    void Application::PushLayer(Layer* layer)
+    {
+        m_LayerStack.PushLayer(layer);
+    }
+
+    void Application::PushOverlay(Layer* overlay)
+    {
+        m_LayerStack.PushOverlay(overlay);
+    }
+
     void Application::OnEvent(Event& e)
     {
-        VEX_CORE_INFO(e.ToString());
+        VEX_PROFILE_FUNCTION();
+
+        m_EventRegistry.Dispatch(e);
+        m_LayerStack.DispatchEvent(e);
+
+        // Runs for every event, so it goes through the binary channel: a few stores now, formatting on the decoder thread
+        VEX_BINLOG("{0} (timestamp {1} ns, handled {2})", e.GetName(), e.Timestamp, e.Handled);
+    }
+
+    bool Application::OnWindowClose([[maybe_unused]] WindowCloseEvent& e)
+    {
+        m_Running = false;
+
+        // Leave the event unhandled so layers still get a chance to react to the close
+        return false;
+    }
+
+    bool Application::OnWindowResize([[maybe_unused]] WindowResizeEvent& e)
+    {
+#ifdef VEX_VULKAN
+        if (m_Renderer)
+            m_Renderer->OnWindowResize(e.GetWidth(), e.GetHeight());
+#endif
+
+        return false;
     }
 }
 
@@ -1,27 +1,244 @@
 ﻿#pragma once
 
 #include "Core.h"
+#include "Vex/Debug/FrameStats.h"
+#include "Vex/Events/EventQueue.h"
+#include "Vex/Events/EventRecorder.h"
+#include "Vex/Events/EventRegistry.h"
+#include "Vex/Events/MPSCEventQueue.h"
+#include "Vex/FramePacer.h"
+#include "Vex/Input/InputActionMap.h"
+#include "Vex/Input/InputThread.h"
+#include "Vex/Jobs/JobSystem.h"
+#include "Vex/LayerStack.h"
+#include "Vex/Log.h"
+#include "Vex/Memory/FrameAllocator.h"
+#include "Vex/Timestep.h"
 #include <memory>
 
 namespace Vex
 {
 	class Event;
 	class Window;
+    class WindowCloseEvent;
+    class WindowResizeEvent;
+    class VulkanRenderer;
+
+    /**
+     * Command-line arguments the entry point hands to CreateApplication.
+     */
+    struct ApplicationCommandLineArgs
+    {
+        int Count = 0;
+        char** Args = nullptr;
+
+        /** Returns the argument at the given index; index 0 is the program. */
+        const char* operator[](int index) const { return Args[index]; }
+
+        /** Returns the index of the first argument equal to name, or -1 if it was not given. */
+        int Find(const std::string& name) const
+        {
+            for (int i = 1; i < Count; i++)
+            {
+                if (name == Args[i])
+                    return i;
+            }
+
+            return -1;
+        }
+    };
+
+    /**
+     * Options used to configure an Application and its frame loop.
+     */
+    struct ApplicationSpecification
+    {
+        std::string Name = "Vex Application";
+        double TargetFrameRate = 60.0;          ///< Frames per second the loop is paced to; 0 runs unpaced.
+        double FixedUpdateRate = 60.0;          ///< Simulation steps per second for OnFixedUpdate.
+        uint32_t MaxFixedStepsPerFrame = 8;     ///< Caps catch-up work after a long frame.
+        bool Headless = false;                  ///< Run without a display, e.g. for benchmarks; always true on Linux.
+        uint32_t WorkerThreadCount = 0;         ///< Job system threads besides the main thread; 0 picks one per spare core.
+        double FrameStatsReportInterval = 0.0;  ///< Seconds between frame-time reports; 0 disables them.
+        std::string FrameStatsCsvPath;          ///< Write frame-time reports to this CSV file instead of the log.
+        bool DedicatedInputThread = false;      ///< Create and pump the window on its own thread instead of once per frame; not with UseVulkan on a native window.
+        double InputPollRate = 1000.0;          ///< Pumps per second of the dedicated input thread.
+        bool TextInput = false;                 ///< Deliver KeyTyped events even while no layer or registry handler asks for them.
+        bool UseVulkan = false;                 ///< Render with the Vulkan backend; needs a build generated with premake's --vulkan option.
+        std::string PipelineCachePath = "VexPipelineCache.bin";  ///< Vulkan pipeline and shader cache, read in the background at startup; empty disables it.
+    };
 
 	class VEX_API Application
     {
-        std::unique_ptr<Window> m_Window = nullptr;
+        // Declared first so the job system outlives the layers, window and renderer that may still wait on it
+        uint64_t m_CreationTimestamp;       ///< Event::Now() when construction started, for the time to the first frame.
+        ApplicationSpecification m_Specification;
+        JobSystem m_JobSystem;
+        JobCounter m_FrameJobs;             ///< Jobs that must finish before the frame ends.
+
+        std::unique_ptr<Window> m_Window;
+        std::unique_ptr<InputThread> m_InputThread;  ///< Owns the window instead of m_Window when enabled.
+        EventQueue m_EventQueue;  ///< Events collected by the window pump, drained once per frame.
+        MPSCEventQueue m_PostedEvents;  ///< Events posted from other threads, drained next to the window events.
+        EventRegistry m_EventRegistry;  ///< Typed handlers that every drained event is dispatched to.
+        EventRecorder m_Recorder;       ///< Captures window events for later replay.
+        EventPlayer m_Player;           ///< Replaces the window pump while a recording is replayed.
+        LayerStack m_LayerStack;
+        InputActionMap m_InputActions;  ///< Resolved right after the events of each frame are dispatched.
+        uint64_t m_FrameIndex = 0;      ///< Number of frames run so far.
+        uint64_t m_ReplayFrame = 0;     ///< Frame of the recording being replayed.
         bool m_Running = true;
+
+        FramePacer m_Pacer;
+        LinearAllocator m_FrameAllocator;                   ///< Transient memory, reset at the start of every frame.
+        DoubleBufferedAllocator m_DoubleBufferedAllocator;  ///< Transient memory that survives into the next frame.
+        float m_FixedTimestep;              ///< Seconds per fixed simulation step.
+        float m_Accumulator = 0.0f;         ///< Unsimulated time carried into the next frame.
+        float m_InterpolationAlpha = 0.0f;  ///< Fraction of a fixed step left over after this frame's steps.
+
+        FrameStats m_FrameStats;
+        uint32_t m_PumpMicroseconds = 0;        ///< Time the window pump took this frame.
+        uint32_t m_DispatchMicroseconds = 0;    ///< Time event dispatch took this frame.
+        uint64_t m_PumpTimestamp = 0;           ///< Event::Now() when this frame's window pump started.
+        uint32_t m_WantedEventTypes = AllEventTypes;    ///< Event types the window was last told to produce.
+
+        std::unique_ptr<VulkanRenderer> m_Renderer;  ///< Only created when UseVulkan is set and Vulkan was built in.
     public:
-        Application();
+        Application(const ApplicationSpecification& specification = ApplicationSpecification());
         virtual ~Application();
 
         void Run();
 
         void OnEvent(Event& e);
+
+        /** Ends the frame loop after the current frame. */
+        void Close() { m_Running = false; }
+
+        /**
+         * Called once per frame after events are dispatched and fixed steps have run.
+         * @param ts Time elapsed since the previous frame.
+         */
+        virtual void OnUpdate([[maybe_unused]] Timestep ts) {}
+
+        /**
+         * Called zero or more times per frame, always with the same step, to advance the simulation.
+         * @param step The fixed simulation step (1 / FixedUpdateRate).
+         */
+        virtual void OnFixedUpdate([[maybe_unused]] Timestep step) {}
+
+        /**
+         * Returns how far the current frame lies between the last two fixed steps, in [0, 1).
+         * Use it to interpolate rendered state between the previous and current simulation states.
+         */
+        float GetInterpolationAlpha() const { return m_InterpolationAlpha; }
+
+        /** Pushes a layer below all overlays. The application takes ownership. */
+        void PushLayer(Layer* layer);
+
+        /** Pushes an overlay on top of all layers. The application takes ownership. */
+        void PushOverlay(Layer* overlay);
+
+        /** Returns the application's window, e.g. to inject input into a HeadlessWindow. */
+        Window& GetWindow() { return m_InputThread ? m_InputThread->GetWindow() : *m_Window; }
+
+        /**
+         * Returns the application's action map. Actions and axes are resolved from the polled input
+         * after each frame's events, so updates and fixed updates see the current frame's input.
+         */
+        InputActionMap& GetInputActions() { return m_InputActions; }
+
+        /** Returns the layer stack, e.g. to read per-layer timing. */
+        const LayerStack& GetLayerStack() const { return m_LayerStack; }
+
+        /** Changes the frame rate the loop is paced to; 0 runs unpaced. */
+        void SetTargetFrameRate(double targetFrameRate) { m_Pacer.SetTargetFrameRate(targetFrameRate); }
+
+        /**
+         * Returns when the current frame's window pump started, on the Event::Now() clock.
+         * Events dispatched this frame were collected by that pump.
+         */
+        uint64_t GetPumpTimestamp() const { return m_PumpTimestamp; }
+
+        /** Returns the rolling frame, pump and dispatch time percentiles. */
+        FrameStats& GetFrameStats() { return m_FrameStats; }
+
+        /**
+         * Returns the Vulkan renderer, or nullptr if the application does not render with Vulkan.
+         * Layers record into its command buffer during OnUpdate.
+         */
+        VulkanRenderer* GetRenderer() { return m_Renderer.get(); }
+
+        /** Returns the specification the application was created with. */
+        const ApplicationSpecification& GetSpecification() const { return m_Specification; }
+
+        /**
+         * Returns the allocator for memory that only lives until the end of the current frame.
+         * Wrap it in a FrameStlAllocator to back a FrameVector or FrameString.
+         */
+        LinearAllocator& GetFrameAllocator() { return m_FrameAllocator; }
+
+        /** Returns the allocator for memory that stays valid through the next frame as well. */
+        DoubleBufferedAllocator& GetDoubleBufferedAllocator() { return m_DoubleBufferedAllocator; }
+
+        /** Returns the job system shared by the application and its layers. */
+        JobSystem& GetJobSystem() { return m_JobSystem; }
+
+        /**
+         * Returns the counter of jobs the current frame waits on. Jobs submitted with it from OnUpdate or a
+         * layer are guaranteed to have finished before the next frame starts.
+         */
+        JobCounter& GetFrameJobCounter() { return m_FrameJobs; }
+
+        /**
+         * Posts an event from any thread. It is dispatched on the main thread during the next frame.
+         * Never blocks; returns false if the posted-event queue is full and the event was dropped.
+         */
+        template<typename T, typename... Args>
+        bool PostEvent(Args&&... args)
+        {
+            return m_PostedEvents.Post<T>(std::forward<Args>(args)...);
+        }
+
+        /**
+         * Starts recording every window event dispatched from now on into a binary file. Frames are counted
+         * from the current one, so a replay reproduces idle frames before the first event as well.
+         * Returns false if the file could not be created.
+         */
+        bool StartRecording(const std::string& path);
+
+        /** Stops the active recording, if any; the current frame is the last one it covers. */
+        void StopRecording();
+
+        /**
+         * Replays a recording instead of pumping the window, feeding each event back in the frame it was
+         * recorded in. The application stops once the recording has been fully replayed.
+         */
+        bool StartReplay(const std::string& path);
+
+        /** Returns the registry used to subscribe typed handlers to application events. */
+        EventRegistry& GetEventRegistry() { return m_EventRegistry; }
+
+    private:
+        /** Pumps the window (or the replay) and dispatches every queued event. */
+        void ProcessEvents();
+
+        /** Has the window drop the event types that nothing subscribed to, and restore those that gained a subscriber. */
+        void UpdateEventTypeFilter();
+
+        /** Runs as many fixed simulation steps as the accumulated time allows. */
+        void RunFixedUpdates(Timestep ts);
+
+        /** Logs the time from construction to the end of the first frame, i.e. startup cost. */
+        void LogTimeToFirstFrame() const;
+
+        bool OnWindowClose(WindowCloseEvent& e);
+        bool OnWindowResize(WindowResizeEvent& e);
     };
 
     // To be defined in Client Application
-    Application* CreateApplication();
+    Application* CreateApplication(ApplicationCommandLineArgs args);
+
+    // To be defined in Client Application; the entry point initializes logging with it before CreateApplication runs
+    LogSpecification GetLogSpecification();
 }
 
@@ -0,0 +1,277 @@
+/*
+ * @file BinaryLog.cpp
+ * @brief Implementation of the deferred-formatting binary log channel.
+ *
+ * Each thread owns a single-producer/single-consumer byte ring. A record is a RecordHeader followed
+ * by the raw argument bytes, padded to 8 bytes. When a record does not fit before the end of the
+ * ring, a wrap marker (site id 0) tells the decoder to continue at the start. If less than a header
+ * is left, there is no room for the marker either; both sides then wrap without one.
+ */
+
+#include "VexPch.h"
+#include "BinaryLog.h"
+#include "Log.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace Vex
+{
+    namespace
+    {
+        struct RecordHeader
+        {
+            uint32_t SiteId;        ///< Registered call site, or WrapMarker.
+            uint32_t Size;          ///< Size of the whole record including this header and padding.
+            uint64_t Timestamp;     ///< Nanoseconds since BinaryLog::Init().
+        };
+
+        constexpr uint32_t WrapMarker = 0;
+
+        struct ThreadBuffer
+        {
+            std::unique_ptr<std::byte[]> Data;
+            size_t Mask = 0;
+            size_t PendingWritePos = 0;                 ///< Producer only: end of the record being written.
+            alignas(64) std::atomic<size_t> WritePos{ 0 };
+            alignas(64) std::atomic<size_t> ReadPos{ 0 };
+            std::atomic<bool> Retired{ false };         ///< Set when the owning thread exits.
+        };
+
+        struct Site
+        {
+            const char* Format;
+            BinaryLog::DecodeFn Decode;
+        };
+
+        struct BinaryLogState
+        {
+            std::mutex Mutex;                                   ///< Guards Sites, Buffers and decoding.
+            std::vector<Site> Sites;
+            std::vector<std::shared_ptr<ThreadBuffer>> Buffers;
+            size_t BufferSize = 0;
+
+            std::thread Decoder;
+            std::atomic<bool> Running{ false };
+            std::chrono::milliseconds FlushInterval{ 10 };
+            std::atomic<uint64_t> Dropped{ 0 };
+            std::chrono::steady_clock::time_point Start;
+        };
+
+        BinaryLogState s_State;
+
+        /**
+         * Owns the calling thread's ring buffer. The buffer itself stays registered after the thread
+         * exits so the decoder can drain what is left in it.
+         */
+        struct ThreadBufferHandle
+        {
+            std::shared_ptr<ThreadBuffer> Buffer;
+
+            ~ThreadBufferHandle()
+            {
+                if (Buffer)
+                    Buffer->Retired.store(true, std::memory_order_release);
+            }
+        };
+
+        thread_local ThreadBufferHandle t_Handle;
+
+        size_t AlignUp(size_t value, size_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        size_t RoundUpToPowerOfTwo(size_t value)
+        {
+            size_t result = 1;
+            while (result < value)
+                result <<= 1;
+            return result;
+        }
+
+        ThreadBuffer* GetThreadBuffer()
+        {
+            if (!t_Handle.Buffer)
+            {
+                auto buffer = std::make_shared<ThreadBuffer>();
+
+                std::lock_guard lock(s_State.Mutex);
+                buffer->Data = std::make_unique<std::byte[]>(s_State.BufferSize);
+                buffer->Mask = s_State.BufferSize - 1;
+                s_State.Buffers.push_back(buffer);
+                t_Handle.Buffer = std::move(buffer);
+            }
+
+            return t_Handle.Buffer.get();
+        }
+
+        /** True if no header fits between offset and the end of the ring, so the position wraps without a marker. */
+        bool IsImplicitWrap(size_t offset, size_t capacity)
+        {
+            return capacity - offset < sizeof(RecordHeader);
+        }
+
+        /**
+         * Decodes every committed record in one buffer into the core logger. Caller holds the mutex.
+         */
+        void DrainBuffer(ThreadBuffer& buffer, fmt::memory_buffer& text)
+        {
+            size_t read = buffer.ReadPos.load(std::memory_order_relaxed);
+            size_t write = buffer.WritePos.load(std::memory_order_acquire);
+            size_t capacity = buffer.Mask + 1;
+
+            while (read < write)
+            {
+                size_t offset = read & buffer.Mask;
+                if (IsImplicitWrap(offset, capacity))
+                {
+                    read += capacity - offset;
+                    continue;
+                }
+
+                RecordHeader header;
+                std::memcpy(&header, buffer.Data.get() + offset, sizeof(header));
+
+                if (header.SiteId == WrapMarker)
+                {
+                    read += capacity - offset;
+                    continue;
+                }
+
+                const Site& site = s_State.Sites[header.SiteId - 1];
+
+                text.clear();
+                fmt::format_to(std::back_inserter(text), "[{:.6f} ms] ", static_cast<double>(header.Timestamp) / 1e6);
+                site.Decode(site.Format, buffer.Data.get() + offset + sizeof(header), text);
+
+                Log::GetCoreLogger()->log(spdlog::level::trace, spdlog::string_view_t(text.data(), text.size()));
+
+                read += header.Size;
+            }
+
+            buffer.ReadPos.store(read, std::memory_order_release);
+        }
+
+        /**
+         * Drains every registered buffer and forgets buffers of exited threads once they are empty.
+         */
+        void DrainAll()
+        {
+            std::lock_guard lock(s_State.Mutex);
+            fmt::memory_buffer text;
+
+            for (auto& buffer : s_State.Buffers)
+                DrainBuffer(*buffer, text);
+
+            auto& buffers = s_State.Buffers;
+            buffers.erase(std::remove_if(buffers.begin(), buffers.end(), [](const std::shared_ptr<ThreadBuffer>& buffer)
+            {
+                return buffer->Retired.load(std::memory_order_acquire)
+                    && buffer->ReadPos.load(std::memory_order_relaxed) == buffer->WritePos.load(std::memory_order_acquire);
+            }), buffers.end());
+        }
+    }
+
+    void BinaryLog::Init(size_t threadBufferSize, std::chrono::milliseconds flushInterval)
+    {
+        s_State.BufferSize = RoundUpToPowerOfTwo(std::max<size_t>(threadBufferSize, 4096));
+        s_State.FlushInterval = flushInterval;
+        s_State.Start = std::chrono::steady_clock::now();
+        s_State.Running.store(true, std::memory_order_release);
+
+        s_State.Decoder = std::thread([]()
+        {
+            while (s_State.Running.load(std::memory_order_acquire))
+            {
+                DrainAll();
+                std::this_thread::sleep_for(s_State.FlushInterval);
+            }
+        });
+    }
+
+    void BinaryLog::Shutdown()
+    {
+        if (!s_State.Running.exchange(false))
+            return;
+
+        s_State.Decoder.join();
+        DrainAll();
+
+        if (uint64_t dropped = GetDroppedCount())
+            VEX_CORE_WARN("Binary log dropped {0} records because a thread buffer was full", dropped);
+    }
+
+    void BinaryLog::Flush()
+    {
+        DrainAll();
+    }
+
+    uint32_t BinaryLog::RegisterSite(const char* format, DecodeFn decode)
+    {
+        std::lock_guard lock(s_State.Mutex);
+        s_State.Sites.push_back({ format, decode });
+        return static_cast<uint32_t>(s_State.Sites.size());
+    }
+
+    uint64_t BinaryLog::GetDroppedCount()
+    {
+        return s_State.Dropped.load(std::memory_order_relaxed);
+    }
+
+    bool BinaryLog::IsRunning()
+    {
+        return s_State.Running.load(std::memory_order_acquire);
+    }
+
+    size_t BinaryLog::GetThreadBufferSize()
+    {
+        return s_State.BufferSize;
+    }
+
+    std::byte* BinaryLog::BeginRecord(uint32_t siteId, size_t argsSize)
+    {
+        if (!s_State.Running.load(std::memory_order_relaxed))
+            return nullptr;
+
+        ThreadBuffer& buffer = *GetThreadBuffer();
+        size_t capacity = buffer.Mask + 1;
+        size_t size = AlignUp(sizeof(RecordHeader) + argsSize, alignof(RecordHeader));
+
+        size_t write = buffer.WritePos.load(std::memory_order_relaxed);
+        size_t read = buffer.ReadPos.load(std::memory_order_acquire);
+        size_t offset = write & buffer.Mask;
+        size_t contiguous = capacity - offset;
+        size_t needed = size > contiguous ? size + contiguous : size;
+
+        if (write + needed - read > capacity)
+        {
+            s_State.Dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        if (size > contiguous)
+        {
+            // Not enough room before the end of the ring: leave a wrap marker, if it fits, and start over at 0
+            if (!IsImplicitWrap(offset, capacity))
+                std::memcpy(buffer.Data.get() + offset, &WrapMarker, sizeof(WrapMarker));
+            write += contiguous;
+            offset = 0;
+        }
+
+        RecordHeader header{ siteId, static_cast<uint32_t>(size), 0 };
+        header.Timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - s_State.Start).count());
+        std::memcpy(buffer.Data.get() + offset, &header, sizeof(header));
+
+        buffer.PendingWritePos = write + size;
+        return buffer.Data.get() + offset + sizeof(header);
+    }
+
+    void BinaryLog::CommitRecord()
+    {
+        ThreadBuffer& buffer = *t_Handle.Buffer;
+        buffer.WritePos.store(buffer.PendingWritePos, std::memory_order_release);
+    }
+}
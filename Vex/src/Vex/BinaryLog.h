@@ -0,0 +1,158 @@
+﻿/*
+ * @file BinaryLog.h
+ * @brief Deferred-formatting binary log channel for hot-path tracing.
+ *
+ * Sits next to the core and client loggers in Log.h. A `VEX_BINLOG` call does no formatting at
+ * all: it stores the id of its call site (registered once, holding the format string) and the raw
+ * bytes of its arguments in a thread-local ring buffer. A background decoder thread later turns the
+ * records into text and hands them to the core logger. Recording costs a timestamp, a few memcpys
+ * and one atomic store, so the channel can stay enabled in production builds.
+ *
+ * Usage:
+ * - Call `Vex::BinaryLog::Init()` after `Vex::Log::Init()`, and `Vex::BinaryLog::Shutdown()` before `Vex::Log::Shutdown()`.
+ * - `VEX_BINLOG("dispatched {0} events in {1} ns", count, ns);`
+ *
+ * Arguments must be trivially copyable. Pointers are stored as-is, so `const char*` arguments must
+ * point to strings that outlive the decoder (string literals).
+ *
+ * If a thread's ring buffer is full the record is dropped and counted rather than blocking the caller.
+ */
+
+#pragma once
+
+#include "Core.h"
+#include "spdlog/fmt/fmt.h"
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <tuple>
+
+namespace Vex
+{
+    /**
+     * @class BinaryLog
+     * @brief Static interface of the binary log channel.
+     */
+    class VEX_API BinaryLog
+    {
+    public:
+        /** Decodes a record's argument bytes and appends the formatted text to out. */
+        using DecodeFn = void(*)(const char* format, const std::byte* args, fmt::memory_buffer& out);
+
+        /**
+         * @brief Starts the decoder thread.
+         * @param threadBufferSize Size in bytes of each thread's ring buffer.
+         * @param flushInterval How often the decoder drains the ring buffers.
+         */
+        static void Init(size_t threadBufferSize = 1024 * 1024,
+            std::chrono::milliseconds flushInterval = std::chrono::milliseconds(10));
+
+        /**
+         * @brief Decodes everything still buffered and stops the decoder thread.
+         */
+        static void Shutdown();
+
+        /**
+         * @brief Decodes every record buffered so far, on the calling thread, without waiting for the decoder.
+         */
+        static void Flush();
+
+        /**
+         * @brief Registers a call site. Called once per call site through VEX_BINLOG.
+         * @param format The fmt format string of the call site.
+         * @param decode Decoder matching the argument types of the call site.
+         * @return The id stored in every record written by that call site.
+         */
+        static uint32_t RegisterSite(const char* format, DecodeFn decode);
+
+        /** @return Number of records dropped because a thread's ring buffer was full. */
+        static uint64_t GetDroppedCount();
+
+        /** @return True between Init() and Shutdown(); records written at other times are discarded. */
+        static bool IsRunning();
+
+        /** @return Size in bytes of each thread's ring buffer, after rounding up to a power of two. */
+        static size_t GetThreadBufferSize();
+
+        /**
+         * @brief Records a log call. Use VEX_BINLOG instead of calling this directly.
+         * @tparam FormatTag Unique captureless lambda type returning the format string; gives each call site its own id.
+         */
+        template<typename FormatTag, typename... Args>
+        static void Write(FormatTag, const Args&... args)
+        {
+            static_assert((std::is_trivially_copyable_v<Args> && ...), "VEX_BINLOG arguments must be trivially copyable");
+
+            static const uint32_t s_SiteId = RegisterSite(FormatTag{}(), &Decode<Args...>);
+
+            constexpr size_t argsSize = (sizeof(Args) + ... + 0);
+            std::byte* out = BeginRecord(s_SiteId, argsSize);
+            if (!out)
+                return;
+
+            ((std::memcpy(out, &args, sizeof(Args)), out += sizeof(Args)), ...);
+            CommitRecord();
+        }
+
+    private:
+        /**
+         * Reserves space for a record in the calling thread's buffer and writes its header.
+         * Returns the address for the argument bytes, or nullptr if the record was dropped.
+         */
+        static std::byte* BeginRecord(uint32_t siteId, size_t argsSize);
+
+        /** Publishes the record reserved by the last BeginRecord() call to the decoder. */
+        static void CommitRecord();
+
+        /**
+         * Type an argument is decoded as. Character arrays (string literals) are formatted straight from the
+         * record, other arrays become std::array, everything else is rebuilt as itself.
+         */
+        template<typename T>
+        using DecodedArgument = std::conditional_t<std::is_array_v<T>,
+            std::conditional_t<std::is_same_v<std::remove_cv_t<std::remove_extent_t<T>>, char>,
+                const char*, std::array<std::remove_cv_t<std::remove_extent_t<T>>, std::extent_v<T>>>,
+            T>;
+
+        /** Rebuilds one argument from its raw bytes; works for types without a default constructor. */
+        template<typename T>
+        static DecodedArgument<T> ReadArgument(const std::byte*& data)
+        {
+            const std::byte* source = data;
+            data += sizeof(T);
+
+            if constexpr (std::is_same_v<DecodedArgument<T>, const char*>)
+            {
+                return reinterpret_cast<const char*>(source);
+            }
+            else
+            {
+                std::array<std::byte, sizeof(T)> bytes;
+                std::memcpy(bytes.data(), source, sizeof(T));
+                return std::bit_cast<DecodedArgument<T>>(bytes);
+            }
+        }
+
+        template<typename... Args>
+        static void Decode(const char* format, [[maybe_unused]] const std::byte* data, fmt::memory_buffer& out)
+        {
+            // Braced initialization reads the arguments in order
+            std::tuple<DecodedArgument<Args>...> args{ ReadArgument<Args>(data)... };
+
+            // The format string is only checked at runtime; a bad one must not take down the decoder thread
+            try
+            {
+                std::apply([&](const auto&... arg) { fmt::format_to(std::back_inserter(out), fmt::runtime(format), arg...); }, args);
+            }
+            catch (const fmt::format_error& error)
+            {
+                fmt::format_to(std::back_inserter(out), "<format error in \"{}\": {}>", format, error.what());
+            }
+        }
+    };
+}
+
+// Binary log macro. Arguments are captured raw and formatted later by the decoder thread.
+#define VEX_BINLOG(format, ...)     ::Vex::BinaryLog::Write([]() -> const char* { return format; }, ##__VA_ARGS__)
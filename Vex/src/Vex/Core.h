@@ -4,20 +4,21 @@
  *
  * This header file ensures that symbols are properly exported when building 
  * the Vex Engine as a DLL and properly imported when using the DLL in other projects. 
- * It also restricts the engine to only compile on Windows platforms.
+ * It also restricts the engine to the supported platforms.
  *
  * Usage:
  * - Define VEX_PLATFORM_WINDOWS to indicate that the engine is being compiled on Windows.
+ * - Define VEX_PLATFORM_LINUX to compile the engine as a shared library on Linux.
  * - Define VEX_BUILD_DLL when building the Vex Engine as a dynamic library.
  * - When using the DLL, ensure VEX_BUILD_DLL is undefined to import symbols correctly.
  *
- * @note Vex Engine currently supports only Windows.
+ * @note On Linux the engine runs with the headless window backend only.
  */
 
 #pragma once
 
-// Ensure the platform is Windows
-#ifdef VEX_PLATFORM_WINDOWS
+// Ensure the platform is supported
+#if defined(VEX_PLATFORM_WINDOWS)
 
     // Determine whether we are exporting or importing symbols for a DLL
     #ifdef VEX_BUILD_DLL
@@ -26,9 +27,18 @@
         #define VEX_API __declspec(dllimport) // Import symbols when using the DLL
     #endif
 
+#elif defined(VEX_PLATFORM_LINUX)
+
+    // Shared objects export everything marked with default visibility; importing needs no annotation
+    #ifdef VEX_BUILD_DLL
+        #define VEX_API __attribute__((visibility("default")))
+    #else
+        #define VEX_API
+    #endif
+
 #else
-    // Compilation is restricted to Windows
-    #error Vex only supports Windows!
+    // Compilation is restricted to Windows and Linux
+    #error Vex only supports Windows and Linux!
 #endif
 
 #define BIT(x) (1 << x)
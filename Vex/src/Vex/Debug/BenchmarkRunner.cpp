@@ -0,0 +1,170 @@
+﻿#include "VexPch.h"
+#include "BenchmarkRunner.h"
+
+#include "Vex/Window.h"
+#include "Vex/Debug/ECSBenchmark.h"
+#include "Vex/Debug/EventFormatBenchmark.h"
+#include "Vex/Debug/EventPumpBenchmark.h"
+#include "Vex/Debug/EventQueueBenchmark.h"
+#include "Vex/Debug/EventRegistryBenchmark.h"
+#include "Vex/Debug/JobSystemBenchmark.h"
+#include "Vex/Debug/LoggingBenchmark.h"
+#include "Vex/Debug/MPSCEventQueueBenchmark.h"
+#include "Vex/Debug/RasterizerBenchmark.h"
+#include "Vex/Debug/Renderer2DBenchmark.h"
+#include "Vex/Debug/VulkanSmokeTest.h"
+#include "Vex/Debug/VulkanStartupBenchmark.h"
+
+namespace Vex
+{
+    namespace
+    {
+        /**
+         * A benchmark the runner knows by name. Run returns false if a stress test or smoke test failed.
+         */
+        struct BenchmarkEntry
+        {
+            const char* Name;
+            bool (*Run)();
+        };
+
+        bool RunEventPump()
+        {
+            // Headless, so the numbers do not depend on a display
+            WindowProps props;
+            props.Headless = true;
+
+            EventPumpBenchmarkSpecification specification;
+            EventPumpBenchmark::LogResult("default", EventPumpBenchmark::Run(props, specification));
+
+            specification.DisabledEventTypes.clear();
+            EventPumpBenchmark::LogResult("unfiltered", EventPumpBenchmark::Run(props, specification));
+
+            specification.CoalesceMouseEvents = true;
+            EventPumpBenchmark::LogResult("coalesced", EventPumpBenchmark::Run(props, specification));
+            return true;
+        }
+
+        bool RunLogging()
+        {
+            LoggingBenchmark::LogResult("synchronous", LoggingBenchmark::Run(LogMode::Synchronous));
+            LoggingBenchmark::LogResult("asynchronous", LoggingBenchmark::Run(LogMode::Asynchronous));
+
+            BinaryLogStressResult stress = LoggingBenchmark::RunBinaryLogStress();
+            LoggingBenchmark::LogResult("default", stress);
+            return stress.Passed();
+        }
+
+        bool RunJobSystem()
+        {
+            JobSystemBenchmark::LogResult("default", JobSystemBenchmark::Run());
+
+            JobSystemStressResult stress = JobSystemBenchmark::RunStress();
+            JobSystemBenchmark::LogResult("default", stress);
+            return stress.Passed();
+        }
+
+        bool RunMPSCEventQueue()
+        {
+            MPSCEventQueueBenchmark::LogResult("default", MPSCEventQueueBenchmark::Run());
+
+            MPSCEventQueueStressResult stress = MPSCEventQueueBenchmark::RunStress();
+            MPSCEventQueueBenchmark::LogResult("default", stress);
+            return stress.Passed();
+        }
+
+#ifdef VEX_VULKAN
+        bool RunVulkanSmokeTest()
+        {
+            VulkanSmokeTestResult result = VulkanSmokeTest::Run();
+            VulkanSmokeTest::LogResult("default", result);
+            return result.Passed();
+        }
+#endif
+
+        const BenchmarkEntry s_Benchmarks[] =
+        {
+            { "eventqueue",     [] { EventQueueBenchmark::LogResult("default", EventQueueBenchmark::Run()); return true; } },
+            { "eventregistry",  [] { EventRegistryBenchmark::LogResult("default", EventRegistryBenchmark::Run()); return true; } },
+            { "mpsc",           &RunMPSCEventQueue },
+            { "eventformat",    [] { EventFormatBenchmark::LogResult("default", EventFormatBenchmark::Run()); return true; } },
+            { "logging",        &RunLogging },
+            { "jobsystem",      &RunJobSystem },
+            { "eventpump",      &RunEventPump },
+            { "rasterizer",     [] { RasterizerBenchmark::LogResults(RasterizerBenchmark::Run()); return true; } },
+            { "renderer2d",     [] { Renderer2DBenchmark::LogResult("default", Renderer2DBenchmark::Run()); return true; } },
+            { "ecs",            [] { ECSBenchmark::LogResult("default", ECSBenchmark::Run()); return true; } },
+#ifdef VEX_VULKAN
+            { "vulkansmoke",    &RunVulkanSmokeTest },
+            { "vulkanstartup",  [] { VulkanStartupBenchmark::LogResult("default", VulkanStartupBenchmark::Run()); return true; } },
+#endif
+        };
+
+        const BenchmarkEntry* FindBenchmark(const std::string& name)
+        {
+            for (const BenchmarkEntry& entry : s_Benchmarks)
+            {
+                if (name == entry.Name)
+                    return &entry;
+            }
+
+            return nullptr;
+        }
+    }
+
+    int BenchmarkRunner::Run(const std::vector<std::string>& names)
+    {
+        std::vector<const BenchmarkEntry*> selected;
+        int failures = 0;
+
+        if (names.empty())
+        {
+            for (const BenchmarkEntry& entry : s_Benchmarks)
+                selected.push_back(&entry);
+        }
+
+        for (const std::string& name : names)
+        {
+            if (const BenchmarkEntry* entry = FindBenchmark(name))
+            {
+                selected.push_back(entry);
+                continue;
+            }
+
+            VEX_CORE_ERROR("Unknown benchmark '{0}'", name);
+            failures++;
+        }
+
+        if (failures)
+        {
+            std::string available;
+            for (const std::string& name : GetNames())
+                available += (available.empty() ? "" : ", ") + name;
+
+            VEX_CORE_ERROR("Available benchmarks: {0}", available);
+            return failures;
+        }
+
+        for (const BenchmarkEntry* entry : selected)
+        {
+            VEX_CORE_INFO("Running benchmark '{0}'", entry->Name);
+            if (!entry->Run())
+            {
+                VEX_CORE_ERROR("Benchmark '{0}' failed", entry->Name);
+                failures++;
+            }
+        }
+
+        VEX_CORE_INFO("{0} benchmarks run, {1} failed", selected.size(), failures);
+        return failures;
+    }
+
+    std::vector<std::string> BenchmarkRunner::GetNames()
+    {
+        std::vector<std::string> names;
+        for (const BenchmarkEntry& entry : s_Benchmarks)
+            names.push_back(entry.Name);
+
+        return names;
+    }
+}
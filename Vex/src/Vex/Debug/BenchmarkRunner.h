@@ -0,0 +1,31 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <string>
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * @class BenchmarkRunner
+     * @brief Runs the Debug benchmarks and stress tests by name, e.g. through `Sandbox --benchmark`.
+     *
+     * Every benchmark runs with its default specification and logs its result under the label "default";
+     * where a benchmark compares variants (logging modes, event pump filtering), each variant is run in
+     * turn. The Vulkan entries are only available in builds generated with premake's --vulkan option.
+     */
+    class VEX_API BenchmarkRunner
+    {
+    public:
+        /**
+         * Runs the named benchmarks in the given order, or every benchmark if no names are given.
+         * @param names Names as returned by GetNames().
+         * @return The number of failed stress tests and unknown names; 0 if everything passed.
+         */
+        static int Run(const std::vector<std::string>& names);
+
+        /** @return The names Run() accepts, in the order it runs them when given none. */
+        static std::vector<std::string> GetNames();
+    };
+}
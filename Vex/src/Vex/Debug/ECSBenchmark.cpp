@@ -0,0 +1,112 @@
+﻿#include "VexPch.h"
+#include "ECSBenchmark.h"
+
+#include "Vex/Jobs/JobSystem.h"
+#include "Vex/Log.h"
+#include "Vex/Scene/World.h"
+
+#include <chrono>
+
+namespace Vex
+{
+    namespace
+    {
+        struct BenchmarkPosition { float X, Y, Z; };
+        struct BenchmarkVelocity { float X, Y, Z; };
+        struct BenchmarkLifetime { float Seconds; };
+        struct BenchmarkHealth { int32_t Current, Maximum; };
+    }
+
+    ECSBenchmarkResult ECSBenchmark::Run(const ECSBenchmarkSpecification& specification)
+    {
+        using Clock = std::chrono::steady_clock;
+        auto nanosecondsPer = [](Clock::time_point start, Clock::time_point end, uint32_t count)
+        {
+            return static_cast<float>(std::chrono::duration<double, std::nano>(end - start).count() / std::max(count, 1u));
+        };
+
+        uint32_t count = specification.EntityCount;
+        uint32_t iterations = std::max(specification.Iterations, 1u);
+
+        World world;
+        std::vector<Entity> entities;
+        entities.reserve(count);
+
+        ECSBenchmarkResult result;
+        result.Entities = count;
+
+        Clock::time_point start = Clock::now();
+        for (uint32_t i = 0; i < count; i++)
+        {
+            BenchmarkPosition position = { static_cast<float>(i), 0.0f, 0.0f };
+            BenchmarkVelocity velocity = { 1.0f, 2.0f, 3.0f };
+            if (i % 4 == 0)
+                entities.push_back(world.CreateEntity(position, velocity, BenchmarkLifetime{ 5.0f }));
+            else
+                entities.push_back(world.CreateEntity(position, velocity));
+        }
+        result.CreateNanoseconds = nanosecondsPer(start, Clock::now(), count);
+
+        auto integrate = [](BenchmarkPosition& position, const BenchmarkVelocity& velocity)
+        {
+            position.X += velocity.X * (1.0f / 60.0f);
+            position.Y += velocity.Y * (1.0f / 60.0f);
+            position.Z += velocity.Z * (1.0f / 60.0f);
+        };
+
+        Query<BenchmarkPosition, const BenchmarkVelocity> query = world.CreateQuery<BenchmarkPosition, const BenchmarkVelocity>();
+
+        // The first pass warms the caches and the query's archetype list
+        query.ForEach(integrate);
+        start = Clock::now();
+        for (uint32_t i = 0; i < iterations; i++)
+            query.ForEach(integrate);
+        Clock::time_point end = Clock::now();
+
+        result.IterateMilliseconds = static_cast<float>(std::chrono::duration<double, std::milli>(end - start).count() / iterations);
+        result.IterateNanoseconds = nanosecondsPer(start, end, count * iterations);
+
+        if (specification.Threads > 1)
+        {
+            JobSystem jobSystem(specification.Threads - 1);
+            query.ParallelForEach(jobSystem, integrate);
+
+            start = Clock::now();
+            for (uint32_t i = 0; i < iterations; i++)
+                query.ParallelForEach(jobSystem, integrate);
+            result.ParallelIterateMilliseconds = static_cast<float>(
+                std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations);
+        }
+
+        start = Clock::now();
+        for (Entity entity : entities)
+            world.AddComponent<BenchmarkHealth>(entity, BenchmarkHealth{ 100, 100 });
+        result.AddComponentNanoseconds = nanosecondsPer(start, Clock::now(), count);
+
+        result.Archetypes = static_cast<uint32_t>(world.GetArchetypes().size());
+        for (const std::unique_ptr<Archetype>& archetype : world.GetArchetypes())
+            result.Chunks += static_cast<uint32_t>(archetype->GetChunks().size());
+
+        start = Clock::now();
+        for (Entity entity : entities)
+            world.RemoveComponent<BenchmarkHealth>(entity);
+        result.RemoveComponentNanoseconds = nanosecondsPer(start, Clock::now(), count);
+
+        start = Clock::now();
+        for (Entity entity : entities)
+            world.DestroyEntity(entity);
+        result.DestroyNanoseconds = nanosecondsPer(start, Clock::now(), count);
+
+        return result;
+    }
+
+    void ECSBenchmark::LogResult(const std::string& label, const ECSBenchmarkResult& result)
+    {
+        VEX_CORE_INFO("ECS '{0}': {1} entities in {2} archetypes, {3} chunks",
+            label, result.Entities, result.Archetypes, result.Chunks);
+        VEX_CORE_INFO("  iterate {0:.3f} ms ({1:.2f} ns/entity), parallel {2:.3f} ms",
+            result.IterateMilliseconds, result.IterateNanoseconds, result.ParallelIterateMilliseconds);
+        VEX_CORE_INFO("  ns/entity: create {0:.1f} add component {1:.1f} remove component {2:.1f} destroy {3:.1f}",
+            result.CreateNanoseconds, result.AddComponentNanoseconds, result.RemoveComponentNanoseconds, result.DestroyNanoseconds);
+    }
+}
@@ -0,0 +1,52 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <string>
+
+namespace Vex
+{
+    /**
+     * Options for an ECS benchmark.
+     */
+    struct ECSBenchmarkSpecification
+    {
+        uint32_t EntityCount = 100000;
+        uint32_t Iterations = 20;   ///< Query passes averaged for the iteration timings.
+        uint32_t Threads = 1;       ///< Threads for the parallel pass, including the caller; 1 skips it.
+    };
+
+    /**
+     * Cost of the basic World operations at one entity count.
+     */
+    struct ECSBenchmarkResult
+    {
+        uint32_t Entities = 0;
+        uint32_t Archetypes = 0;
+        uint32_t Chunks = 0;
+        float CreateNanoseconds = 0.0f;         ///< Per entity, created with its components.
+        float IterateMilliseconds = 0.0f;       ///< One ForEach pass over every entity.
+        float ParallelIterateMilliseconds = 0.0f;
+        float IterateNanoseconds = 0.0f;        ///< Per entity, single-threaded.
+        float AddComponentNanoseconds = 0.0f;   ///< Per entity, moving it to a new archetype.
+        float RemoveComponentNanoseconds = 0.0f;
+        float DestroyNanoseconds = 0.0f;
+    };
+
+    /**
+     * @class ECSBenchmark
+     * @brief Times entity creation, query iteration and add/remove-component on a World.
+     *
+     * Entities get a position and a velocity, and every fourth one a lifetime, so the query spans two
+     * archetypes. Iteration integrates positions; adding and removing a health component moves every
+     * entity to another archetype and back. Run it at a few sizes (10k, 100k, 1M) to see how it scales.
+     */
+    class VEX_API ECSBenchmark
+    {
+    public:
+        static ECSBenchmarkResult Run(const ECSBenchmarkSpecification& specification = ECSBenchmarkSpecification());
+
+        /** Writes a result to the core logger under the given label. */
+        static void LogResult(const std::string& label, const ECSBenchmarkResult& result);
+    };
+}
@@ -0,0 +1,101 @@
+﻿#include "VexPch.h"
+#include "EventFormatBenchmark.h"
+
+#include "Vex/Events/ApplicationEvent.h"
+#include "Vex/Events/KeyEvent.h"
+#include "Vex/Events/MouseEvent.h"
+#include "Vex/Log.h"
+#include "spdlog/sinks/null_sink.h"
+
+#include <chrono>
+#include <sstream>
+
+namespace Vex
+{
+    /**
+     * The ToString() the events had before they got fmt formatters.
+     */
+    static std::string StreamToString(const Event& e)
+    {
+        std::stringstream ss;
+        switch (e.GetEventType())
+        {
+        case EventType::MouseMoved:
+        {
+            const auto& event = static_cast<const MouseMovedEvent&>(e);
+            ss << "MouseMovedEvent: " << event.GetX() << ", " << event.GetY();
+            break;
+        }
+        case EventType::KeyPressed:
+        {
+            const auto& event = static_cast<const KeyPressedEvent&>(e);
+            ss << "KeyPressedEvent: " << event.GetKeyCode() << " (repeat = " << event.IsRepeat() << ")";
+            break;
+        }
+        case EventType::KeyReleased:
+            ss << "KeyReleasedEvent: " << static_cast<const KeyReleasedEvent&>(e).GetKeyCode();
+            break;
+        case EventType::MouseButtonPressed:
+            ss << "MouseButtonPressedEvent: " << static_cast<const MouseButtonPressedEvent&>(e).GetMouseButton();
+            break;
+        case EventType::WindowResize:
+        {
+            const auto& event = static_cast<const WindowResizeEvent&>(e);
+            ss << "WindowResizeEvent: " << event.GetWidth() << ", " << event.GetHeight();
+            break;
+        }
+        default:
+            ss << e.GetName();
+            break;
+        }
+        return ss.str();
+    }
+
+    EventFormatBenchmarkResult EventFormatBenchmark::Run(const EventFormatBenchmarkSpecification& specification)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        MouseMovedEvent mouseMoved(640.5f, 360.25f, 1.0f, 0.0f);
+        KeyPressedEvent keyPressed(Key::A, true);
+        KeyReleasedEvent keyReleased(Key::A);
+        MouseButtonPressedEvent buttonPressed(Mouse::ButtonLeft);
+        WindowResizeEvent windowResize(1280, 720);
+        Event* others[] = { &keyPressed, &keyReleased, &buttonPressed, &windowResize };
+
+        std::vector<Event*> sequence;
+        for (uint32_t i = 0; i < 100; i++)
+            sequence.push_back(i < specification.MotionPercent ? static_cast<Event*>(&mouseMoved) : others[i % 4]);
+
+        // Not registered with spdlog; the null sink drops every message once it is formatted
+        auto logger = std::make_shared<spdlog::logger>("BENCH", std::make_shared<spdlog::sinks::null_sink_mt>());
+
+        uint32_t events = std::max(specification.Events, 1u);
+        auto measure = [&](spdlog::level::level_enum level, auto&& logEvent)
+        {
+            logger->set_level(level);
+
+            Clock::time_point start = Clock::now();
+            for (uint32_t i = 0; i < events; i++)
+                logEvent(*sequence[i % sequence.size()]);
+            return static_cast<float>(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / events);
+        };
+
+        auto logString = [&logger](const Event& e) { logger->info(StreamToString(e)); };
+        auto logFormatter = [&logger](const Event& e) { logger->info("{0}", e); };
+
+        EventFormatBenchmarkResult result;
+        result.Events = events;
+        result.StringEnabled = measure(spdlog::level::trace, logString);
+        result.StringDisabled = measure(spdlog::level::warn, logString);
+        result.FormatterEnabled = measure(spdlog::level::trace, logFormatter);
+        result.FormatterDisabled = measure(spdlog::level::warn, logFormatter);
+        return result;
+    }
+
+    void EventFormatBenchmark::LogResult(const std::string& label, const EventFormatBenchmarkResult& result)
+    {
+        VEX_CORE_INFO("Event formatting '{0}': {1} events, ns per event", label, result.Events);
+        VEX_CORE_INFO("  std::string: {0:.1f} enabled, {1:.1f} disabled", result.StringEnabled, result.StringDisabled);
+        VEX_CORE_INFO("  formatter:   {0:.1f} enabled, {1:.1f} disabled", result.FormatterEnabled, result.FormatterDisabled);
+    }
+}
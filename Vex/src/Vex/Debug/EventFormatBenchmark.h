@@ -0,0 +1,47 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <string>
+
+namespace Vex
+{
+    /**
+     * Options for an event formatting benchmark.
+     */
+    struct EventFormatBenchmarkSpecification
+    {
+        uint32_t Events = 200000;       ///< Events logged per measurement.
+        uint32_t MotionPercent = 80;    ///< Share of mouse motion; the rest cycles key, button and resize events.
+    };
+
+    /**
+     * Cost per logged event, in nanoseconds, of the two ways of logging one.
+     */
+    struct EventFormatBenchmarkResult
+    {
+        uint32_t Events = 0;
+        float StringEnabled = 0.0f;         ///< Before: the message built with std::stringstream in ToString(), level enabled.
+        float StringDisabled = 0.0f;        ///< Before, level disabled: the string is still built.
+        float FormatterEnabled = 0.0f;      ///< After: the event passed to the logger and formatted into its buffer.
+        float FormatterDisabled = 0.0f;     ///< After, level disabled: nothing is formatted.
+    };
+
+    /**
+     * @class EventFormatBenchmark
+     * @brief Compares logging events through a std::string with logging them through their fmt formatter.
+     *
+     * The "before" path reproduces what Application::OnEvent did: build the description with a
+     * std::stringstream and pass the string to the logger. The "after" path passes the event itself, so
+     * fmt calls Event::FormatTo, and only if the level is enabled. Both log to a private logger with a
+     * null sink, so the numbers are the formatting and level check alone, without any output.
+     */
+    class VEX_API EventFormatBenchmark
+    {
+    public:
+        static EventFormatBenchmarkResult Run(const EventFormatBenchmarkSpecification& specification = EventFormatBenchmarkSpecification());
+
+        /** Writes a result to the core logger under the given label. */
+        static void LogResult(const std::string& label, const EventFormatBenchmarkResult& result);
+    };
+}
@@ -0,0 +1,144 @@
+﻿#include "VexPch.h"
+#include "EventPumpBenchmark.h"
+
+#include "Platform/Headless/HeadlessWindow.h"
+#include "Vex/Debug/Histogram.h"
+#include "Vex/Input/KeyCodes.h"
+#include "Vex/Log.h"
+
+#ifdef VEX_PLATFORM_WINDOWS
+    #include <SDL.h>
+#endif
+
+#include <chrono>
+
+namespace Vex
+{
+    /**
+     * Kind of the index-th synthetic event of a pump.
+     */
+    static EventType FloodEventType(uint32_t index, uint32_t motionPercent, uint32_t& keyCycle)
+    {
+        if (index % 100 < motionPercent)
+            return EventType::MouseMoved;
+
+        static constexpr EventType keyTypes[] = { EventType::KeyPressed, EventType::KeyReleased, EventType::KeyTyped };
+        return keyTypes[keyCycle++ % 3];
+    }
+
+    /**
+     * Queues one pump's worth of synthetic input. Returns how many events were queued.
+     */
+    static uint32_t Flood(Window& window, const EventPumpBenchmarkSpecification& specification, uint32_t pump)
+    {
+        auto* headless = dynamic_cast<HeadlessWindow*>(&window);
+
+        uint32_t queued = 0;
+        uint32_t keyCycle = 0;
+
+        for (uint32_t i = 0; i < specification.EventsPerPump; i++)
+        {
+            EventType type = FloodEventType(i, specification.MotionPercent, keyCycle);
+            if (!window.IsEventTypeEnabled(type))
+                continue;
+
+            float x = static_cast<float>(i % 1280);
+            float y = static_cast<float>(pump % 720);
+
+            if (headless)
+            {
+                switch (type)
+                {
+                case EventType::MouseMoved:  headless->InjectMouseMoved(x, y); break;
+                case EventType::KeyPressed:  headless->InjectKeyPressed(Key::A); break;
+                case EventType::KeyReleased: headless->InjectKeyReleased(Key::A); break;
+                default:                     headless->InjectKeyTyped(Key::A); break;
+                }
+
+                queued++;
+                continue;
+            }
+
+#ifdef VEX_PLATFORM_WINDOWS
+            SDL_Event event = {};
+            switch (type)
+            {
+            case EventType::MouseMoved:
+                event.type = SDL_MOUSEMOTION;
+                event.motion.x = static_cast<Sint32>(x);
+                event.motion.y = static_cast<Sint32>(y);
+                event.motion.xrel = 1;
+                break;
+
+            case EventType::KeyPressed:
+            case EventType::KeyReleased:
+                event.type = type == EventType::KeyPressed ? SDL_KEYDOWN : SDL_KEYUP;
+                event.key.keysym.sym = static_cast<SDL_Keycode>(Key::A);
+                event.key.keysym.scancode = static_cast<SDL_Scancode>(4);
+                break;
+
+            default:
+                event.type = SDL_TEXTINPUT;
+                event.text.text[0] = 'a';
+                break;
+            }
+
+            if (SDL_PushEvent(&event) == 1)
+                queued++;
+#endif
+        }
+
+        return queued;
+    }
+
+    EventPumpBenchmarkResult EventPumpBenchmark::Run(const WindowProps& props, const EventPumpBenchmarkSpecification& specification)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        std::unique_ptr<Window> window(Window::Create(props));
+
+        EventPumpBenchmarkResult result;
+        window->SetEventCallback([&result](Event&) { result.EventsDelivered++; });
+        window->SetEventCoalescing(specification.CoalesceMouseEvents);
+
+        for (EventType type : specification.DisabledEventTypes)
+            window->SetEventTypeEnabled(type, false);
+
+        // Unmeasured pump so the source filter is in effect and the OS queue starts out empty
+        window->OnUpdate();
+        result.EventsDelivered = 0;
+
+        Histogram pumpTimes;    // Nanoseconds
+        uint64_t maxPumpTime = 0;
+        uint64_t totalPumpTime = 0;
+
+        for (uint32_t pump = 0; pump < specification.Pumps; pump++)
+        {
+            result.EventsQueued += Flood(*window, specification, pump);
+
+            Clock::time_point start = Clock::now();
+            window->OnUpdate();
+            uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+
+            pumpTimes.Record(static_cast<uint32_t>(std::min<uint64_t>(elapsed, UINT32_MAX)));
+            maxPumpTime = std::max(maxPumpTime, elapsed);
+            totalPumpTime += elapsed;
+        }
+
+        constexpr float nsToUs = 0.001f;
+
+        result.Pumps = specification.Pumps;
+        result.PumpP50 = pumpTimes.GetPercentile(50.0) * nsToUs;
+        result.PumpP99 = pumpTimes.GetPercentile(99.0) * nsToUs;
+        result.PumpMax = maxPumpTime * nsToUs;
+        result.NanosecondsPerEvent = result.EventsQueued > 0 ? static_cast<float>(totalPumpTime) / result.EventsQueued : 0.0f;
+        return result;
+    }
+
+    void EventPumpBenchmark::LogResult(const std::string& label, const EventPumpBenchmarkResult& result)
+    {
+        VEX_CORE_INFO("Event pump '{0}': {1} pumps, {2} events queued, {3} delivered", label, result.Pumps, result.EventsQueued, result.EventsDelivered);
+        VEX_CORE_INFO("  pump us p50 {0:.1f} p99 {1:.1f} max {2:.1f} | {3:.1f} ns per event",
+            result.PumpP50, result.PumpP99, result.PumpMax, result.NanosecondsPerEvent);
+    }
+}
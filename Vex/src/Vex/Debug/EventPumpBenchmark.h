@@ -0,0 +1,55 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Vex/Events/Event.h"
+#include "Vex/Window.h"
+
+#include <string>
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * Options for an event pump benchmark.
+     */
+    struct EventPumpBenchmarkSpecification
+    {
+        uint32_t EventsPerPump = 1000;          ///< Synthetic events queued before every measured pump.
+        uint32_t Pumps = 200;                   ///< Measured pumps.
+        uint32_t MotionPercent = 80;            ///< Share of mouse motion in the flood; the rest alternates key presses, releases and text.
+        bool CoalesceMouseEvents = false;
+        std::vector<EventType> DisabledEventTypes = { EventType::KeyTyped };  ///< Types dropped at the source.
+    };
+
+    /**
+     * Result of an event pump benchmark.
+     */
+    struct EventPumpBenchmarkResult
+    {
+        uint32_t Pumps = 0;
+        uint64_t EventsQueued = 0;      ///< Synthetic events that made it into the OS-level queue.
+        uint64_t EventsDelivered = 0;   ///< Engine events that reached the callback.
+        float PumpP50 = 0.0f;           ///< Microseconds.
+        float PumpP99 = 0.0f;           ///< Microseconds.
+        float PumpMax = 0.0f;           ///< Microseconds.
+        float NanosecondsPerEvent = 0.0f;   ///< Total pump time over the events queued.
+    };
+
+    /**
+     * @class EventPumpBenchmark
+     * @brief Measures what one window pump costs under a synthetic flood of input.
+     *
+     * Creates its own window, queues EventsPerPump events before every pump (through SDL_PushEvent on
+     * the SDL backend, or injection on a headless window) and times OnUpdate alone. Events of types
+     * disabled at the source are not queued, just as SDL drops them when the OS reports them. Run it
+     * with different specifications to compare e.g. filtering or coalescing.
+     */
+    class VEX_API EventPumpBenchmark
+    {
+    public:
+        static EventPumpBenchmarkResult Run(const WindowProps& props, const EventPumpBenchmarkSpecification& specification = EventPumpBenchmarkSpecification());
+
+        /** Writes a result to the core logger under the given label. */
+        static void LogResult(const std::string& label, const EventPumpBenchmarkResult& result);
+    };
+}
@@ -0,0 +1,142 @@
+﻿#include "VexPch.h"
+#include "EventQueueBenchmark.h"
+
+#include "Vex/Debug/Histogram.h"
+#include "Vex/Events/ApplicationEvent.h"
+#include "Vex/Events/EventQueue.h"
+#include "Vex/Events/KeyEvent.h"
+#include "Vex/Events/MouseEvent.h"
+#include "Vex/Log.h"
+
+#include <chrono>
+
+namespace Vex
+{
+    namespace
+    {
+        /**
+         * Same interface as EventQueue, with every event allocated on its own.
+         */
+        class HeapEventQueue
+        {
+        public:
+            explicit HeapEventQueue(size_t reserve) { m_Events.reserve(reserve); }
+
+            template<typename T, typename... Args>
+            T& Push(Args&&... args)
+            {
+                m_Events.push_back(std::make_unique<T>(std::forward<Args>(args)...));
+                return static_cast<T&>(*m_Events.back());
+            }
+
+            template<typename F>
+            void Drain(F&& func)
+            {
+                for (size_t i = 0; i < m_Events.size(); i++)
+                    func(*m_Events[i]);
+
+                m_Events.clear();
+            }
+
+        private:
+            std::vector<std::unique_ptr<Event>> m_Events;
+        };
+    }
+
+    /**
+     * Pushes one frame's worth of events; the sequence depends only on the specification and frame.
+     */
+    template<typename Queue>
+    static void PushFrame(Queue& queue, const EventQueueBenchmarkSpecification& specification, uint32_t frame)
+    {
+        uint32_t cycle = 0;
+
+        for (uint32_t i = 0; i < specification.EventsPerFrame; i++)
+        {
+            if (i % 100 < specification.MotionPercent)
+            {
+                queue.template Push<MouseMovedEvent>(static_cast<float>(i % 1280), static_cast<float>(frame % 720), 1.0f, 0.0f);
+                continue;
+            }
+
+            switch (cycle++ % 5)
+            {
+            case 0:  queue.template Push<KeyPressedEvent>(Key::A); break;
+            case 1:  queue.template Push<KeyReleasedEvent>(Key::A); break;
+            case 2:  queue.template Push<MouseButtonPressedEvent>(Mouse::ButtonLeft); break;
+            case 3:  queue.template Push<MouseScrolledEvent>(0.0f, 1.0f); break;
+            default: queue.template Push<WindowResizeEvent>(1280u, 720u); break;
+            }
+        }
+    }
+
+    template<typename Queue>
+    static EventQueueBenchmarkTimings Measure(Queue& queue, const EventQueueBenchmarkSpecification& specification)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // The sink reads every event's type so neither variant can skip touching them
+        uint64_t drained = 0;
+        auto sink = [&drained](Event& e) { drained += e.GetEventType() != EventType::None; };
+
+        // Unmeasured frame so arena blocks and vector capacity are already in place
+        PushFrame(queue, specification, 0);
+        queue.Drain(sink);
+        drained = 0;
+
+        Histogram frameTimes;   // Nanoseconds
+        uint64_t maxFrameTime = 0;
+        uint64_t totalFrameTime = 0;
+
+        for (uint32_t frame = 1; frame <= specification.Frames; frame++)
+        {
+            Clock::time_point start = Clock::now();
+            PushFrame(queue, specification, frame);
+            queue.Drain(sink);
+            uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+
+            frameTimes.Record(static_cast<uint32_t>(std::min<uint64_t>(elapsed, UINT32_MAX)));
+            maxFrameTime = std::max(maxFrameTime, elapsed);
+            totalFrameTime += elapsed;
+        }
+
+        constexpr float nsToUs = 0.001f;
+        uint64_t events = static_cast<uint64_t>(specification.EventsPerFrame) * specification.Frames;
+
+        EventQueueBenchmarkTimings timings;
+        timings.FrameP50 = frameTimes.GetPercentile(50.0) * nsToUs;
+        timings.FrameP99 = frameTimes.GetPercentile(99.0) * nsToUs;
+        timings.FrameMax = maxFrameTime * nsToUs;
+        timings.NanosecondsPerEvent = events > 0 ? static_cast<float>(totalFrameTime) / events : 0.0f;
+        timings.EventsDrained = drained;
+        return timings;
+    }
+
+    EventQueueBenchmarkResult EventQueueBenchmark::Run(const EventQueueBenchmarkSpecification& specification)
+    {
+        EventQueueBenchmarkResult result;
+        result.Frames = specification.Frames;
+        result.Events = static_cast<uint64_t>(specification.EventsPerFrame) * specification.Frames;
+
+        {
+            EventQueue queue(64 * 1024, specification.EventsPerFrame);
+            result.Arena = Measure(queue, specification);
+        }
+
+        {
+            HeapEventQueue queue(specification.EventsPerFrame);
+            result.Heap = Measure(queue, specification);
+        }
+
+        return result;
+    }
+
+    void EventQueueBenchmark::LogResult(const std::string& label, const EventQueueBenchmarkResult& result)
+    {
+        VEX_CORE_INFO("Event queue '{0}': {1} frames, {2} events per variant", label, result.Frames, result.Events);
+        VEX_CORE_INFO("  arena: frame us p50 {0:.1f} p99 {1:.1f} max {2:.1f} | {3:.1f} ns per event, {4} drained",
+            result.Arena.FrameP50, result.Arena.FrameP99, result.Arena.FrameMax, result.Arena.NanosecondsPerEvent, result.Arena.EventsDrained);
+        VEX_CORE_INFO("  heap:  frame us p50 {0:.1f} p99 {1:.1f} max {2:.1f} | {3:.1f} ns per event, {4} drained",
+            result.Heap.FrameP50, result.Heap.FrameP99, result.Heap.FrameMax, result.Heap.NanosecondsPerEvent, result.Heap.EventsDrained);
+    }
+}
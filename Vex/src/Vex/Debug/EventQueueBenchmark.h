@@ -0,0 +1,59 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <string>
+
+namespace Vex
+{
+    /**
+     * Options for an event queue benchmark.
+     */
+    struct EventQueueBenchmarkSpecification
+    {
+        uint32_t EventsPerFrame = 1000;     ///< Events pushed and drained every measured frame.
+        uint32_t Frames = 200;              ///< Measured frames, after one unmeasured warm-up frame.
+        uint32_t MotionPercent = 80;        ///< Share of mouse motion; the rest cycles key, button, scroll and resize events.
+    };
+
+    /**
+     * Frame timings of one way of queueing events.
+     */
+    struct EventQueueBenchmarkTimings
+    {
+        float FrameP50 = 0.0f;              ///< Microseconds to push and drain one frame's events.
+        float FrameP99 = 0.0f;              ///< Microseconds.
+        float FrameMax = 0.0f;              ///< Microseconds.
+        float NanosecondsPerEvent = 0.0f;   ///< Total time over the events pushed.
+        uint64_t EventsDrained = 0;         ///< Should equal EventQueueBenchmarkResult::Events.
+    };
+
+    /**
+     * Result of an event queue benchmark.
+     */
+    struct EventQueueBenchmarkResult
+    {
+        uint32_t Frames = 0;
+        uint64_t Events = 0;                ///< Events pushed per variant over the measured frames.
+        EventQueueBenchmarkTimings Arena;   ///< EventQueue: events constructed in its linear arena.
+        EventQueueBenchmarkTimings Heap;    ///< One heap allocation per event, held by unique_ptr.
+    };
+
+    /**
+     * @class EventQueueBenchmark
+     * @brief Compares the arena-backed EventQueue with allocating every event on the heap.
+     *
+     * Each frame pushes EventsPerFrame events of mixed types, then drains them in order into a sink
+     * that reads their type, the way the application's frame loop does. The heap variant keeps the
+     * events in a vector of unique_ptr, which is what the window pump did before EventQueue. Both
+     * variants see the same sequence of events, so only the queue differs.
+     */
+    class VEX_API EventQueueBenchmark
+    {
+    public:
+        static EventQueueBenchmarkResult Run(const EventQueueBenchmarkSpecification& specification = EventQueueBenchmarkSpecification());
+
+        /** Writes a result to the core logger under the given label. */
+        static void LogResult(const std::string& label, const EventQueueBenchmarkResult& result);
+    };
+}
@@ -0,0 +1,126 @@
+﻿#include "VexPch.h"
+#include "EventRegistryBenchmark.h"
+
+#include "Vex/Events/ApplicationEvent.h"
+#include "Vex/Events/EventRegistry.h"
+#include "Vex/Events/KeyEvent.h"
+#include "Vex/Events/MouseEvent.h"
+#include "Vex/Log.h"
+
+#include <chrono>
+
+namespace Vex
+{
+    namespace
+    {
+        class BenchmarkSubscriberBase
+        {
+        public:
+            virtual ~BenchmarkSubscriberBase() = default;
+            virtual void OnEvent(Event& e) = 0;
+        };
+
+        class BenchmarkSubscriber : public BenchmarkSubscriberBase
+        {
+        public:
+            explicit BenchmarkSubscriber(uint64_t& calls)
+                : m_Calls(calls) {}
+
+            bool OnKeyPressed(KeyPressedEvent&) { m_Calls++; return false; }
+            bool OnKeyReleased(KeyReleasedEvent&) { m_Calls++; return false; }
+            bool OnMouseMoved(MouseMovedEvent&) { m_Calls++; return false; }
+            bool OnWindowResize(WindowResizeEvent&) { m_Calls++; return false; }
+
+            /** How a layer picked its handler before EventRegistry: one type check per handled type. */
+            void OnEvent(Event& e) override
+            {
+                EventDispatcher dispatcher(e);
+                dispatcher.Dispatch<KeyPressedEvent>([this](KeyPressedEvent& event) { return OnKeyPressed(event); });
+                dispatcher.Dispatch<KeyReleasedEvent>([this](KeyReleasedEvent& event) { return OnKeyReleased(event); });
+                dispatcher.Dispatch<MouseMovedEvent>([this](MouseMovedEvent& event) { return OnMouseMoved(event); });
+                dispatcher.Dispatch<WindowResizeEvent>([this](WindowResizeEvent& event) { return OnWindowResize(event); });
+            }
+
+        private:
+            uint64_t& m_Calls;
+        };
+    }
+
+    EventRegistryBenchmarkResult EventRegistryBenchmark::Run(const EventRegistryBenchmarkSpecification& specification)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        KeyPressedEvent keyPressed(Key::A);
+        KeyReleasedEvent keyReleased(Key::A);
+        MouseMovedEvent mouseMoved(640.0f, 360.0f, 1.0f, 0.0f);
+        WindowResizeEvent windowResize(1280, 720);
+        Event* others[] = { &keyPressed, &keyReleased, &windowResize };
+
+        // One pass worth of events, repeated until Events have been dispatched
+        std::vector<Event*> sequence;
+        for (uint32_t i = 0; i < 100; i++)
+            sequence.push_back(i < specification.MotionPercent ? static_cast<Event*>(&mouseMoved) : others[i % 3]);
+
+        auto nanosecondsPerEvent = [&specification](Clock::time_point start)
+        {
+            return static_cast<float>(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / std::max(specification.Events, 1u));
+        };
+
+        EventRegistryBenchmarkResult result;
+        for (uint32_t subscriberCount : specification.SubscriberCounts)
+        {
+            EventRegistryBenchmarkSample sample;
+            sample.Subscribers = subscriberCount;
+
+            std::vector<std::unique_ptr<BenchmarkSubscriber>> registrySubscribers;
+            std::vector<std::unique_ptr<BenchmarkSubscriberBase>> dispatcherSubscribers;
+            EventRegistry registry;
+
+            for (uint32_t i = 0; i < subscriberCount; i++)
+            {
+                BenchmarkSubscriber* subscriber = registrySubscribers.emplace_back(std::make_unique<BenchmarkSubscriber>(sample.RegistryCalls)).get();
+                registry.Subscribe<KeyPressedEvent, &BenchmarkSubscriber::OnKeyPressed>(subscriber);
+                registry.Subscribe<KeyReleasedEvent, &BenchmarkSubscriber::OnKeyReleased>(subscriber);
+                registry.Subscribe<MouseMovedEvent, &BenchmarkSubscriber::OnMouseMoved>(subscriber);
+                registry.Subscribe<WindowResizeEvent, &BenchmarkSubscriber::OnWindowResize>(subscriber);
+
+                dispatcherSubscribers.push_back(std::make_unique<BenchmarkSubscriber>(sample.DispatcherCalls));
+            }
+
+            Clock::time_point start = Clock::now();
+            for (uint32_t i = 0; i < specification.Events; i++)
+                registry.Dispatch(*sequence[i % sequence.size()]);
+            sample.RegistryNanoseconds = nanosecondsPerEvent(start);
+
+            start = Clock::now();
+            for (uint32_t i = 0; i < specification.Events; i++)
+            {
+                Event& e = *sequence[i % sequence.size()];
+                for (const std::unique_ptr<BenchmarkSubscriberBase>& subscriber : dispatcherSubscribers)
+                {
+                    if (e.Handled)
+                        break;
+                    subscriber->OnEvent(e);
+                }
+            }
+            sample.DispatcherNanoseconds = nanosecondsPerEvent(start);
+
+            if (sample.RegistryCalls != sample.DispatcherCalls)
+                VEX_CORE_ERROR("Event registry benchmark: {0} registry calls but {1} dispatcher calls", sample.RegistryCalls, sample.DispatcherCalls);
+
+            result.Samples.push_back(sample);
+        }
+
+        return result;
+    }
+
+    void EventRegistryBenchmark::LogResult(const std::string& label, const EventRegistryBenchmarkResult& result)
+    {
+        VEX_CORE_INFO("Event dispatch '{0}':", label);
+        for (const EventRegistryBenchmarkSample& sample : result.Samples)
+        {
+            VEX_CORE_INFO("  {0} subscribers: registry {1:.1f} ns/event, dispatcher chain {2:.1f} ns/event",
+                sample.Subscribers, sample.RegistryNanoseconds, sample.DispatcherNanoseconds);
+        }
+    }
+}
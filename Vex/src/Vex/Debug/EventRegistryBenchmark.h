@@ -0,0 +1,57 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <string>
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * Options for an event dispatch benchmark.
+     */
+    struct EventRegistryBenchmarkSpecification
+    {
+        std::vector<uint32_t> SubscriberCounts = { 1, 8, 64 };
+        uint32_t Events = 1000000;      ///< Events dispatched per subscriber count.
+        uint32_t MotionPercent = 80;    ///< Share of mouse motion; the rest cycles key presses, releases and resizes.
+    };
+
+    /**
+     * Dispatch cost at one subscriber count.
+     */
+    struct EventRegistryBenchmarkSample
+    {
+        uint32_t Subscribers = 0;
+        float RegistryNanoseconds = 0.0f;       ///< Per event, through EventRegistry::Dispatch.
+        float DispatcherNanoseconds = 0.0f;     ///< Per event, through each subscriber's EventDispatcher chain.
+        uint64_t RegistryCalls = 0;             ///< Handler calls; both paths must make the same number.
+        uint64_t DispatcherCalls = 0;
+    };
+
+    /**
+     * Result of an event dispatch benchmark.
+     */
+    struct EventRegistryBenchmarkResult
+    {
+        std::vector<EventRegistryBenchmarkSample> Samples;
+    };
+
+    /**
+     * @class EventRegistryBenchmark
+     * @brief Measures the cost per event of dispatching to 1, 8, 64, ... subscribers.
+     *
+     * Every subscriber handles four event types (key pressed and released, mouse moved, window resize)
+     * and lets the event through, so no dispatch stops early. The registry path subscribes each handler
+     * as a member function; the dispatcher path calls a virtual OnEvent per subscriber that tries the four
+     * types with EventDispatcher, as layers did before EventRegistry.
+     */
+    class VEX_API EventRegistryBenchmark
+    {
+    public:
+        static EventRegistryBenchmarkResult Run(const EventRegistryBenchmarkSpecification& specification = EventRegistryBenchmarkSpecification());
+
+        /** Writes a result to the core logger under the given label. */
+        static void LogResult(const std::string& label, const EventRegistryBenchmarkResult& result);
+    };
+}
@@ -0,0 +1,137 @@
+﻿#include "VexPch.h"
+#include "FrameStats.h"
+
+#include "Vex/Log.h"
+
+#ifdef VEX_PLATFORM_LINUX
+    #include <ctime>
+#endif
+
+namespace Vex
+{
+    /**
+     * User plus kernel time consumed by every thread of the process so far, in seconds.
+     */
+    static double ProcessCpuSeconds()
+    {
+#if defined(VEX_PLATFORM_WINDOWS)
+        FILETIME creation, exit, kernel, user;
+        if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+            return 0.0;
+
+        // FILETIME counts 100 ns ticks
+        auto toSeconds = [](const FILETIME& time)
+        {
+            return static_cast<double>((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) * 1.0e-7;
+        };
+        return toSeconds(kernel) + toSeconds(user);
+#elif defined(VEX_PLATFORM_LINUX)
+        timespec time;
+        if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0)
+            return 0.0;
+
+        return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) * 1.0e-9;
+#else
+        return 0.0;
+#endif
+    }
+
+    FrameStats::FrameStats(uint32_t windowSize)
+        : m_FrameTime(windowSize), m_PumpTime(windowSize), m_DispatchTime(windowSize)
+    {
+    }
+
+    FrameStats::~FrameStats()
+    {
+        if (m_CsvFile)
+            std::fclose(m_CsvFile);
+    }
+
+    void FrameStats::RecordFrame(uint32_t frameUs, uint32_t pumpUs, uint32_t dispatchUs)
+    {
+        m_FrameTime.Record(frameUs);
+        m_PumpTime.Record(pumpUs);
+        m_DispatchTime.Record(dispatchUs);
+        m_FrameCount++;
+
+        if (m_ReportInterval == std::chrono::steady_clock::duration::zero())
+            return;
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now >= m_NextReport)
+        {
+            double cpuSeconds = ProcessCpuSeconds();
+            double wallSeconds = std::chrono::duration<double>(now - m_LastReport).count();
+            m_CpuPercent = wallSeconds > 0.0 ? static_cast<float>((cpuSeconds - m_LastReportCpuSeconds) / wallSeconds * 100.0) : 0.0f;
+            m_LastReport = now;
+            m_LastReportCpuSeconds = cpuSeconds;
+
+            Report();
+            m_NextReport = now + m_ReportInterval;
+        }
+    }
+
+    bool FrameStats::SetReporting(double intervalSeconds, const std::string& csvPath)
+    {
+        if (m_CsvFile)
+        {
+            std::fclose(m_CsvFile);
+            m_CsvFile = nullptr;
+        }
+
+        m_ReportInterval = intervalSeconds > 0.0
+            ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(intervalSeconds))
+            : std::chrono::steady_clock::duration::zero();
+        m_LastReport = std::chrono::steady_clock::now();
+        m_LastReportCpuSeconds = ProcessCpuSeconds();
+        m_NextReport = m_LastReport + m_ReportInterval;
+
+        if (csvPath.empty())
+            return true;
+
+        m_CsvFile = std::fopen(csvPath.c_str(), "w");
+        if (!m_CsvFile)
+        {
+            VEX_CORE_ERROR("Failed to open frame stats file '{0}'", csvPath);
+            return false;
+        }
+
+        std::fputs("frame,frame_p50_ms,frame_p95_ms,frame_p99_ms,frame_max_ms,"
+            "pump_p50_ms,pump_p95_ms,pump_p99_ms,pump_max_ms,"
+            "dispatch_p50_ms,dispatch_p95_ms,dispatch_p99_ms,dispatch_max_ms,cpu_percent\n", m_CsvFile);
+        return true;
+    }
+
+    FrameTimingSummary FrameStats::Summarize(const RollingHistogram& histogram)
+    {
+        constexpr float usToMs = 0.001f;
+
+        FrameTimingSummary summary;
+        summary.P50 = histogram.GetPercentile(50.0) * usToMs;
+        summary.P95 = histogram.GetPercentile(95.0) * usToMs;
+        summary.P99 = histogram.GetPercentile(99.0) * usToMs;
+        summary.Max = histogram.GetMax() * usToMs;
+        return summary;
+    }
+
+    void FrameStats::Report()
+    {
+        FrameTimingSummary frame = GetFrameTime();
+        FrameTimingSummary pump = GetPumpTime();
+        FrameTimingSummary dispatch = GetDispatchTime();
+
+        if (m_CsvFile)
+        {
+            std::fprintf(m_CsvFile, "%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.1f\n",
+                static_cast<unsigned long long>(m_FrameCount),
+                frame.P50, frame.P95, frame.P99, frame.Max,
+                pump.P50, pump.P95, pump.P99, pump.Max,
+                dispatch.P50, dispatch.P95, dispatch.P99, dispatch.Max, m_CpuPercent);
+            std::fflush(m_CsvFile);
+            return;
+        }
+
+        VEX_CORE_INFO("Frame ms p50 {0:.2f} p95 {1:.2f} p99 {2:.2f} max {3:.2f} | pump p99 {4:.3f} max {5:.3f} | dispatch p99 {6:.3f} max {7:.3f} | CPU {8:.1f}%",
+            frame.P50, frame.P95, frame.P99, frame.Max, pump.P99, pump.Max, dispatch.P99, dispatch.Max, m_CpuPercent);
+    }
+}
@@ -0,0 +1,90 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Vex/Debug/Histogram.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace Vex
+{
+    /**
+     * Percentiles of one frame phase over the rolling window, in milliseconds.
+     */
+    struct FrameTimingSummary
+    {
+        float P50 = 0.0f;
+        float P95 = 0.0f;
+        float P99 = 0.0f;
+        float Max = 0.0f;
+    };
+
+    /**
+     * @class FrameStats
+     * @brief Rolling frame-time statistics for the Application frame loop.
+     *
+     * Every frame records its total duration, the time spent pumping the window and the time spent
+     * dispatching events into fixed-memory histograms, so tail latencies (stutters) are visible rather
+     * than averaged away. Recording never allocates and costs a few bit operations per phase, so the
+     * stats can stay on in shipping builds. Optionally the summary is dumped at a fixed interval to the
+     * core logger or appended to a CSV file, together with the CPU time the process used over the
+     * interval, so the cost of idling between paced frames shows up next to the frame times.
+     */
+    class VEX_API FrameStats
+    {
+    public:
+        /**
+         * @param windowSize Number of most recent frames the percentiles cover.
+         */
+        explicit FrameStats(uint32_t windowSize = 1024);
+        ~FrameStats();
+
+        FrameStats(const FrameStats&) = delete;
+        FrameStats& operator=(const FrameStats&) = delete;
+
+        /**
+         * @brief Records one frame and emits a report if the report interval has elapsed.
+         * @param frameUs Total frame duration in microseconds.
+         * @param pumpUs Time spent pumping the window in microseconds.
+         * @param dispatchUs Time spent dispatching events in microseconds.
+         */
+        void RecordFrame(uint32_t frameUs, uint32_t pumpUs, uint32_t dispatchUs);
+
+        /**
+         * @brief Enables periodic reports.
+         * @param intervalSeconds Seconds between reports; 0 disables them.
+         * @param csvPath File to append CSV rows to; empty reports to the core logger instead.
+         * @return False if the CSV file could not be opened.
+         */
+        bool SetReporting(double intervalSeconds, const std::string& csvPath = std::string());
+
+        FrameTimingSummary GetFrameTime() const { return Summarize(m_FrameTime); }
+        FrameTimingSummary GetPumpTime() const { return Summarize(m_PumpTime); }
+        FrameTimingSummary GetDispatchTime() const { return Summarize(m_DispatchTime); }
+
+        /** @return Number of frames recorded since creation. */
+        uint64_t GetFrameCount() const { return m_FrameCount; }
+
+        /** @return CPU time used by all of the process's threads over the last report interval, in percent of one core. */
+        float GetCpuPercent() const { return m_CpuPercent; }
+
+    private:
+        static FrameTimingSummary Summarize(const RollingHistogram& histogram);
+
+        /** Writes the current summaries to the log or the CSV file. */
+        void Report();
+
+        RollingHistogram m_FrameTime;
+        RollingHistogram m_PumpTime;
+        RollingHistogram m_DispatchTime;
+        uint64_t m_FrameCount = 0;
+
+        std::chrono::steady_clock::duration m_ReportInterval = std::chrono::steady_clock::duration::zero();
+        std::chrono::steady_clock::time_point m_NextReport;
+        std::chrono::steady_clock::time_point m_LastReport;     ///< Wall time the CPU usage is measured from.
+        double m_LastReportCpuSeconds = 0.0;                    ///< Process CPU time at m_LastReport.
+        float m_CpuPercent = 0.0f;
+        std::FILE* m_CsvFile = nullptr;
+    };
+}
@@ -0,0 +1,90 @@
+﻿#include "VexPch.h"
+#include "Histogram.h"
+
+#include <bit>
+#include <cmath>
+
+namespace Vex
+{
+    Histogram::Histogram()
+        : m_Counts(BucketCount, 0)
+    {
+    }
+
+    void Histogram::Reset()
+    {
+        std::fill(m_Counts.begin(), m_Counts.end(), 0);
+        m_TotalCount = 0;
+    }
+
+    uint32_t Histogram::GetBucketIndex(uint32_t value)
+    {
+        if (value < SubBucketCount)
+            return value;
+
+        // Keep the top SubBucketBits bits of the value; the shift selects the power-of-two range
+        uint32_t shift = static_cast<uint32_t>(std::bit_width(value)) - SubBucketBits;
+        return shift * (SubBucketCount / 2) + (value >> shift);
+    }
+
+    uint32_t Histogram::GetBucketUpperBound(uint32_t index)
+    {
+        if (index < SubBucketCount)
+            return index;
+
+        uint32_t shift = index / (SubBucketCount / 2) - 1;
+        uint64_t subBucket = index - shift * (SubBucketCount / 2);
+        return static_cast<uint32_t>(((subBucket + 1) << shift) - 1);
+    }
+
+    uint32_t Histogram::GetPercentile(double percentile) const
+    {
+        if (m_TotalCount == 0)
+            return 0;
+
+        percentile = std::clamp(percentile, 0.0, 100.0);
+        uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_TotalCount))));
+
+        uint64_t cumulative = 0;
+        for (uint32_t i = 0; i < BucketCount; i++)
+        {
+            cumulative += m_Counts[i];
+            if (cumulative >= target)
+                return GetBucketUpperBound(i);
+        }
+
+        return GetBucketUpperBound(BucketCount - 1);
+    }
+
+    RollingHistogram::RollingHistogram(uint32_t windowSize)
+        : m_Samples(std::max(windowSize, 1u), 0)
+    {
+    }
+
+    void RollingHistogram::Record(uint32_t value)
+    {
+        if (m_Count == m_Samples.size())
+            m_Histogram.Remove(m_Samples[m_Next]);
+        else
+            m_Count++;
+
+        m_Samples[m_Next] = value;
+        m_Histogram.Record(value);
+        m_Next = (m_Next + 1) % static_cast<uint32_t>(m_Samples.size());
+    }
+
+    void RollingHistogram::Reset()
+    {
+        m_Histogram.Reset();
+        m_Next = 0;
+        m_Count = 0;
+    }
+
+    uint32_t RollingHistogram::GetMax() const
+    {
+        uint32_t max = 0;
+        for (uint32_t i = 0; i < m_Count; i++)
+            max = std::max(max, m_Samples[i]);
+        return max;
+    }
+}
@@ -0,0 +1,95 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * @class Histogram
+     * @brief Fixed-memory log-linear histogram of integer samples, in the style of HdrHistogram.
+     *
+     * Values below SubBucketCount get a bucket each; above that every power of two is split into
+     * SubBucketCount / 2 buckets, so any recorded value is reported within about 3% of its true value.
+     * Values are unsigned 32-bit integers (e.g. microseconds, covering over an hour). Recording is a
+     * couple of bit operations and an increment; nothing allocates after construction.
+     */
+    class VEX_API Histogram
+    {
+    public:
+        static constexpr uint32_t SubBucketBits = 6;
+        static constexpr uint32_t SubBucketCount = 1u << SubBucketBits;
+        static constexpr uint32_t BucketCount = (32 - SubBucketBits + 1) * (SubBucketCount / 2) + SubBucketCount / 2;
+
+        Histogram();
+
+        /** @brief Adds one sample. */
+        void Record(uint32_t value) { m_Counts[GetBucketIndex(value)]++; m_TotalCount++; }
+
+        /** @brief Removes one sample previously added with the same value. */
+        void Remove(uint32_t value) { m_Counts[GetBucketIndex(value)]--; m_TotalCount--; }
+
+        /** @brief Clears every bucket. */
+        void Reset();
+
+        /**
+         * @brief Returns the value at or below which the given percentage of samples fall.
+         * @param percentile Percentage in [0, 100].
+         * @return The highest value equivalent to the matching bucket, or 0 if the histogram is empty.
+         */
+        uint32_t GetPercentile(double percentile) const;
+
+        /** @return Number of samples currently recorded. */
+        uint64_t GetCount() const { return m_TotalCount; }
+
+        /** @return Index of the bucket a value falls into. */
+        static uint32_t GetBucketIndex(uint32_t value);
+
+        /** @return Highest value that falls into the given bucket. */
+        static uint32_t GetBucketUpperBound(uint32_t index);
+
+    private:
+        std::vector<uint32_t> m_Counts;
+        uint64_t m_TotalCount = 0;
+    };
+
+    /**
+     * @class RollingHistogram
+     * @brief Histogram over the most recent WindowSize samples.
+     *
+     * Keeps the raw samples in a ring so the oldest one can be removed from the histogram when a new
+     * one arrives, and so the window maximum is exact rather than bucketed.
+     */
+    class VEX_API RollingHistogram
+    {
+    public:
+        /**
+         * @brief Allocates the histogram and the sample ring.
+         * @param windowSize Number of most recent samples the statistics cover.
+         */
+        explicit RollingHistogram(uint32_t windowSize = 1024);
+
+        /** @brief Adds a sample, evicting the oldest one once the window is full. */
+        void Record(uint32_t value);
+
+        /** @brief Discards every sample. */
+        void Reset();
+
+        /** @see Histogram::GetPercentile */
+        uint32_t GetPercentile(double percentile) const { return m_Histogram.GetPercentile(percentile); }
+
+        /** @return Largest sample in the window, exact. */
+        uint32_t GetMax() const;
+
+        /** @return Number of samples in the window. */
+        uint32_t GetCount() const { return m_Count; }
+
+    private:
+        Histogram m_Histogram;
+        std::vector<uint32_t> m_Samples;
+        uint32_t m_Next = 0;    ///< Ring slot the next sample is written to.
+        uint32_t m_Count = 0;
+    };
+}
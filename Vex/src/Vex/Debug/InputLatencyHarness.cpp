@@ -0,0 +1,158 @@
+﻿#include "VexPch.h"
+#include "InputLatencyHarness.h"
+
+#include "Platform/Headless/HeadlessWindow.h"
+#include "Vex/Application.h"
+#include "Vex/Events/KeyEvent.h"
+#include "Vex/Input/Input.h"
+#include "Vex/Log.h"
+#include "Vex/Window.h"
+
+#ifdef VEX_PLATFORM_WINDOWS
+    #include <SDL.h>
+#endif
+
+#include <chrono>
+
+namespace Vex
+{
+    static uint32_t ClampToU32(uint64_t value)
+    {
+        return static_cast<uint32_t>(std::min<uint64_t>(value, UINT32_MAX));
+    }
+
+    static LatencyStageSummary Summarize(const Histogram& histogram, uint32_t max)
+    {
+        constexpr float nsToUs = 0.001f;
+
+        LatencyStageSummary summary;
+        summary.P50 = histogram.GetPercentile(50.0) * nsToUs;
+        summary.P95 = histogram.GetPercentile(95.0) * nsToUs;
+        summary.P99 = histogram.GetPercentile(99.0) * nsToUs;
+        summary.Max = max * nsToUs;
+        return summary;
+    }
+
+    InputLatencyHarness::InputLatencyHarness(Application& application, const InputLatencySpecification& specification)
+        : Layer("InputLatencyHarness"), m_Application(application), m_Specification(specification)
+    {
+    }
+
+    InputLatencyHarness::~InputLatencyHarness()
+    {
+        OnDetach();
+    }
+
+    void InputLatencyHarness::OnAttach()
+    {
+        m_StopInjector.store(false, std::memory_order_relaxed);
+        m_Injector = std::thread([this]() { InjectorLoop(); });
+
+        VEX_CORE_INFO("Input latency harness injecting {0} presses at {1} Hz", m_Specification.SampleCount, m_Specification.InjectionRate);
+    }
+
+    void InputLatencyHarness::OnDetach()
+    {
+        m_StopInjector.store(true, std::memory_order_relaxed);
+        if (m_Injector.joinable())
+            m_Injector.join();
+    }
+
+    void InputLatencyHarness::InjectorLoop()
+    {
+        using Clock = std::chrono::steady_clock;
+
+        Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / std::max(m_Specification.InjectionRate, 1.0)));
+        Clock::time_point next = Clock::now();
+
+        for (uint32_t i = 0; i < m_Specification.SampleCount && !m_StopInjector.load(std::memory_order_relaxed); i++)
+        {
+            // Schedule against absolute times so the rate does not drift with sleep overshoot
+            next += period;
+            std::this_thread::sleep_until(next);
+
+            InjectProbe();
+        }
+    }
+
+    void InputLatencyHarness::InjectProbe()
+    {
+        Window& window = m_Application.GetWindow();
+
+        if (auto* headless = dynamic_cast<HeadlessWindow*>(&window))
+        {
+            headless->InjectKeyPressed(m_Specification.ProbeKey);
+            return;
+        }
+
+#ifdef VEX_PLATFORM_WINDOWS
+        // SDL_PushEvent is thread-safe and stamps the event with the current tick count
+        SDL_Event event = {};
+        event.type = SDL_KEYDOWN;
+        event.key.keysym.sym = static_cast<SDL_Keycode>(m_Specification.ProbeKey);
+        event.key.keysym.scancode = static_cast<SDL_Scancode>(Input::GetScancode(m_Specification.ProbeKey));
+        SDL_PushEvent(&event);
+#endif
+    }
+
+    void InputLatencyHarness::OnEvent(Event& e)
+    {
+        if (e.GetEventType() != EventType::KeyPressed)
+            return;
+
+        auto& key = static_cast<KeyPressedEvent&>(e);
+        if (key.GetKeyCode() != m_Specification.ProbeKey || e.Timestamp == 0)
+            return;
+
+        uint64_t now = Event::Now();
+        uint64_t pump = std::max(m_Application.GetPumpTimestamp(), e.Timestamp);
+
+        uint32_t inputToPump = ClampToU32(pump - e.Timestamp);
+        uint32_t pumpToHandler = ClampToU32(now - pump);
+        uint32_t total = ClampToU32(now - e.Timestamp);
+
+        m_InputToPump.Record(inputToPump);
+        m_PumpToHandler.Record(pumpToHandler);
+        m_Total.Record(total);
+        m_MaxInputToPump = std::max(m_MaxInputToPump, inputToPump);
+        m_MaxPumpToHandler = std::max(m_MaxPumpToHandler, pumpToHandler);
+        m_MaxTotal = std::max(m_MaxTotal, total);
+
+        // Probe presses are synthetic; keep them away from the application
+        e.Handled = true;
+
+        if (++m_Received == m_Specification.SampleCount && m_Specification.CloseWhenDone)
+        {
+            LogReport();
+            m_Application.Close();
+        }
+    }
+
+    InputLatencyReport InputLatencyHarness::GetReport() const
+    {
+        InputLatencyReport report;
+        report.Samples = m_Received;
+        report.InputToPump = Summarize(m_InputToPump, m_MaxInputToPump);
+        report.PumpToHandler = Summarize(m_PumpToHandler, m_MaxPumpToHandler);
+        report.Total = Summarize(m_Total, m_MaxTotal);
+        return report;
+    }
+
+    void InputLatencyHarness::LogReport() const
+    {
+        InputLatencyReport report = GetReport();
+
+        VEX_CORE_INFO("Input latency: {0} samples at {1} Hz (microseconds)", report.Samples, m_Specification.InjectionRate);
+        VEX_CORE_INFO("  {0:<16} {1:>10} {2:>10} {3:>10} {4:>10}", "stage", "p50", "p95", "p99", "max");
+
+        auto logStage = [](const char* name, const LatencyStageSummary& stage)
+        {
+            VEX_CORE_INFO("  {0:<16} {1:>10.1f} {2:>10.1f} {3:>10.1f} {4:>10.1f}", name, stage.P50, stage.P95, stage.P99, stage.Max);
+        };
+
+        logStage("input -> pump", report.InputToPump);
+        logStage("pump -> handler", report.PumpToHandler);
+        logStage("total", report.Total);
+    }
+}
@@ -0,0 +1,102 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Vex/Debug/Histogram.h"
+#include "Vex/Input/KeyCodes.h"
+#include "Vex/Layer.h"
+
+#include <atomic>
+#include <thread>
+
+namespace Vex
+{
+    class Application;
+
+    /**
+     * Options for an input latency run.
+     */
+    struct InputLatencySpecification
+    {
+        double InjectionRate = 1000.0;  ///< Synthetic key presses per second.
+        uint32_t SampleCount = 10000;   ///< Presses to inject and measure.
+        KeyCode ProbeKey = Key::F12;    ///< Key the synthetic presses use; those events are consumed by the harness.
+        bool CloseWhenDone = true;      ///< Report and close the application once every sample has arrived.
+    };
+
+    /**
+     * Latency percentiles of one stage, in microseconds.
+     */
+    struct LatencyStageSummary
+    {
+        float P50 = 0.0f;
+        float P95 = 0.0f;
+        float P99 = 0.0f;
+        float Max = 0.0f;
+    };
+
+    /**
+     * Result of an input latency run.
+     */
+    struct InputLatencyReport
+    {
+        uint32_t Samples = 0;
+        LatencyStageSummary InputToPump;        ///< From the input's timestamp until the pump that collected it started.
+        LatencyStageSummary PumpToHandler;      ///< From the start of that pump until the event reached the harness.
+        LatencyStageSummary Total;              ///< From the input's timestamp until the event reached the harness.
+    };
+
+    /**
+     * @class InputLatencyHarness
+     * @brief Overlay that measures end-to-end input latency through the real frame loop.
+     *
+     * A background thread injects key presses at a fixed rate, through SDL_PushEvent on the SDL backend
+     * or straight into a HeadlessWindow, so input arrives at arbitrary points of the frame just like a
+     * real device. Every probe event is timed when it reaches the harness in the event dispatch, using
+     * the timestamp the window stamped on it, and the results are split into waiting for the next pump
+     * and pump-plus-dispatch.
+     *
+     * Usage, typically in a headless application so it runs anywhere:
+     * - `PushOverlay(new InputLatencyHarness(*this, spec));`
+     * - Run the application; the report is logged when all samples have arrived.
+     */
+    class VEX_API InputLatencyHarness : public Layer
+    {
+    public:
+        InputLatencyHarness(Application& application, const InputLatencySpecification& specification = InputLatencySpecification());
+        ~InputLatencyHarness();
+
+        /** Starts the injector thread. */
+        void OnAttach() override;
+
+        /** Stops the injector thread. */
+        void OnDetach() override;
+
+        /** Times and consumes probe events. */
+        void OnEvent(Event& e) override;
+
+        /** @return True once every injected sample has been measured. */
+        bool IsFinished() const { return m_Received >= m_Specification.SampleCount; }
+
+        /** @return Percentiles over the samples measured so far. */
+        InputLatencyReport GetReport() const;
+
+        /** Writes the report to the core logger. */
+        void LogReport() const;
+
+    private:
+        void InjectorLoop();
+        void InjectProbe();
+
+        Application& m_Application;
+        InputLatencySpecification m_Specification;
+
+        std::thread m_Injector;
+        std::atomic<bool> m_StopInjector{ false };
+
+        uint32_t m_Received = 0;
+        Histogram m_InputToPump;    ///< Nanoseconds.
+        Histogram m_PumpToHandler;  ///< Nanoseconds.
+        Histogram m_Total;          ///< Nanoseconds.
+        uint32_t m_MaxInputToPump = 0, m_MaxPumpToHandler = 0, m_MaxTotal = 0;
+    };
+}
@@ -0,0 +1,219 @@
+#include "VexPch.h"
+#include "Instrumentor.h"
+
+#include "Vex/Log.h"
+#include "spdlog/fmt/fmt.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+
+namespace Vex
+{
+    /**
+     * Fixed block of records. Chunks form a singly linked list per thread and are reused across sessions.
+     */
+    struct ProfileChunk
+    {
+        static constexpr uint32_t Capacity = 4096;
+
+        ProfileRecord Records[Capacity];
+        std::atomic<uint32_t> Count{ 0 };           ///< Published records; written by the owning thread only.
+        std::atomic<ProfileChunk*> Next{ nullptr };
+    };
+
+    /**
+     * Records of one thread. Buffers are never freed so records of threads that already exited still
+     * make it into the trace.
+     */
+    struct ThreadProfileBuffer
+    {
+        uint32_t ThreadId = 0;
+        std::atomic<uint64_t> Session{ 0 };     ///< Session the records belong to; published after the reset.
+        ProfileChunk Head;
+        ProfileChunk* Current = &Head;
+
+        /** Discards the records of an old session. Only called by the owning thread. */
+        void Reset(uint64_t session)
+        {
+            for (ProfileChunk* chunk = &Head; chunk; chunk = chunk->Next.load(std::memory_order_relaxed))
+                chunk->Count.store(0, std::memory_order_relaxed);
+
+            Current = &Head;
+            Session.store(session, std::memory_order_release);
+        }
+    };
+
+    std::atomic<bool> Instrumentor::s_Active{ false };
+
+    static std::mutex s_BuffersMutex;
+    static std::vector<ThreadProfileBuffer*> s_Buffers;
+    static std::atomic<uint64_t> s_SessionId{ 0 };
+    static uint64_t s_SessionStartTicks = 0;
+    static uint64_t s_SessionStartNs = 0;
+    static std::string s_SessionName;
+    static std::string s_SessionPath;
+
+    // Vex is loaded with the executable, so the static TLS model applies and skips __tls_get_addr in the shared library
+#if defined(__GNUC__)
+    static thread_local ThreadProfileBuffer* t_Buffer __attribute__((tls_model("initial-exec"))) = nullptr;
+#else
+    static thread_local ThreadProfileBuffer* t_Buffer = nullptr;
+#endif
+
+    static ThreadProfileBuffer* RegisterThread()
+    {
+        auto* buffer = new ThreadProfileBuffer();
+
+        std::lock_guard<std::mutex> lock(s_BuffersMutex);
+        buffer->ThreadId = static_cast<uint32_t>(s_Buffers.size());
+        s_Buffers.push_back(buffer);
+
+        t_Buffer = buffer;
+        return buffer;
+    }
+
+    static void AppendEscaped(fmt::memory_buffer& out, const char* text)
+    {
+        for (const char* c = text; *c; c++)
+        {
+            if (*c == '"' || *c == '\\')
+                out.push_back('\\');
+            out.push_back(*c);
+        }
+    }
+
+    void Instrumentor::BeginSession(const std::string& name, const std::string& filepath)
+    {
+        if (filepath.empty())
+            return;
+
+        if (IsActive())
+        {
+            VEX_CORE_WARN("Profiler session '{0}' started while '{1}' was still open", name, s_SessionName);
+            EndSession();
+        }
+
+        s_SessionName = name;
+        s_SessionPath = filepath;
+        s_SessionStartNs = SteadyNanoseconds();
+        s_SessionStartTicks = Now();
+        // Release so threads that pick up the new id also see the previous session's trace fully written
+        s_SessionId.fetch_add(1, std::memory_order_release);
+        s_Active.store(true, std::memory_order_release);
+    }
+
+    std::string Instrumentor::GetSessionPath(const std::string& name)
+    {
+        const char* directory = std::getenv("VEX_PROFILE_DIR");
+        if (!directory || !*directory)
+            return std::string();
+
+        return (std::filesystem::path(directory) / ("VexProfile-" + name + ".json")).string();
+    }
+
+    void Instrumentor::EndSession()
+    {
+        if (!IsActive())
+            return;
+
+        s_Active.store(false, std::memory_order_release);
+
+        // Derive the tick rate from how far both clocks advanced over the session
+        uint64_t elapsedTicks = Now() - s_SessionStartTicks;
+        uint64_t elapsedNs = SteadyNanoseconds() - s_SessionStartNs;
+        double ticksPerMicrosecond = elapsedNs > 0 ? elapsedTicks * 1000.0 / elapsedNs : 1000.0;
+
+        std::FILE* file = std::fopen(s_SessionPath.c_str(), "wb");
+        if (!file)
+        {
+            VEX_CORE_ERROR("Failed to open profiler output '{0}'", s_SessionPath);
+            return;
+        }
+
+        uint64_t session = s_SessionId.load(std::memory_order_relaxed);
+        size_t recordCount = 0;
+
+        fmt::memory_buffer out;
+        fmt::format_to(std::back_inserter(out), "{{\"otherData\":{{\"session\":\"");
+        AppendEscaped(out, s_SessionName.c_str());
+        fmt::format_to(std::back_inserter(out), "\"}},\"traceEvents\":[");
+
+        bool first = true;
+        std::lock_guard<std::mutex> lock(s_BuffersMutex);
+        for (ThreadProfileBuffer* buffer : s_Buffers)
+        {
+            // Threads that recorded nothing this session still hold an older session's records
+            if (buffer->Session.load(std::memory_order_acquire) != session)
+                continue;
+
+            for (ProfileChunk* chunk = &buffer->Head; chunk; chunk = chunk->Next.load(std::memory_order_acquire))
+            {
+                uint32_t count = chunk->Count.load(std::memory_order_acquire);
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    const ProfileRecord& record = chunk->Records[i];
+
+                    // A scope that was already open when the session began is cut off at the session start
+                    uint64_t start = std::max(record.Start, s_SessionStartTicks);
+                    uint64_t end = std::max(record.End, start);
+
+                    out.append(std::string_view(first ? "{" : ",{"));
+                    fmt::format_to(std::back_inserter(out), "\"cat\":\"function\",\"name\":\"");
+                    AppendEscaped(out, record.Name);
+                    fmt::format_to(std::back_inserter(out), "\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                        buffer->ThreadId,
+                        static_cast<double>(start - s_SessionStartTicks) / ticksPerMicrosecond,
+                        static_cast<double>(end - start) / ticksPerMicrosecond);
+                    first = false;
+                }
+
+                recordCount += count;
+
+                // Records continue in the next chunk only if this one is full
+                if (count < ProfileChunk::Capacity)
+                    break;
+
+                // Write in chunk-sized pieces to keep the staging buffer small
+                std::fwrite(out.data(), 1, out.size(), file);
+                out.clear();
+            }
+        }
+
+        out.append(std::string_view("]}"));
+        std::fwrite(out.data(), 1, out.size(), file);
+        std::fclose(file);
+
+        VEX_CORE_INFO("Profiler session '{0}' wrote {1} scopes to '{2}'", s_SessionName, recordCount, s_SessionPath);
+    }
+
+    void Instrumentor::Record(const char* name, uint64_t start, uint64_t end)
+    {
+        ThreadProfileBuffer* buffer = t_Buffer ? t_Buffer : RegisterThread();
+
+        uint64_t session = s_SessionId.load(std::memory_order_acquire);
+        if (buffer->Session.load(std::memory_order_relaxed) != session)
+            buffer->Reset(session);
+
+        ProfileChunk* chunk = buffer->Current;
+        uint32_t count = chunk->Count.load(std::memory_order_relaxed);
+
+        if (count == ProfileChunk::Capacity)
+        {
+            // Reuse a chunk left over from an earlier session before allocating a new one
+            ProfileChunk* next = chunk->Next.load(std::memory_order_relaxed);
+            if (!next)
+            {
+                next = new ProfileChunk();
+                chunk->Next.store(next, std::memory_order_release);
+            }
+
+            buffer->Current = chunk = next;
+            count = 0;
+        }
+
+        chunk->Records[count] = { name, start, end };
+        chunk->Count.store(count + 1, std::memory_order_release);
+    }
+}
@@ -0,0 +1,167 @@
+/*
+ * @file Instrumentor.h
+ * @brief Scoped instrumentation profiler with Chrome trace-event export.
+ *
+ * `VEX_PROFILE_SCOPE(name)` and `VEX_PROFILE_FUNCTION()` time the enclosing scope and append one
+ * record (name pointer, start, end) to a buffer owned by the calling thread. Buffers are chunked
+ * and only ever written by their thread, so recording takes no locks: a timestamp read on entry, a
+ * timestamp read and a 24-byte store on exit. On x86-64 timestamps come straight from the CPU's
+ * time-stamp counter and are converted to wall time when the trace is written, calibrated against
+ * std::chrono::steady_clock over the session. EndSession() writes every thread's records as a Chrome
+ * trace-event JSON file that chrome://tracing and Perfetto can load.
+ *
+ * Known miss: the per-scope budget is 50 ns, but under virtualization the two timestamp reads alone can
+ * exceed it. On a 1-core VM a scope costs 60-68 ns at -O2, of which about 57 ns are the two RDTSCs (29 ns
+ * each there, a few ns on bare metal); the bookkeeping itself is under 10 ns.
+ *
+ * Usage:
+ * - `VEX_PROFILE_BEGIN_SESSION("Runtime", "VexProfile-Runtime.json");`, or with
+ *   `Vex::Instrumentor::GetSessionPath("Runtime")` to record only when VEX_PROFILE_DIR is set.
+ * - `VEX_PROFILE_FUNCTION();` or `VEX_PROFILE_SCOPE("Physics");` inside the code to measure.
+ * - `VEX_PROFILE_END_SESSION();` once no other thread is inside a profiled scope.
+ *
+ * Scope names must be string literals (or otherwise outlive the session); only the pointer is stored.
+ * All macros compile to nothing in Dist builds, or when VEX_PROFILE is defined to 0.
+ */
+
+#pragma once
+
+#include "Vex/Core.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+    #include <intrin.h>
+    #define VEX_PROFILE_USE_TSC 1
+#elif defined(__x86_64__)
+    #include <x86intrin.h>
+    #define VEX_PROFILE_USE_TSC 1
+#else
+    #define VEX_PROFILE_USE_TSC 0
+#endif
+
+#ifndef VEX_PROFILE
+    #ifdef VEX_DIST
+        #define VEX_PROFILE 0
+    #else
+        #define VEX_PROFILE 1
+    #endif
+#endif
+
+namespace Vex
+{
+    /**
+     * @brief One completed scope.
+     */
+    struct ProfileRecord
+    {
+        const char* Name;
+        uint64_t Start;     ///< Profiler clock ticks; see Instrumentor::Now().
+        uint64_t End;
+    };
+
+    /**
+     * @class Instrumentor
+     * @brief Static interface of the profiler.
+     */
+    class VEX_API Instrumentor
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Starts recording. Records from an earlier session are discarded.
+         * @param name Name of the session, written into the trace.
+         * @param filepath Path of the JSON file written by EndSession(); empty leaves the profiler off.
+         */
+        static void BeginSession(const std::string& name, const std::string& filepath = "VexProfile.json");
+
+        /**
+         * @brief Trace path for a session in the directory named by the VEX_PROFILE_DIR environment variable.
+         * @return "<dir>/VexProfile-<name>.json", or an empty string if the variable is not set.
+         */
+        static std::string GetSessionPath(const std::string& name);
+
+        /**
+         * @brief Stops recording and writes the trace file.
+         *
+         * Scopes still open on other threads when the session ends may be lost or land in the next session.
+         */
+        static void EndSession();
+
+        /** @return True while a session is recording. */
+        static bool IsActive() { return s_Active.load(std::memory_order_relaxed); }
+
+        /** @return Current time on the profiler clock: TSC ticks where available, nanoseconds otherwise. */
+        static uint64_t Now()
+        {
+#if VEX_PROFILE_USE_TSC
+            return __rdtsc();
+#else
+            return SteadyNanoseconds();
+#endif
+        }
+
+        /** @return Current steady_clock time in nanoseconds; used to calibrate the profiler clock. */
+        static uint64_t SteadyNanoseconds()
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+        }
+
+        /** @brief Appends a completed scope to the calling thread's buffer. */
+        static void Record(const char* name, uint64_t start, uint64_t end);
+
+    private:
+        static std::atomic<bool> s_Active;
+    };
+
+    /**
+     * @class ProfileScope
+     * @brief Records the lifetime of a scope. Created by the profiling macros.
+     */
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const char* name)
+            : m_Name(name), m_Start(Instrumentor::IsActive() ? Instrumentor::Now() : 0)
+        {
+        }
+
+        ~ProfileScope()
+        {
+            if (m_Start != 0 && Instrumentor::IsActive())
+                Instrumentor::Record(m_Name, m_Start, Instrumentor::Now());
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const char* m_Name;
+        uint64_t m_Start;
+    };
+}
+
+#if VEX_PROFILE
+    #if defined(_MSC_VER)
+        #define VEX_FUNC_SIG __FUNCSIG__
+    #else
+        #define VEX_FUNC_SIG __PRETTY_FUNCTION__
+    #endif
+
+    #define VEX_PROFILE_CONCAT_IMPL(a, b)       a##b
+    #define VEX_PROFILE_CONCAT(a, b)            VEX_PROFILE_CONCAT_IMPL(a, b)
+
+    #define VEX_PROFILE_BEGIN_SESSION(name, filepath)   ::Vex::Instrumentor::BeginSession(name, filepath)
+    #define VEX_PROFILE_END_SESSION()                   ::Vex::Instrumentor::EndSession()
+    #define VEX_PROFILE_SCOPE(name)                     ::Vex::ProfileScope VEX_PROFILE_CONCAT(vexProfileScope, __LINE__)(name)
+    #define VEX_PROFILE_FUNCTION()                      VEX_PROFILE_SCOPE(VEX_FUNC_SIG)
+#else
+    #define VEX_PROFILE_BEGIN_SESSION(name, filepath)   (void)0
+    #define VEX_PROFILE_END_SESSION()                   (void)0
+    #define VEX_PROFILE_SCOPE(name)                     (void)0
+    #define VEX_PROFILE_FUNCTION()                      (void)0
+#endif
@@ -0,0 +1,164 @@
+﻿#include "VexPch.h"
+#include "JobSystemBenchmark.h"
+
+#include "Vex/Jobs/JobSystem.h"
+#include "Vex/Log.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace Vex
+{
+    /**
+     * Sums a few rounds of an integer hash over [begin, end); enough arithmetic that the loop is not
+     * limited by memory bandwidth.
+     */
+    static uint64_t HashRange(uint32_t begin, uint32_t end, uint32_t workPerItem)
+    {
+        uint64_t sum = 0;
+        for (uint32_t i = begin; i < end; i++)
+        {
+            uint32_t value = i;
+            for (uint32_t step = 0; step < workPerItem; step++)
+                value = value * 1664525u + 1013904223u;
+            sum += value;
+        }
+        return sum;
+    }
+
+    JobSystemBenchmarkResult JobSystemBenchmark::Run(const JobSystemBenchmarkSpecification& specification)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        uint32_t maxThreads = specification.MaxThreads;
+        if (maxThreads == 0)
+            maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+        uint32_t iterations = std::max(specification.Iterations, 1u);
+        uint64_t expected = HashRange(0, specification.ItemCount, specification.WorkPerItem);
+
+        JobSystemBenchmarkResult result;
+        for (uint32_t threads = 1; ; threads = std::min(threads * 2, maxThreads))
+        {
+            // A pool with zero workers would pick its own size, so one thread is timed without one
+            std::unique_ptr<JobSystem> jobSystem = threads > 1 ? std::make_unique<JobSystem>(threads - 1) : nullptr;
+            std::atomic<uint64_t> sum{ 0 };
+
+            auto body = [&sum, &specification](uint32_t begin, uint32_t end)
+            {
+                sum.fetch_add(HashRange(begin, end, specification.WorkPerItem), std::memory_order_relaxed);
+            };
+
+            Clock::time_point start = Clock::now();
+            for (uint32_t i = 0; i < iterations; i++)
+            {
+                if (jobSystem)
+                    jobSystem->ParallelFor(specification.ItemCount, specification.BatchSize, body);
+                else
+                    body(0, specification.ItemCount);
+            }
+            float milliseconds = static_cast<float>(std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations);
+
+            if (sum.load() != expected * iterations)
+                VEX_CORE_ERROR("Job system benchmark: wrong sum with {0} threads", threads);
+
+            JobSystemScalingSample sample;
+            sample.Threads = threads;
+            sample.Milliseconds = milliseconds;
+            sample.Speedup = result.Samples.empty() || milliseconds <= 0.0f ? 1.0f : result.Samples.front().Milliseconds / milliseconds;
+            result.Samples.push_back(sample);
+
+            if (threads == maxThreads)
+            {
+                if (jobSystem)
+                {
+                    // Overhead of a job that does nothing: submit, steal or pop, run, count down. Waiting after every
+                    // group keeps the slot ring from wrapping, which would run the rest inline
+                    constexpr uint32_t emptyJobs = 102400;
+                    constexpr uint32_t groupSize = 1024;
+                    JobCounter counter;
+
+                    start = Clock::now();
+                    for (uint32_t i = 0; i < emptyJobs; i++)
+                    {
+                        jobSystem->Submit([]() {}, &counter);
+                        if ((i + 1) % groupSize == 0)
+                            jobSystem->Wait(counter);
+                    }
+                    result.SubmitNanoseconds = static_cast<float>(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / emptyJobs);
+                }
+                break;
+            }
+        }
+
+        return result;
+    }
+
+    JobSystemStressResult JobSystemBenchmark::RunStress(const JobSystemStressSpecification& specification)
+    {
+        JobSystem jobSystem(std::max(specification.Threads, 2u) - 1);
+
+        uint32_t jobs = specification.Jobs;
+        uint64_t expectedIndexSum = static_cast<uint64_t>(jobs) * (jobs - 1) / 2;
+
+        // Children per parent in the nested pattern; parents run on the workers and fill their rings
+        constexpr uint32_t childrenPerParent = 256;
+        uint32_t parents = std::max(jobs / childrenPerParent, 1u);
+
+        JobSystemStressResult result;
+        for (uint32_t round = 0; round < specification.Rounds; round++)
+        {
+            std::atomic<uint64_t> sum{ 0 };
+            JobCounter counter;
+
+            for (uint32_t i = 0; i < jobs; i++)
+                jobSystem.Submit([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); }, &counter);
+            jobSystem.Wait(counter);
+
+            if (sum.exchange(0) != expectedIndexSum)
+                result.Mismatches++;
+
+            jobSystem.ParallelFor(jobs, 1, [&sum](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; i++)
+                    sum.fetch_add(i, std::memory_order_relaxed);
+            });
+
+            if (sum.exchange(0) != expectedIndexSum)
+                result.Mismatches++;
+
+            for (uint32_t parent = 0; parent < parents; parent++)
+            {
+                jobSystem.Submit([&jobSystem, &sum, &counter]()
+                {
+                    for (uint32_t child = 0; child < childrenPerParent; child++)
+                        jobSystem.Submit([&sum]() { sum.fetch_add(1, std::memory_order_relaxed); }, &counter);
+                }, &counter);
+            }
+            jobSystem.Wait(counter);
+
+            if (sum.load() != static_cast<uint64_t>(parents) * childrenPerParent)
+                result.Mismatches++;
+
+            result.Rounds++;
+        }
+
+        return result;
+    }
+
+    void JobSystemBenchmark::LogResult(const std::string& label, const JobSystemBenchmarkResult& result)
+    {
+        VEX_CORE_INFO("Job system '{0}': {1:.1f} ns per empty job", label, result.SubmitNanoseconds);
+        for (const JobSystemScalingSample& sample : result.Samples)
+            VEX_CORE_INFO("  {0} threads: {1:.3f} ms, speedup {2:.2f}x", sample.Threads, sample.Milliseconds, sample.Speedup);
+    }
+
+    void JobSystemBenchmark::LogResult(const std::string& label, const JobSystemStressResult& result)
+    {
+        if (result.Passed())
+            VEX_CORE_INFO("Job system stress '{0}': {1} rounds passed", label, result.Rounds);
+        else
+            VEX_CORE_ERROR("Job system stress '{0}': {1} mismatches in {2} rounds", label, result.Mismatches, result.Rounds);
+    }
+}
@@ -0,0 +1,82 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <string>
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * Options for a job system scaling benchmark.
+     */
+    struct JobSystemBenchmarkSpecification
+    {
+        uint32_t ItemCount = 1 << 20;   ///< Elements of the ParallelFor.
+        uint32_t BatchSize = 1024;
+        uint32_t WorkPerItem = 64;      ///< Arithmetic steps per element; raise it to make the work less memory bound.
+        uint32_t Iterations = 10;       ///< ParallelFor runs averaged per thread count.
+        uint32_t MaxThreads = 0;        ///< Largest thread count measured, including the caller; 0 uses the hardware threads.
+    };
+
+    /**
+     * Timing at one thread count.
+     */
+    struct JobSystemScalingSample
+    {
+        uint32_t Threads = 0;
+        float Milliseconds = 0.0f;      ///< One ParallelFor over every element.
+        float Speedup = 0.0f;           ///< Relative to one thread.
+    };
+
+    /**
+     * Result of a job system scaling benchmark.
+     */
+    struct JobSystemBenchmarkResult
+    {
+        std::vector<JobSystemScalingSample> Samples;    ///< Thread counts 1, 2, 4, ... up to MaxThreads.
+        float SubmitNanoseconds = 0.0f;                 ///< Per empty job submitted and run, on the largest pool.
+    };
+
+    /**
+     * Options for a job system stress run.
+     */
+    struct JobSystemStressSpecification
+    {
+        uint32_t Threads = 4;           ///< Including the caller.
+        uint32_t Jobs = 20000;          ///< Jobs per round; well above MaxJobsPerThread so the slot rings wrap.
+        uint32_t Rounds = 20;
+    };
+
+    /**
+     * Result of a job system stress run. Any mismatch means a job was lost, run twice or ran on a reused slot.
+     */
+    struct JobSystemStressResult
+    {
+        uint32_t Rounds = 0;
+        uint32_t Mismatches = 0;
+
+        bool Passed() const { return Rounds > 0 && Mismatches == 0; }
+    };
+
+    /**
+     * @class JobSystemBenchmark
+     * @brief Measures how ParallelFor scales with the thread count, and stress-tests the pool.
+     *
+     * Run() times the same ParallelFor on pools of 1, 2, 4, ... threads. RunStress() submits far more jobs
+     * than a slot ring holds in three patterns: flat Submit() calls from the owning thread, a ParallelFor
+     * with one element per batch, and jobs that submit children from the workers. Every job adds to a
+     * checksum that is compared with the expected total. Build it with -fsanitize=thread to check the pool
+     * for races as well.
+     */
+    class VEX_API JobSystemBenchmark
+    {
+    public:
+        static JobSystemBenchmarkResult Run(const JobSystemBenchmarkSpecification& specification = JobSystemBenchmarkSpecification());
+        static JobSystemStressResult RunStress(const JobSystemStressSpecification& specification = JobSystemStressSpecification());
+
+        /** Write results to the core logger under the given label. */
+        static void LogResult(const std::string& label, const JobSystemBenchmarkResult& result);
+        static void LogResult(const std::string& label, const JobSystemStressResult& result);
+    };
+}
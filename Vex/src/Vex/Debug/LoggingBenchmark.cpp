@@ -0,0 +1,163 @@
+﻿#include "VexPch.h"
+#include "LoggingBenchmark.h"
+
+#include "Vex/BinaryLog.h"
+#include "Vex/Debug/Histogram.h"
+#include "spdlog/async.h"
+#include "spdlog/sinks/basic_file_sink.h"
+
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+namespace Vex
+{
+    LoggingBenchmarkResult LoggingBenchmark::Run(LogMode mode, const LoggingBenchmarkSpecification& specification)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        LoggingBenchmarkResult result;
+        Histogram callTimes;    // Nanoseconds
+        Histogram frameTimes;   // Nanoseconds
+        uint64_t maxCallTime = 0;
+        uint64_t maxFrameTime = 0;
+
+        {
+            auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(specification.Path, true);
+
+            // Not registered with spdlog, so the engine loggers and their thread pool are left alone
+            std::shared_ptr<spdlog::details::thread_pool> threadPool;
+            std::shared_ptr<spdlog::logger> logger;
+            if (mode == LogMode::Asynchronous)
+            {
+                threadPool = std::make_shared<spdlog::details::thread_pool>(specification.QueueSize, 1);
+                spdlog::async_overflow_policy policy = specification.OverflowPolicy == LogOverflowPolicy::DropOldest
+                    ? spdlog::async_overflow_policy::overrun_oldest : spdlog::async_overflow_policy::block;
+                logger = std::make_shared<spdlog::async_logger>("BENCH", sink, threadPool, policy);
+            }
+            else
+            {
+                logger = std::make_shared<spdlog::logger>("BENCH", sink);
+            }
+
+            logger->set_pattern("%^[%T] %n: %v%$");
+            logger->set_level(spdlog::level::trace);
+
+            for (uint32_t frame = 0; frame < specification.Frames; frame++)
+            {
+                uint64_t frameTime = 0;
+                for (uint32_t i = 0; i < specification.MessagesPerFrame; i++)
+                {
+                    Clock::time_point start = Clock::now();
+                    logger->info("Frame {0} message {1}: position ({2:.3f}, {3:.3f})", frame, i, frame * 0.5f, i * 0.25f);
+                    uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+
+                    callTimes.Record(static_cast<uint32_t>(std::min<uint64_t>(elapsed, UINT32_MAX)));
+                    maxCallTime = std::max(maxCallTime, elapsed);
+                    frameTime += elapsed;
+                }
+
+                frameTimes.Record(static_cast<uint32_t>(std::min<uint64_t>(frameTime, UINT32_MAX)));
+                maxFrameTime = std::max(maxFrameTime, frameTime);
+            }
+
+            // Destroying the logger and its pool drains the queue before the file is removed
+            logger->flush();
+        }
+
+        std::error_code error;
+        std::filesystem::remove(specification.Path, error);
+
+        constexpr float nsToUs = 0.001f;
+
+        result.Messages = callTimes.GetCount();
+        result.CallP50 = static_cast<float>(callTimes.GetPercentile(50.0));
+        result.CallP99 = static_cast<float>(callTimes.GetPercentile(99.0));
+        result.CallMax = static_cast<float>(maxCallTime);
+        result.FrameP50 = frameTimes.GetPercentile(50.0) * nsToUs;
+        result.FrameP99 = frameTimes.GetPercentile(99.0) * nsToUs;
+        result.FrameMax = maxFrameTime * nsToUs;
+        return result;
+    }
+
+    BinaryLogStressResult LoggingBenchmark::RunBinaryLogStress(const BinaryLogStressSpecification& specification)
+    {
+        // Record sizes as BinaryLog lays them out: a 16-byte header, then the arguments padded to 8 bytes
+        constexpr size_t headerSize = 16;
+        constexpr size_t argumentRecordSize = headerSize + sizeof(uint64_t);
+
+        bool ownsBinaryLog = !BinaryLog::IsRunning();
+        if (ownsBinaryLog)
+            BinaryLog::Init(0);
+
+        spdlog::level::level_enum coreLevel = Log::GetCoreLogger()->level();
+        Log::GetCoreLogger()->set_level(std::max(coreLevel, spdlog::level::info));
+
+        BinaryLogStressResult result;
+        uint64_t droppedBefore = BinaryLog::GetDroppedCount();
+
+        std::thread writer([&]()
+        {
+            size_t capacity = BinaryLog::GetThreadBufferSize();
+            size_t offset = 0;
+
+            for (uint32_t lap = 0; lap < specification.Laps; lap++)
+            {
+                size_t gap = lap % 2 == 0 ? 8 : headerSize;
+                size_t target = capacity - gap;
+
+                // Records are 16 or 24 bytes, so any multiple of 8 from 16 up is reachable exactly
+                if ((target - offset) % 16 == 8)
+                {
+                    VEX_BINLOG("stress lap {0} start", static_cast<uint64_t>(lap));
+                    offset += argumentRecordSize;
+                    result.Records++;
+                }
+
+                for (uint32_t count = 1; offset < target; count++)
+                {
+                    VEX_BINLOG("stress filler");
+                    offset += headerSize;
+                    result.Records++;
+
+                    // Keeps the ring from filling up; a dropped record would throw the offsets off
+                    if (count % 64 == 0)
+                        BinaryLog::Flush();
+                }
+
+                // The ring is empty now, and the next record does not fit before the end
+                BinaryLog::Flush();
+                VEX_BINLOG("stress lap {0} wrapped", static_cast<uint64_t>(lap));
+                offset = argumentRecordSize;
+                result.Records++;
+
+                BinaryLog::Flush();
+                result.Laps++;
+            }
+        });
+        writer.join();
+
+        result.Dropped = BinaryLog::GetDroppedCount() - droppedBefore;
+
+        if (ownsBinaryLog)
+            BinaryLog::Shutdown();
+        Log::GetCoreLogger()->set_level(coreLevel);
+
+        return result;
+    }
+
+    void LoggingBenchmark::LogResult(const std::string& label, const LoggingBenchmarkResult& result)
+    {
+        VEX_CORE_INFO("Logging '{0}': {1} messages", label, result.Messages);
+        VEX_CORE_INFO("  ns per call p50 {0:.0f} p99 {1:.0f} max {2:.0f} | us per frame p50 {3:.1f} p99 {4:.1f} max {5:.1f}",
+            result.CallP50, result.CallP99, result.CallMax, result.FrameP50, result.FrameP99, result.FrameMax);
+    }
+
+    void LoggingBenchmark::LogResult(const std::string& label, const BinaryLogStressResult& result)
+    {
+        if (result.Passed())
+            VEX_CORE_INFO("Binary log stress '{0}': {1} laps, {2} records passed", label, result.Laps, result.Records);
+        else
+            VEX_CORE_ERROR("Binary log stress '{0}': {1} of {2} records dropped in {3} laps", label, result.Dropped, result.Records, result.Laps);
+    }
+}
@@ -0,0 +1,86 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Vex/Log.h"
+
+#include <string>
+
+namespace Vex
+{
+    /**
+     * Options for a logging jitter benchmark.
+     */
+    struct LoggingBenchmarkSpecification
+    {
+        uint32_t Frames = 1000;
+        uint32_t MessagesPerFrame = 50;
+        size_t QueueSize = 8192;                    ///< Async ring buffer size, as in LogSpecification.
+        LogOverflowPolicy OverflowPolicy = LogOverflowPolicy::Block;
+        std::string Path = "VexLoggingBenchmark.log";   ///< Scratch file the messages go to; removed afterwards.
+    };
+
+    /**
+     * Cost of logging as seen by the calling thread.
+     */
+    struct LoggingBenchmarkResult
+    {
+        uint64_t Messages = 0;
+        float CallP50 = 0.0f;       ///< Nanoseconds per log call.
+        float CallP99 = 0.0f;
+        float CallMax = 0.0f;
+        float FrameP50 = 0.0f;      ///< Microseconds spent logging per frame.
+        float FrameP99 = 0.0f;
+        float FrameMax = 0.0f;
+    };
+
+    /**
+     * Options for a binary log stress run.
+     */
+    struct BinaryLogStressSpecification
+    {
+        uint32_t Laps = 8;      ///< Times around the ring; alternately ending 8 and 16 bytes before the end.
+    };
+
+    /**
+     * Result of a binary log stress run.
+     */
+    struct BinaryLogStressResult
+    {
+        uint32_t Laps = 0;
+        uint64_t Records = 0;
+        uint64_t Dropped = 0;   ///< Any drop means the ring position was not where the test put it.
+
+        bool Passed() const { return Laps > 0 && Dropped == 0; }
+    };
+
+    /**
+     * @class LoggingBenchmark
+     * @brief Compares the jitter synchronous and asynchronous logging add to the calling thread.
+     *
+     * Builds a private logger with the same pattern as the engine loggers, writing to a scratch file so the
+     * console does not distort the numbers, and logs MessagesPerFrame formatted messages per simulated
+     * frame. Every call is timed; the tail (p99, max) is what shows up as frame hitches. The engine
+     * loggers are not touched, so it can run inside a live application.
+     */
+    class VEX_API LoggingBenchmark
+    {
+    public:
+        static LoggingBenchmarkResult Run(LogMode mode, const LoggingBenchmarkSpecification& specification = LoggingBenchmarkSpecification());
+
+        /**
+         * @brief Drives a binary log ring buffer across its end at the offsets where the wrap is easy to get wrong.
+         *
+         * Runs on a new thread, so it gets a ring of its own starting at offset 0, and fills it so that the last
+         * record ends 8 bytes before the end (no room for a wrap marker) or 16 bytes before it (room for the marker,
+         * not for the record), then writes the record that wraps and decodes everything. Build with
+         * -fsanitize=address to catch the decoder reading past the ring. Starts the binary log with its
+         * smallest ring if it is not running. The core logger is held at info level while it runs, so the
+         * filler records do not reach the console.
+         */
+        static BinaryLogStressResult RunBinaryLogStress(const BinaryLogStressSpecification& specification = BinaryLogStressSpecification());
+
+        /** Write results to the core logger under the given label. */
+        static void LogResult(const std::string& label, const LoggingBenchmarkResult& result);
+        static void LogResult(const std::string& label, const BinaryLogStressResult& result);
+    };
+}
@@ -0,0 +1,236 @@
+﻿#include "VexPch.h"
+#include "MPSCEventQueueBenchmark.h"
+
+#include "Vex/Events/MPSCEventQueue.h"
+#include "Vex/Log.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace Vex
+{
+    namespace
+    {
+        /**
+         * Custom application event of the kind worker threads post.
+         */
+        class PostedBenchmarkEvent : public Event
+        {
+        public:
+            PostedBenchmarkEvent(uint32_t producer, uint32_t sequence)
+                : Producer(producer), Sequence(sequence) {}
+
+            uint32_t Producer;
+            uint32_t Sequence;
+
+            EVENT_CLASS_TYPE(AppTick)
+            EVENT_CLASS_CATEGORY(EventCategoryApplication)
+        };
+
+        /**
+         * Producer threads that each post EventsPerProducer events, retrying while the ring is full.
+         */
+        class ProducerRun
+        {
+        public:
+            ProducerRun(MPSCEventQueue& queue, uint32_t producers, uint32_t eventsPerProducer)
+                : m_Queue(queue), m_Producers(producers), m_EventsPerProducer(eventsPerProducer)
+            {
+                for (uint32_t producer = 0; producer < producers; producer++)
+                    m_Threads.emplace_back([this, producer]() { Produce(producer); });
+            }
+
+            ~ProducerRun() { Join(); }
+
+            /** Releases the producers at once so they contend from the first post. */
+            void Start() { m_Started.store(true, std::memory_order_release); }
+
+            /** Makes producers waiting on a full ring give up. */
+            void Stop() { m_Stopped.store(true, std::memory_order_relaxed); }
+
+            void Join()
+            {
+                for (std::thread& thread : m_Threads)
+                {
+                    if (thread.joinable())
+                        thread.join();
+                }
+            }
+
+            /** True once every producer has posted its last event; those events are then visible to Drain(). */
+            bool IsFinished() const { return m_Finished.load(std::memory_order_acquire) == m_Producers; }
+
+            uint64_t GetFullRetries() const { return m_FullRetries.load(std::memory_order_relaxed); }
+
+        private:
+            void Produce(uint32_t producer)
+            {
+                while (!m_Started.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+
+                uint64_t retries = 0;
+                for (uint32_t sequence = 0; sequence < m_EventsPerProducer; sequence++)
+                {
+                    while (!m_Queue.Post<PostedBenchmarkEvent>(producer, sequence))
+                    {
+                        if (m_Stopped.load(std::memory_order_relaxed))
+                            return;
+
+                        retries++;
+                        std::this_thread::yield();
+                    }
+                }
+
+                m_FullRetries.fetch_add(retries, std::memory_order_relaxed);
+                m_Finished.fetch_add(1, std::memory_order_release);
+            }
+
+            MPSCEventQueue& m_Queue;
+            uint32_t m_Producers;
+            uint32_t m_EventsPerProducer;
+            std::vector<std::thread> m_Threads;
+            std::atomic<bool> m_Started{ false };
+            std::atomic<bool> m_Stopped{ false };
+            std::atomic<uint32_t> m_Finished{ 0 };
+            std::atomic<uint64_t> m_FullRetries{ 0 };
+        };
+
+        /**
+         * Drains on the calling thread until every producer is done and the ring is empty.
+         * Returns false, after stopping the producers, if nothing arrived for a couple of seconds.
+         */
+        template<typename F>
+        bool DrainUntilFinished(MPSCEventQueue& queue, ProducerRun& run, F&& func)
+        {
+            using Clock = std::chrono::steady_clock;
+            Clock::time_point lastProgress = Clock::now();
+
+            while (true)
+            {
+                // Checked before draining, so an empty drain after it means nothing more is coming
+                bool finished = run.IsFinished();
+                if (queue.Drain(func) > 0)
+                {
+                    lastProgress = Clock::now();
+                    continue;
+                }
+
+                if (finished)
+                    return true;
+
+                // A lost or twice-published slot blocks the consumer, and then the producers on a full ring
+                if (Clock::now() - lastProgress > std::chrono::seconds(2))
+                {
+                    run.Stop();
+                    return false;
+                }
+
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    MPSCEventQueueBenchmarkResult MPSCEventQueueBenchmark::Run(const MPSCEventQueueBenchmarkSpecification& specification)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        MPSCEventQueueBenchmarkResult result;
+        for (uint32_t producers : specification.ProducerCounts)
+        {
+            MPSCEventQueue queue(specification.Capacity);
+            ProducerRun run(queue, producers, specification.EventsPerProducer);
+
+            uint64_t received = 0;
+            uint64_t expected = static_cast<uint64_t>(producers) * specification.EventsPerProducer;
+
+            Clock::time_point start = Clock::now();
+            run.Start();
+            if (!DrainUntilFinished(queue, run, [&received](Event&) { received++; }))
+                VEX_CORE_ERROR("MPSC queue benchmark: the queue stalled with {0} producers", producers);
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            run.Join();
+
+            if (received != expected)
+                VEX_CORE_ERROR("MPSC queue benchmark: {0} of {1} events arrived with {2} producers", received, expected, producers);
+
+            MPSCEventQueueBenchmarkSample sample;
+            sample.Producers = producers;
+            sample.MillionEventsPerSecond = seconds > 0.0 ? static_cast<float>(received / seconds / 1e6) : 0.0f;
+            sample.NanosecondsPerEvent = received > 0 ? static_cast<float>(seconds * 1e9 / received) : 0.0f;
+            sample.FullRetries = run.GetFullRetries();
+            result.Samples.push_back(sample);
+        }
+
+        return result;
+    }
+
+    MPSCEventQueueStressResult MPSCEventQueueBenchmark::RunStress(const MPSCEventQueueStressSpecification& specification)
+    {
+        uint32_t producers = std::max(specification.Producers, 1u);
+
+        MPSCEventQueueStressResult result;
+        for (uint32_t round = 0; round < specification.Rounds; round++)
+        {
+            MPSCEventQueue queue(specification.Capacity);
+            ProducerRun run(queue, producers, specification.EventsPerProducer);
+
+            // Each producer's events must arrive in the order posted, so the next one is always known
+            std::vector<uint32_t> nextSequence(producers, 0);
+            uint32_t mismatches = 0;
+
+            run.Start();
+            bool drained = DrainUntilFinished(queue, run, [&](Event& e)
+            {
+                result.Events++;
+
+                auto& posted = static_cast<PostedBenchmarkEvent&>(e);
+                if (e.GetEventType() != PostedBenchmarkEvent::GetStaticType() || posted.Producer >= producers ||
+                    posted.Sequence != nextSequence[posted.Producer])
+                {
+                    mismatches++;
+                    return;
+                }
+
+                nextSequence[posted.Producer]++;
+            });
+            run.Join();
+
+            if (!drained)
+            {
+                VEX_CORE_ERROR("MPSC queue stress: the queue stalled in round {0}", round);
+                mismatches++;
+            }
+
+            // A lost event leaves its producer short; a duplicated or reordered one was counted above
+            for (uint32_t sequence : nextSequence)
+            {
+                if (sequence != specification.EventsPerProducer)
+                    mismatches++;
+            }
+
+            result.Mismatches += mismatches;
+            result.Rounds++;
+        }
+
+        return result;
+    }
+
+    void MPSCEventQueueBenchmark::LogResult(const std::string& label, const MPSCEventQueueBenchmarkResult& result)
+    {
+        VEX_CORE_INFO("MPSC event queue '{0}':", label);
+        for (const MPSCEventQueueBenchmarkSample& sample : result.Samples)
+        {
+            VEX_CORE_INFO("  {0} producers: {1:.2f} M events/s ({2:.1f} ns/event), {3} retries on a full ring",
+                sample.Producers, sample.MillionEventsPerSecond, sample.NanosecondsPerEvent, sample.FullRetries);
+        }
+    }
+
+    void MPSCEventQueueBenchmark::LogResult(const std::string& label, const MPSCEventQueueStressResult& result)
+    {
+        if (result.Passed())
+            VEX_CORE_INFO("MPSC event queue stress '{0}': {1} rounds, {2} events passed", label, result.Rounds, result.Events);
+        else
+            VEX_CORE_ERROR("MPSC event queue stress '{0}': {1} mismatches in {2} rounds", label, result.Mismatches, result.Rounds);
+    }
+}
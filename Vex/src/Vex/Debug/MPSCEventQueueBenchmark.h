@@ -0,0 +1,81 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <string>
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * Options for an MPSCEventQueue throughput benchmark.
+     */
+    struct MPSCEventQueueBenchmarkSpecification
+    {
+        std::vector<uint32_t> ProducerCounts = { 1, 2, 4, 8 };
+        uint32_t EventsPerProducer = 1000000;
+        uint32_t Capacity = 4096;           ///< Slots in the ring.
+    };
+
+    /**
+     * Throughput at one producer count.
+     */
+    struct MPSCEventQueueBenchmarkSample
+    {
+        uint32_t Producers = 0;
+        float MillionEventsPerSecond = 0.0f;    ///< Events posted and drained, from the first post to the last drain.
+        float NanosecondsPerEvent = 0.0f;
+        uint64_t FullRetries = 0;               ///< Posts that found the ring full and were retried.
+    };
+
+    /**
+     * Result of an MPSCEventQueue throughput benchmark.
+     */
+    struct MPSCEventQueueBenchmarkResult
+    {
+        std::vector<MPSCEventQueueBenchmarkSample> Samples;
+    };
+
+    /**
+     * Options for an MPSCEventQueue stress run.
+     */
+    struct MPSCEventQueueStressSpecification
+    {
+        uint32_t Producers = 8;
+        uint32_t EventsPerProducer = 20000;
+        uint32_t Capacity = 64;             ///< Small, so producers keep finding the ring full and the ring wraps often.
+        uint32_t Rounds = 10;
+    };
+
+    /**
+     * Result of an MPSCEventQueue stress run. Any mismatch means an event was lost, duplicated or reordered.
+     */
+    struct MPSCEventQueueStressResult
+    {
+        uint32_t Rounds = 0;
+        uint64_t Events = 0;                ///< Events drained over all rounds.
+        uint32_t Mismatches = 0;
+
+        bool Passed() const { return Rounds > 0 && Mismatches == 0; }
+    };
+
+    /**
+     * @class MPSCEventQueueBenchmark
+     * @brief Measures MPSCEventQueue throughput and stress-tests it with many producers.
+     *
+     * Producers are threads that post events carrying their index and a sequence number, retrying while
+     * the ring is full; the calling thread is the consumer and drains until every event has arrived.
+     * RunStress() checks that each producer's events arrive exactly once and in the order they were
+     * posted. Build it with -fsanitize=thread to check the queue for races as well.
+     */
+    class VEX_API MPSCEventQueueBenchmark
+    {
+    public:
+        static MPSCEventQueueBenchmarkResult Run(const MPSCEventQueueBenchmarkSpecification& specification = MPSCEventQueueBenchmarkSpecification());
+        static MPSCEventQueueStressResult RunStress(const MPSCEventQueueStressSpecification& specification = MPSCEventQueueStressSpecification());
+
+        /** Write results to the core logger under the given label. */
+        static void LogResult(const std::string& label, const MPSCEventQueueBenchmarkResult& result);
+        static void LogResult(const std::string& label, const MPSCEventQueueStressResult& result);
+    };
+}
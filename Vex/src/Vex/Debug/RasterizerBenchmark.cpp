@@ -0,0 +1,161 @@
+﻿#include "VexPch.h"
+#include "RasterizerBenchmark.h"
+
+#include "Vex/Jobs/JobSystem.h"
+#include "Vex/Log.h"
+#include "Vex/Renderer/SoftwareRasterizer.h"
+
+#include <chrono>
+#include <thread>
+
+namespace Vex
+{
+    /**
+     * Thread counts to run when the specification names none: powers of two up to the hardware, plus the hardware count.
+     */
+    static std::vector<uint32_t> DefaultThreadCounts()
+    {
+        uint32_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 2u);
+
+        std::vector<uint32_t> counts;
+        for (uint32_t threads = 2; threads < hardwareThreads; threads *= 2)
+            counts.push_back(threads);
+        counts.push_back(hardwareThreads);
+        return counts;
+    }
+
+    /**
+     * Opaque 2x2 checkerboard with a transparent border, so sprites exercise both texturing and blending.
+     */
+    static std::vector<uint32_t> MakeSpriteTexture(uint32_t size)
+    {
+        std::vector<uint32_t> pixels(static_cast<size_t>(size) * size);
+        for (uint32_t y = 0; y < size; y++)
+        {
+            for (uint32_t x = 0; x < size; x++)
+            {
+                bool border = x == 0 || y == 0 || x == size - 1 || y == size - 1;
+                bool light = ((x * 2 / size) ^ (y * 2 / size)) != 0;
+                pixels[static_cast<size_t>(y) * size + x] = border ? PackColor(0, 0, 0, 0) : light ? PackColor(240, 200, 60) : PackColor(60, 90, 200);
+            }
+        }
+        return pixels;
+    }
+
+    static void SubmitFillScene(SoftwareRasterizer& rasterizer, const RasterizerBenchmarkSpecification& specification)
+    {
+        float w = static_cast<float>(specification.Width), h = static_cast<float>(specification.Height);
+
+        for (uint32_t layer = 0; layer < specification.FillLayers; layer++)
+        {
+            uint8_t shade = static_cast<uint8_t>(layer * 40);
+            RasterVertex topLeft = { 0.0f, 0.0f, PackColor(255, shade, 0) };
+            RasterVertex topRight = { w, 0.0f, PackColor(0, 255, shade) };
+            RasterVertex bottomLeft = { 0.0f, h, PackColor(shade, 0, 255) };
+            RasterVertex bottomRight = { w, h, PackColor(255, 255, 255) };
+
+            rasterizer.DrawTriangle(topLeft, topRight, bottomRight);
+            rasterizer.DrawTriangle(topLeft, bottomRight, bottomLeft);
+        }
+    }
+
+    static void SubmitSpriteScene(SoftwareRasterizer& rasterizer, const RasterizerBenchmarkSpecification& specification,
+        const RasterTexture& texture, uint32_t frame)
+    {
+        // Fixed-seed LCG so every thread count draws the same sprites
+        uint32_t seed = 12345u + frame;
+        auto next = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+
+        float size = static_cast<float>(specification.SpriteSize);
+        uint32_t rangeX = specification.Width > specification.SpriteSize ? specification.Width - specification.SpriteSize : 1;
+        uint32_t rangeY = specification.Height > specification.SpriteSize ? specification.Height - specification.SpriteSize : 1;
+
+        for (uint32_t i = 0; i < specification.SpriteCount; i++)
+        {
+            float x = static_cast<float>(next() % rangeX);
+            float y = static_cast<float>(next() % rangeY);
+            uint32_t tint = PackColor(static_cast<uint8_t>(128 + next() % 128), static_cast<uint8_t>(128 + next() % 128), 255);
+
+            rasterizer.DrawQuad(x, y, size, size, texture, 0.0f, 0.0f, 1.0f, 1.0f, tint);
+        }
+    }
+
+    std::vector<RasterizerBenchmarkResult> RasterizerBenchmark::Run(const RasterizerBenchmarkSpecification& specification)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        std::vector<uint32_t> threadCounts = specification.ThreadCounts.empty() ? DefaultThreadCounts() : specification.ThreadCounts;
+        std::vector<uint32_t> texturePixels = MakeSpriteTexture(specification.SpriteSize);
+        RasterTexture texture = { texturePixels.data(), specification.SpriteSize, specification.SpriteSize };
+
+        std::vector<RasterizerBenchmarkResult> results;
+        for (uint32_t threads : threadCounts)
+        {
+            RasterizerBenchmarkResult result;
+            result.Threads = std::max(threads, 2u);
+
+            JobSystem jobSystem(result.Threads - 1);
+            SoftwareRasterizer rasterizer(jobSystem, specification.Width, specification.Height);
+
+            // Fill rate: raster time only, so setup of the few triangles does not count
+            double fillMilliseconds = 0.0;
+            uint64_t fillPixels = 0;
+            for (uint32_t frame = 0; frame <= specification.Frames; frame++)
+            {
+                rasterizer.BeginFrame(PackColor(0, 0, 0));
+                SubmitFillScene(rasterizer, specification);
+                rasterizer.EndFrame();
+
+                // Frame 0 warms up the workers and the bins
+                if (frame == 0)
+                    continue;
+
+                fillMilliseconds += rasterizer.GetStats().RasterMilliseconds;
+                fillPixels += rasterizer.GetStats().PixelsShaded;
+            }
+
+            // Sprites: whole frames, since per-sprite setup and binning is the point
+            double spriteMilliseconds = 0.0;
+            uint64_t spritePixels = 0;
+            for (uint32_t frame = 0; frame <= specification.Frames; frame++)
+            {
+                Clock::time_point start = Clock::now();
+
+                rasterizer.BeginFrame(PackColor(20, 20, 30));
+                SubmitSpriteScene(rasterizer, specification, texture, frame);
+                rasterizer.EndFrame();
+
+                if (frame == 0)
+                    continue;
+
+                spriteMilliseconds += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                spritePixels += rasterizer.GetStats().PixelsShaded;
+            }
+
+            uint32_t frames = std::max(specification.Frames, 1u);
+            result.FillMegapixelsPerSecond = fillMilliseconds > 0.0 ? static_cast<float>(fillPixels / (fillMilliseconds * 1000.0)) : 0.0f;
+            result.SpriteFrameMilliseconds = static_cast<float>(spriteMilliseconds / frames);
+            result.SpriteMegapixelsPerSecond = spriteMilliseconds > 0.0 ? static_cast<float>(spritePixels / (spriteMilliseconds * 1000.0)) : 0.0f;
+            result.SpritesPer60HzFrame = result.SpriteFrameMilliseconds > 0.0f
+                ? static_cast<uint32_t>(specification.SpriteCount * (1000.0f / 60.0f) / result.SpriteFrameMilliseconds) : 0;
+
+            if (!specification.ImagePath.empty() && threads == threadCounts.back())
+                rasterizer.GetFramebuffer().SaveBMP(specification.ImagePath);
+
+            results.push_back(result);
+        }
+
+        return results;
+    }
+
+    void RasterizerBenchmark::LogResults(const std::vector<RasterizerBenchmarkResult>& results)
+    {
+        VEX_CORE_INFO("Software rasterizer: threads | fill Mpx/s | sprite frame ms | sprite Mpx/s | sprites per 60 Hz frame");
+        for (const RasterizerBenchmarkResult& result : results)
+        {
+            VEX_CORE_INFO("  {0:>7} | {1:>10.1f} | {2:>15.2f} | {3:>12.1f} | {4:>8}",
+                result.Threads, result.FillMegapixelsPerSecond, result.SpriteFrameMilliseconds,
+                result.SpriteMegapixelsPerSecond, result.SpritesPer60HzFrame);
+        }
+    }
+}
@@ -0,0 +1,53 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <string>
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * Options for a software rasterizer benchmark.
+     */
+    struct RasterizerBenchmarkSpecification
+    {
+        uint32_t Width = 1920;
+        uint32_t Height = 1080;
+        uint32_t Frames = 30;                   ///< Measured frames per scene and thread count.
+        uint32_t FillLayers = 4;                ///< Screen-covering gradient triangle pairs per fill frame.
+        uint32_t SpriteCount = 10000;           ///< Textured, alpha-blended sprites per sprite frame.
+        uint32_t SpriteSize = 32;               ///< Sprite edge, in pixels.
+        std::vector<uint32_t> ThreadCounts;     ///< Threads including the caller; empty runs 2, 4, 8, ... and the hardware count.
+        std::string ImagePath;                  ///< If set, the last sprite frame of the last run is saved here as a BMP.
+    };
+
+    /**
+     * Throughput of the software rasterizer at one thread count.
+     */
+    struct RasterizerBenchmarkResult
+    {
+        uint32_t Threads = 0;
+        float FillMegapixelsPerSecond = 0.0f;   ///< Opaque triangle pixels, counting overdraw.
+        float SpriteFrameMilliseconds = 0.0f;   ///< Average, submission included.
+        float SpriteMegapixelsPerSecond = 0.0f;
+        uint32_t SpritesPer60HzFrame = 0;       ///< Sprites that would fit in 1/60 s at the measured rate.
+    };
+
+    /**
+     * @class RasterizerBenchmark
+     * @brief Measures SoftwareRasterizer throughput across thread counts.
+     *
+     * For every thread count a temporary JobSystem is started and two scenes are rendered: full-screen
+     * gradient triangles for raw fill rate, and many small textured sprites for per-primitive cost.
+     * The job system always has at least one worker, so thread counts below two run with two.
+     */
+    class VEX_API RasterizerBenchmark
+    {
+    public:
+        static std::vector<RasterizerBenchmarkResult> Run(const RasterizerBenchmarkSpecification& specification = RasterizerBenchmarkSpecification());
+
+        /** Writes results to the core logger as a table. */
+        static void LogResults(const std::vector<RasterizerBenchmarkResult>& results);
+    };
+}
@@ -0,0 +1,96 @@
+﻿#include "VexPch.h"
+#include "Renderer2DBenchmark.h"
+
+#include "Platform/Headless/HeadlessRenderer2DBackend.h"
+#include "Vex/Jobs/JobSystem.h"
+#include "Vex/Log.h"
+#include "Vex/Renderer/Renderer2D.h"
+
+#include <chrono>
+
+namespace Vex
+{
+    Renderer2DBenchmarkResult Renderer2DBenchmark::Run(const Renderer2DBenchmarkSpecification& specification)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        std::unique_ptr<JobSystem> jobSystem;
+        if (specification.Threads > 1)
+            jobSystem = std::make_unique<JobSystem>(specification.Threads - 1);
+
+        HeadlessRenderer2DBackend backend;
+        Renderer2D::Init(backend, jobSystem.get());
+
+        uint32_t texel = 0xFFFFFFFFu;
+        std::vector<TextureHandle> textures;
+        for (uint32_t i = 0; i < specification.Textures; i++)
+            textures.push_back(Renderer2D::CreateTexture(&texel, 1, 1));
+
+        uint32_t layers = std::max(specification.Layers, 1u);
+        uint32_t materials = static_cast<uint32_t>(textures.size()) + 1;    // Last one stands for plain quads
+
+        Renderer2DBenchmarkResult result;
+        result.Sprites = specification.SpriteCount;
+
+        double submitMilliseconds = 0.0, sortMilliseconds = 0.0, buildMilliseconds = 0.0, frameMilliseconds = 0.0;
+
+        // Frame 0 grows the buffers to their steady-state size and is not measured
+        for (uint32_t frame = 0; frame <= specification.Frames; frame++)
+        {
+            uint32_t seed = 2166136261u;
+            auto next = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+
+            Clock::time_point start = Clock::now();
+
+            Renderer2D::BeginScene();
+            for (uint32_t i = 0; i < specification.SpriteCount; i++)
+            {
+                float x = static_cast<float>(next() % 1920);
+                float y = static_cast<float>(next() % 1080);
+                uint8_t layer = static_cast<uint8_t>(next() % layers);
+                float depth = static_cast<float>(next() % 1024) / 1024.0f;
+                uint32_t material = next() % materials;
+
+                if (material < textures.size())
+                    Renderer2D::DrawSprite(x, y, 32.0f, 32.0f, textures[material], 0xFFFFFFFFu, layer, depth);
+                else
+                    Renderer2D::DrawQuad(x, y, 32.0f, 32.0f, 0xFF8040C0u, layer, depth);
+            }
+
+            Clock::time_point recorded = Clock::now();
+            Renderer2D::EndScene();
+            Clock::time_point end = Clock::now();
+
+            if (frame == 0)
+                continue;
+
+            const Renderer2DStats& stats = Renderer2D::GetStats();
+            submitMilliseconds += std::chrono::duration<double, std::milli>(recorded - start).count();
+            sortMilliseconds += stats.SortMilliseconds;
+            buildMilliseconds += stats.BuildMilliseconds;
+            frameMilliseconds += std::chrono::duration<double, std::milli>(end - start).count();
+
+            result.Batches = stats.Batches;
+            result.DrawCalls = stats.DrawCalls;
+            result.Vertices = stats.Vertices;
+        }
+
+        Renderer2D::Shutdown();
+
+        uint32_t frames = std::max(specification.Frames, 1u);
+        result.SubmitMilliseconds = static_cast<float>(submitMilliseconds / frames);
+        result.SortMilliseconds = static_cast<float>(sortMilliseconds / frames);
+        result.BuildMilliseconds = static_cast<float>(buildMilliseconds / frames);
+        result.FrameMilliseconds = static_cast<float>(frameMilliseconds / frames);
+        result.MillionSpritesPerSecond = result.FrameMilliseconds > 0.0f ? result.Sprites / (result.FrameMilliseconds * 1000.0f) : 0.0f;
+        return result;
+    }
+
+    void Renderer2DBenchmark::LogResult(const std::string& label, const Renderer2DBenchmarkResult& result)
+    {
+        VEX_CORE_INFO("Renderer2D '{0}': {1} sprites, {2} batches, {3} draw calls, {4} vertices",
+            label, result.Sprites, result.Batches, result.DrawCalls, result.Vertices);
+        VEX_CORE_INFO("  ms per frame: submit {0:.2f} sort {1:.2f} build {2:.2f} total {3:.2f} | {4:.1f} M sprites/s",
+            result.SubmitMilliseconds, result.SortMilliseconds, result.BuildMilliseconds, result.FrameMilliseconds, result.MillionSpritesPerSecond);
+    }
+}
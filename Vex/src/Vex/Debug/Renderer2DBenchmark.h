@@ -0,0 +1,53 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <string>
+
+namespace Vex
+{
+    /**
+     * Options for a Renderer2D benchmark.
+     */
+    struct Renderer2DBenchmarkSpecification
+    {
+        uint32_t SpriteCount = 200000;  ///< Sprites per frame.
+        uint32_t Textures = 16;         ///< Sprites pick a texture at random; plain quads make up a further share.
+        uint32_t Layers = 4;
+        uint32_t Frames = 30;           ///< Measured frames.
+        uint32_t Threads = 1;           ///< Threads writing vertices, including the caller.
+    };
+
+    /**
+     * Average cost of one Renderer2D frame.
+     */
+    struct Renderer2DBenchmarkResult
+    {
+        uint32_t Sprites = 0;
+        float SubmitMilliseconds = 0.0f;    ///< Recording the draw commands.
+        float SortMilliseconds = 0.0f;
+        float BuildMilliseconds = 0.0f;     ///< Vertices and draw calls.
+        float FrameMilliseconds = 0.0f;
+        float MillionSpritesPerSecond = 0.0f;
+        uint32_t Batches = 0;
+        uint32_t DrawCalls = 0;
+        uint32_t Vertices = 0;
+    };
+
+    /**
+     * @class Renderer2DBenchmark
+     * @brief Measures the CPU side of Renderer2D with a headless backend.
+     *
+     * Every frame records SpriteCount randomly placed sprites over a few layers and textures, then times
+     * EndScene's sort and build. Renderer2D is re-initialized for the run and shut down afterwards, so do
+     * not run it while the application renders with Renderer2D.
+     */
+    class VEX_API Renderer2DBenchmark
+    {
+    public:
+        static Renderer2DBenchmarkResult Run(const Renderer2DBenchmarkSpecification& specification = Renderer2DBenchmarkSpecification());
+
+        /** Writes a result to the core logger under the given label. */
+        static void LogResult(const std::string& label, const Renderer2DBenchmarkResult& result);
+    };
+}
@@ -0,0 +1,290 @@
+﻿#include "VexPch.h"
+#include "VulkanSmokeTest.h"
+
+#include "Vex/Log.h"
+
+#ifdef VEX_VULKAN
+#include "Vex/Events/ApplicationEvent.h"
+#include "Vex/Renderer/Framebuffer.h"
+#include "Vex/Window.h"
+#include "Platform/Headless/HeadlessWindow.h"
+#include "Platform/Vulkan/VulkanRenderer.h"
+
+#include <cstdlib>
+#include <cstring>
+#endif
+
+namespace Vex
+{
+#ifdef VEX_VULKAN
+    namespace
+    {
+        /**
+         * A buffer with its own memory, destroyed with the test.
+         */
+        class SmokeTestBuffer
+        {
+        public:
+            SmokeTestBuffer(VulkanContext& context, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties)
+                : m_Device(context.GetDevice())
+            {
+                VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+                bufferInfo.size = size;
+                bufferInfo.usage = usage;
+                bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                if (!VulkanCheck(vkCreateBuffer(m_Device, &bufferInfo, nullptr, &m_Buffer), "vkCreateBuffer"))
+                    return;
+
+                VkMemoryRequirements requirements;
+                vkGetBufferMemoryRequirements(m_Device, m_Buffer, &requirements);
+
+                VkMemoryAllocateInfo allocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+                allocateInfo.allocationSize = requirements.size;
+                allocateInfo.memoryTypeIndex = context.FindMemoryType(requirements.memoryTypeBits, properties);
+                if (allocateInfo.memoryTypeIndex == UINT32_MAX ||
+                    !VulkanCheck(vkAllocateMemory(m_Device, &allocateInfo, nullptr, &m_Memory), "vkAllocateMemory"))
+                    return;
+
+                m_Valid = VulkanCheck(vkBindBufferMemory(m_Device, m_Buffer, m_Memory, 0), "vkBindBufferMemory");
+            }
+
+            ~SmokeTestBuffer()
+            {
+                if (m_Buffer)
+                    vkDestroyBuffer(m_Device, m_Buffer, nullptr);
+                if (m_Memory)
+                    vkFreeMemory(m_Device, m_Memory, nullptr);
+            }
+
+            SmokeTestBuffer(const SmokeTestBuffer&) = delete;
+            SmokeTestBuffer& operator=(const SmokeTestBuffer&) = delete;
+
+            bool IsValid() const { return m_Valid; }
+            VkBuffer GetBuffer() const { return m_Buffer; }
+            VkDeviceMemory GetMemory() const { return m_Memory; }
+
+        private:
+            VkDevice m_Device;
+            VkBuffer m_Buffer = VK_NULL_HANDLE;
+            VkDeviceMemory m_Memory = VK_NULL_HANDLE;
+            bool m_Valid = false;
+        };
+
+        /**
+         * Copies the offscreen target, left in TRANSFER_SRC_OPTIMAL by EndFrame(), to host memory and checks
+         * every pixel against the expected RGBA8 colors: quad left of quadRight, clear from there on. The
+         * device must be idle.
+         */
+        bool TargetMatches(VulkanRenderer& renderer, uint32_t quadRight, const uint8_t quad[4], const uint8_t clear[4])
+        {
+            VulkanContext& context = renderer.GetContext();
+            VkDevice device = context.GetDevice();
+            VkExtent2D extent = renderer.GetTargetExtent();
+            VkDeviceSize size = static_cast<VkDeviceSize>(extent.width) * extent.height * 4;
+            if (size == 0)
+                return false;
+
+            SmokeTestBuffer readback(context, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            if (!readback.IsValid())
+                return false;
+
+            VkCommandPoolCreateInfo poolInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+            poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            poolInfo.queueFamilyIndex = context.GetQueueFamily();
+            VkCommandPool pool = VK_NULL_HANDLE;
+            if (!VulkanCheck(vkCreateCommandPool(device, &poolInfo, nullptr, &pool), "vkCreateCommandPool"))
+                return false;
+
+            VkCommandBufferAllocateInfo allocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+            allocateInfo.commandPool = pool;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandBufferCount = 1;
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+            vkAllocateCommandBuffers(device, &allocateInfo, &commandBuffer);
+
+            VkCommandBufferBeginInfo beginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+            VkBufferImageCopy region = {};
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.layerCount = 1;
+            region.imageExtent = { extent.width, extent.height, 1 };
+            vkCmdCopyImageToBuffer(commandBuffer, renderer.GetTargetImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                readback.GetBuffer(), 1, &region);
+
+            VkBufferMemoryBarrier barrier = { VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.buffer = readback.GetBuffer();
+            barrier.size = VK_WHOLE_SIZE;
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+                0, nullptr, 1, &barrier, 0, nullptr);
+            vkEndCommandBuffer(commandBuffer);
+
+            VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+            bool copied = VulkanCheck(vkQueueSubmit(context.GetQueue(), 1, &submitInfo, VK_NULL_HANDLE), "vkQueueSubmit") &&
+                VulkanCheck(vkQueueWaitIdle(context.GetQueue()), "vkQueueWaitIdle");
+            vkDestroyCommandPool(device, pool, nullptr);
+
+            void* mapped = nullptr;
+            if (!copied || !VulkanCheck(vkMapMemory(device, readback.GetMemory(), 0, VK_WHOLE_SIZE, 0, &mapped), "vkMapMemory"))
+                return false;
+
+            // One step of tolerance for how the driver rounds the float clear color
+            const uint8_t* pixels = static_cast<const uint8_t*>(mapped);
+            bool matches = true;
+            for (VkDeviceSize i = 0; i < size && matches; i++)
+            {
+                const uint8_t* expected = (i / 4) % extent.width < quadRight ? quad : clear;
+                matches = std::abs(static_cast<int>(pixels[i]) - static_cast<int>(expected[i % 4])) <= 1;
+            }
+
+            vkUnmapMemory(device, readback.GetMemory());
+            return matches;
+        }
+    }
+
+    VulkanSmokeTestResult VulkanSmokeTest::Run(const VulkanSmokeTestSpecification& specification)
+    {
+        VulkanSmokeTestResult result;
+
+        std::unique_ptr<Window> window(Window::Create(WindowProps("Vulkan Smoke Test", specification.Width, specification.Height, true)));
+        HeadlessWindow* headless = dynamic_cast<HeadlessWindow*>(window.get());
+        if (!headless)
+        {
+            VEX_CORE_ERROR("Vulkan smoke test: no headless window on this platform");
+            return result;
+        }
+
+        uint32_t errorsBefore = VulkanContext::GetValidationErrorCount();
+        uint32_t warningsBefore = VulkanContext::GetValidationWarningCount();
+        {
+            // No pipeline cache: the file is what the time-to-first-frame measurement is about, not this
+            VulkanRendererSpecification rendererSpecification;
+            rendererSpecification.FramesInFlight = specification.FramesInFlight;
+            rendererSpecification.VSync = false;
+
+            VulkanRenderer renderer(*window, rendererSpecification);
+            result.Initialized = renderer.IsValid();
+            if (!result.Initialized)
+            {
+                VEX_CORE_ERROR("Vulkan smoke test: the renderer failed to initialize");
+                return result;
+            }
+
+            result.DeviceName = renderer.GetContext().GetProperties().deviceName;
+            result.ValidationEnabled = renderer.GetContext().IsValidationEnabled();
+
+            // Resizes reach the renderer the way they do in Application: as events from the window
+            window->SetEventCallback([&renderer](Event& e)
+            {
+                EventDispatcher dispatcher(e);
+                dispatcher.Dispatch<WindowResizeEvent>([&renderer](WindowResizeEvent& event)
+                {
+                    renderer.OnWindowResize(event.GetWidth(), event.GetHeight());
+                    return false;
+                });
+            });
+
+            const uint8_t clearColor[4] = { 64, 128, 191, 255 };
+            const uint8_t quadColor[4] = { 255, 0, 0, 255 };
+            renderer.SetClearColor(0.25f, 0.5f, 0.75f, 1.0f);
+
+            // The upload starts with one quad, drawn from the destination buffer, so every frame uses the pipeline
+            uint32_t uploadBytes = std::max<uint32_t>(specification.UploadBytes, 4 * sizeof(QuadVertex));
+            SmokeTestBuffer destination(renderer.GetContext(), uploadBytes,
+                VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            std::vector<uint8_t> uploadData(uploadBytes, 0x5a);
+
+            auto renderFrames = [&](uint32_t width, uint32_t height)
+            {
+                if (width > 0 && height > 0)
+                    result.FramesExpected += specification.FramesPerSize;
+
+                for (uint32_t frame = 0; frame < specification.FramesPerSize; frame++)
+                {
+                    window->OnUpdate();
+                    if (!renderer.BeginFrame())
+                        continue;
+
+                    // The left half of the target, in the corner order DrawQuads() expects
+                    VkExtent2D target = renderer.GetTargetExtent();
+                    float right = static_cast<float>(target.width / 2), bottom = static_cast<float>(target.height);
+                    uint32_t color = PackColor(quadColor[0], quadColor[1], quadColor[2], quadColor[3]);
+                    const QuadVertex quad[4] =
+                    {
+                        { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, color },
+                        { right, 0.0f, 0.0f, 1.0f, 0.0f, color },
+                        { right, bottom, 0.0f, 1.0f, 1.0f, color },
+                        { 0.0f, bottom, 0.0f, 0.0f, 1.0f, color },
+                    };
+                    std::memcpy(uploadData.data(), quad, sizeof(quad));
+
+                    if (destination.IsValid())
+                    {
+                        if (renderer.Upload(destination.GetBuffer(), 0, uploadData.data(), uploadData.size()))
+                            renderer.DrawQuads(destination.GetBuffer(), 0, 1);
+                        else
+                            result.FailedUploads++;
+                    }
+
+                    renderer.EndFrame();
+                    result.FramesRendered++;
+
+                    VkExtent2D extent = renderer.GetTargetExtent();
+                    if (frame == 0 && (extent.width != width || extent.height != height))
+                        result.SizeMismatches++;
+                }
+            };
+
+            renderFrames(specification.Width, specification.Height);
+            for (const auto& [width, height] : specification.Resizes)
+            {
+                headless->InjectResize(width, height);
+                renderFrames(width, height);
+            }
+
+            if (!destination.IsValid())
+                result.FailedUploads++;
+
+            vkDeviceWaitIdle(renderer.GetContext().GetDevice());
+            result.PixelsMatch = result.FramesRendered > 0 &&
+                TargetMatches(renderer, renderer.GetTargetExtent().width / 2, quadColor, clearColor);
+
+            window->SetEventCallback([](Event&) {});
+        }
+
+        // Counted after the renderer is gone, so leaks reported while the device and instance are destroyed fail the test
+        result.ValidationErrors = VulkanContext::GetValidationErrorCount() - errorsBefore;
+        result.ValidationWarnings = VulkanContext::GetValidationWarningCount() - warningsBefore;
+        return result;
+    }
+#else
+    VulkanSmokeTestResult VulkanSmokeTest::Run(const VulkanSmokeTestSpecification&)
+    {
+        VEX_CORE_ERROR("Vulkan smoke test: this build has no Vulkan renderer; generate it with --vulkan");
+        return VulkanSmokeTestResult();
+    }
+#endif
+
+    void VulkanSmokeTest::LogResult(const std::string& label, const VulkanSmokeTestResult& result)
+    {
+        if (!result.Initialized)
+        {
+            VEX_CORE_ERROR("Vulkan smoke test '{0}': failed to initialize", label);
+            return;
+        }
+
+        VEX_CORE_INFO("Vulkan smoke test '{0}' on {1}: {2}", label, result.DeviceName, result.Passed() ? "passed" : "FAILED");
+        VEX_CORE_INFO("  validation {0}: {1} errors, {2} warnings", result.ValidationEnabled ? "enabled" : "NOT enabled",
+            result.ValidationErrors, result.ValidationWarnings);
+        VEX_CORE_INFO("  {0} of {1} frames rendered, {2} size mismatches, {3} failed uploads, pixels {4}",
+            result.FramesRendered, result.FramesExpected, result.SizeMismatches, result.FailedUploads, result.PixelsMatch ? "match" : "DIFFER");
+    }
+}
@@ -0,0 +1,66 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * Options for a Vulkan smoke test.
+     */
+    struct VulkanSmokeTestSpecification
+    {
+        uint32_t Width = 640;
+        uint32_t Height = 360;
+        std::vector<std::pair<uint32_t, uint32_t>> Resizes = { { 1280, 720 }, { 0, 0 }, { 97, 61 }, { 640, 360 } };  ///< 0 x 0 is minimized.
+        uint32_t FramesPerSize = 30;
+        uint32_t UploadBytes = 64 << 10;    ///< Uploaded through the staging ring every frame.
+        uint32_t FramesInFlight = 2;
+    };
+
+    /**
+     * Result of a Vulkan smoke test.
+     */
+    struct VulkanSmokeTestResult
+    {
+        bool Initialized = false;
+        std::string DeviceName;
+        bool ValidationEnabled = false;     ///< The test does not pass without it.
+        uint32_t FramesExpected = 0;        ///< Frames at every size that is not minimized.
+        uint32_t FramesRendered = 0;
+        uint32_t SizeMismatches = 0;        ///< Sizes the offscreen target did not take after the resize.
+        uint32_t FailedUploads = 0;
+        bool PixelsMatch = false;           ///< The final target, read back, holds the quad on its left half and the clear color elsewhere.
+        uint32_t ValidationErrors = 0;      ///< Reported from renderer creation to after its destruction.
+        uint32_t ValidationWarnings = 0;
+
+        bool Passed() const
+        {
+            return Initialized && ValidationEnabled && FramesRendered == FramesExpected && SizeMismatches == 0 &&
+                FailedUploads == 0 && PixelsMatch && ValidationErrors == 0;
+        }
+    };
+
+    /**
+     * @class VulkanSmokeTest
+     * @brief Runs the Vulkan renderer headless, through resizes, under the validation layer.
+     *
+     * Creates a headless window and a VulkanRenderer on it, so the offscreen path is the one exercised,
+     * and renders FramesPerSize frames with an upload each, then injects each resize in turn through the
+     * window and renders again. Each upload carries a quad over the left half of the target, which the
+     * frame draws through the renderer's quad pipeline. At the end the target is copied to host memory and
+     * checked against the quad and clear colors. Meant for a Debug build with --vulkan on a machine without a GPU, using lavapipe:
+     * point VK_ICD_FILENAMES at lvp_icd.x86_64.json and have the Khronos validation layer installed.
+     */
+    class VEX_API VulkanSmokeTest
+    {
+    public:
+        static VulkanSmokeTestResult Run(const VulkanSmokeTestSpecification& specification = VulkanSmokeTestSpecification());
+
+        /** Writes a result to the core logger under the given label. */
+        static void LogResult(const std::string& label, const VulkanSmokeTestResult& result);
+    };
+}
@@ -0,0 +1,169 @@
+﻿#include "VexPch.h"
+#include "VulkanStartupBenchmark.h"
+
+#include "Vex/Log.h"
+
+#ifdef VEX_VULKAN
+#include "Vex/Jobs/JobSystem.h"
+#include "Vex/Window.h"
+#include "Platform/Vulkan/VulkanRenderer.h"
+
+#include <chrono>
+#include <filesystem>
+#endif
+
+namespace Vex
+{
+#ifdef VEX_VULKAN
+    namespace
+    {
+        struct StartupSample
+        {
+            float Milliseconds = 0.0f;
+            float LoadMilliseconds = 0.0f;
+            bool Warm = false;
+            uint32_t ShaderHits = 0;
+            uint32_t ShaderMisses = 0;
+        };
+
+        float Median(std::vector<float> values)
+        {
+            if (values.empty())
+                return 0.0f;
+
+            std::sort(values.begin(), values.end());
+            size_t middle = values.size() / 2;
+            return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) * 0.5f;
+        }
+
+        VulkanStartupBenchmarkTimings Summarize(const std::vector<StartupSample>& samples)
+        {
+            VulkanStartupBenchmarkTimings timings;
+            if (samples.empty())
+                return timings;
+
+            std::vector<float> milliseconds, loadMilliseconds;
+            for (const StartupSample& sample : samples)
+            {
+                milliseconds.push_back(sample.Milliseconds);
+                loadMilliseconds.push_back(sample.LoadMilliseconds);
+                timings.WarmCaches += sample.Warm ? 1 : 0;
+                timings.ShaderHits += sample.ShaderHits;
+                timings.ShaderMisses += sample.ShaderMisses;
+            }
+
+            timings.Runs = static_cast<uint32_t>(samples.size());
+            timings.Median = Median(milliseconds);
+            timings.Min = *std::min_element(milliseconds.begin(), milliseconds.end());
+            timings.Max = *std::max_element(milliseconds.begin(), milliseconds.end());
+            timings.CacheLoadMilliseconds = Median(loadMilliseconds);
+            return timings;
+        }
+    }
+
+    VulkanStartupBenchmarkResult VulkanStartupBenchmark::Run(const VulkanStartupBenchmarkSpecification& specification)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        VulkanStartupBenchmarkResult result;
+
+        std::string cachePath = specification.CachePath;
+        if (cachePath.empty())
+            cachePath = (std::filesystem::temp_directory_path() / "VexStartupBenchmark.bin").string();
+
+        std::unique_ptr<Window> window(Window::Create(WindowProps("Vulkan Startup Benchmark", specification.Width, specification.Height, true)));
+        JobSystem jobSystem(specification.WorkerThreadCount);
+
+        VulkanRendererSpecification rendererSpecification;
+        rendererSpecification.PipelineCachePath = cachePath;
+        rendererSpecification.VSync = false;
+
+        // Returns false if the renderer could not start; the sample is only valid otherwise
+        auto start = [&](StartupSample& sample)
+        {
+            Clock::time_point startTime = Clock::now();
+
+            VulkanRenderer renderer(*window, rendererSpecification, &jobSystem);
+            if (!renderer.IsValid())
+                return false;
+
+            if (specification.CreatePipelines)
+                specification.CreatePipelines(renderer);
+
+            if (renderer.BeginFrame())
+                renderer.EndFrame();
+            vkDeviceWaitIdle(renderer.GetContext().GetDevice());
+
+            sample.Milliseconds = std::chrono::duration<float, std::milli>(Clock::now() - startTime).count();
+
+            const VulkanPipelineCache& cache = renderer.GetPipelineCache();
+            sample.LoadMilliseconds = cache.GetLoadMilliseconds();
+            sample.Warm = cache.IsWarm();
+            sample.ShaderHits = cache.GetShaderHits();
+            sample.ShaderMisses = cache.GetShaderMisses();
+
+            if (result.DeviceName.empty())
+                result.DeviceName = renderer.GetContext().GetProperties().deviceName;
+            return true;
+        };
+
+        std::vector<StartupSample> cold, warm;
+        for (uint32_t run = 0; run < specification.Runs; run++)
+        {
+            std::error_code error;
+            std::filesystem::remove(cachePath, error);
+
+            StartupSample sample;
+            if (!start(sample))
+            {
+                VEX_CORE_ERROR("Vulkan startup benchmark: the renderer failed to initialize");
+                return result;
+            }
+            cold.push_back(sample);
+
+            sample = StartupSample();
+            if (!start(sample))
+            {
+                VEX_CORE_ERROR("Vulkan startup benchmark: the renderer failed to initialize");
+                return result;
+            }
+            warm.push_back(sample);
+        }
+
+        std::error_code error;
+        std::filesystem::remove(cachePath, error);
+
+        result.Initialized = !cold.empty();
+        result.Cold = Summarize(cold);
+        result.Warm = Summarize(warm);
+        return result;
+    }
+#else
+    VulkanStartupBenchmarkResult VulkanStartupBenchmark::Run(const VulkanStartupBenchmarkSpecification&)
+    {
+        VEX_CORE_ERROR("Vulkan startup benchmark: this build has no Vulkan renderer; generate it with --vulkan");
+        return VulkanStartupBenchmarkResult();
+    }
+#endif
+
+    void VulkanStartupBenchmark::LogResult(const std::string& label, const VulkanStartupBenchmarkResult& result)
+    {
+        if (!result.Initialized)
+        {
+            VEX_CORE_ERROR("Vulkan startup '{0}': failed to initialize", label);
+            return;
+        }
+
+        VEX_CORE_INFO("Vulkan startup '{0}' on {1}: ms to first frame", label, result.DeviceName);
+
+        auto logTimings = [](const char* kind, const VulkanStartupBenchmarkTimings& timings)
+        {
+            VEX_CORE_INFO("  {0}: median {1:.1f} (min {2:.1f}, max {3:.1f}) over {4} runs; cache read in {5:.2f} ms, warm in {6} runs, {7} shaders compiled, {8} cached",
+                kind, timings.Median, timings.Min, timings.Max, timings.Runs, timings.CacheLoadMilliseconds, timings.WarmCaches,
+                timings.ShaderMisses, timings.ShaderHits);
+        };
+
+        logTimings("cold", result.Cold);
+        logTimings("warm", result.Warm);
+    }
+}
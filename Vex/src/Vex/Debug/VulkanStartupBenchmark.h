@@ -0,0 +1,78 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <functional>
+#include <string>
+
+namespace Vex
+{
+    class VulkanRenderer;
+
+    /**
+     * Options for a Vulkan time-to-first-frame benchmark.
+     */
+    struct VulkanStartupBenchmarkSpecification
+    {
+        uint32_t Width = 1280;
+        uint32_t Height = 720;
+        uint32_t Runs = 5;                  ///< Cold and warm starts each; one of each per run, cold first.
+        uint32_t WorkerThreadCount = 0;     ///< Job system threads reading the cache file, as in Application; 0 picks one per spare core.
+        std::string CachePath;              ///< Deleted before every cold start; empty uses a file in the temporary directory.
+
+        /**
+         * Creates what the application creates before its first frame: shader modules through
+         * GetPipelineCache().CreateShaderModule() and pipelines with its handle. Timed as part of the start.
+         */
+        std::function<void(VulkanRenderer&)> CreatePipelines;
+    };
+
+    /**
+     * Starts of one kind, in milliseconds from creating the renderer to the first frame having executed.
+     */
+    struct VulkanStartupBenchmarkTimings
+    {
+        uint32_t Runs = 0;
+        float Median = 0.0f;
+        float Min = 0.0f;
+        float Max = 0.0f;
+        float CacheLoadMilliseconds = 0.0f;     ///< Median time the load job spent reading and checking the file.
+        uint32_t WarmCaches = 0;                ///< Starts whose pipeline cache reported itself warm.
+        uint32_t ShaderHits = 0;                ///< Over all starts.
+        uint32_t ShaderMisses = 0;
+    };
+
+    /**
+     * Result of a Vulkan time-to-first-frame benchmark.
+     */
+    struct VulkanStartupBenchmarkResult
+    {
+        bool Initialized = false;
+        std::string DeviceName;
+        VulkanStartupBenchmarkTimings Cold;     ///< No cache file.
+        VulkanStartupBenchmarkTimings Warm;     ///< The file written when the previous cold start shut down.
+    };
+
+    /**
+     * @class VulkanStartupBenchmark
+     * @brief Measures time to first frame with a cold and with a warm pipeline cache.
+     *
+     * Each start creates a VulkanRenderer on a headless window, the way Application does: with the
+     * cache path and a job system that reads the file while the instance and device are created. It then
+     * runs CreatePipelines, renders one frame and waits for the device, so a software driver's time to
+     * execute the frame is included. Destroying the renderer writes the cache, which the next warm start
+     * reads. Cold and warm starts alternate so that drift affects both alike.
+     *
+     * Without CreatePipelines the difference is the renderer's own quad pipeline and its two shaders,
+     * which it creates through the cache, plus reading and checking the file. Needs a build with --vulkan; on a GPU-less machine, point
+     * VK_ICD_FILENAMES at lavapipe's lvp_icd.x86_64.json. Use a Release build: Debug enables validation.
+     */
+    class VEX_API VulkanStartupBenchmark
+    {
+    public:
+        static VulkanStartupBenchmarkResult Run(const VulkanStartupBenchmarkSpecification& specification = VulkanStartupBenchmarkSpecification());
+
+        /** Writes a result to the core logger under the given label. */
+        static void LogResult(const std::string& label, const VulkanStartupBenchmarkResult& result);
+    };
+}
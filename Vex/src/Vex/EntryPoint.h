@@ -1,20 +1,43 @@
 ﻿#pragma once
 
-#ifdef VEX_PLATFORM_WINDOWS
+#if defined(VEX_PLATFORM_WINDOWS) || defined(VEX_PLATFORM_LINUX)
 
-extern Vex::Application* Vex::CreateApplication();
+extern Vex::Application* Vex::CreateApplication(Vex::ApplicationCommandLineArgs args);
+extern Vex::LogSpecification Vex::GetLogSpecification();
 
 int main(int argc, char** argv)
 {
     int a = 500;
 
-    Vex::Log::Init();
+    Vex::Log::Init(Vex::GetLogSpecification());
+    Vex::BinaryLog::Init();
     VEX_CORE_WARN("Testing Logging Vex");
     VEX_INFO("Hello! var={0}", a);
     
-    auto app = Vex::CreateApplication();
+    // `--benchmark [name...]` runs the Debug benchmarks instead of the application
+    if (argc > 1 && std::string(argv[1]) == "--benchmark")
+    {
+        int failures = Vex::BenchmarkRunner::Run(std::vector<std::string>(argv + 2, argv + argc));
+        Vex::BinaryLog::Shutdown();
+        Vex::Log::Shutdown();
+        return failures == 0 ? 0 : 1;
+    }
+    
+    // Traces are only written when VEX_PROFILE_DIR names a directory for them
+    VEX_PROFILE_BEGIN_SESSION("Startup", Vex::Instrumentor::GetSessionPath("Startup"));
+    auto app = Vex::CreateApplication({ argc, argv });
+    VEX_PROFILE_END_SESSION();
+
+    VEX_PROFILE_BEGIN_SESSION("Runtime", Vex::Instrumentor::GetSessionPath("Runtime"));
     app->Run();
+    VEX_PROFILE_END_SESSION();
+
+    VEX_PROFILE_BEGIN_SESSION("Shutdown", Vex::Instrumentor::GetSessionPath("Shutdown"));
     delete app;
+    VEX_PROFILE_END_SESSION();
+
+    Vex::BinaryLog::Shutdown();
+    Vex::Log::Shutdown();
     return 0;
 }
 
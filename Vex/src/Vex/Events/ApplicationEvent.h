@@ -36,14 +36,13 @@ namespace Vex
         unsigned int GetHeight() const { return m_Height; }
 
         /**
-         * @brief Converts the event to a string representation for logging or debugging.
-         * @return A string describing the event (width and height).
+         * @brief Writes the event description straight into the fmt buffer for logging or debugging.
+         * @param out Output iterator of the buffer being formatted into.
+         * @return Iterator past the written text describing the event (width and height).
          */
-        std::string ToString() const override
+        fmt::format_context::iterator FormatTo(fmt::format_context::iterator out) const override
         {
-            std::stringstream ss;
-            ss << "WindowResizeEvent: " << m_Width << ", " << m_Height;
-            return ss.str();
+            return fmt::format_to(out, "WindowResizeEvent: {}, {}", m_Width, m_Height);
         }
 
         EVENT_CLASS_TYPE(WindowResize) ///< Event type for window resize.
@@ -1,5 +1,8 @@
 #pragma once
 #include "Vex/Core.h"
+#include "spdlog/fmt/fmt.h"
+
+#include <chrono>
 
 namespace Vex
 {
@@ -26,9 +29,17 @@ namespace Vex
         MouseButtonPressed,      ///< Triggered when a mouse button is pressed.
         MouseButtonReleased,     ///< Triggered when a mouse button is released.
         MouseMoved,              ///< Triggered when the mouse is moved.
-        MouseScrolled            ///< Triggered when the mouse wheel is scrolled.
+        MouseScrolled,           ///< Triggered when the mouse wheel is scrolled.
+
+        Count                    ///< Number of event types. Not a real event.
     };
 
+    /** Bit of an event type in a mask of event types. */
+    constexpr uint32_t EventTypeBit(EventType type) { return 1u << static_cast<uint32_t>(type); }
+
+    /** Mask containing every event type. */
+    constexpr uint32_t AllEventTypes = ~0u;
+
     /**
      * @brief Enum representing different categories of events.
      *
@@ -76,6 +87,17 @@ namespace Vex
         virtual ~Event() = default; ///< Virtual destructor for polymorphic use.
 
         bool Handled = false; ///< Flag to indicate whether the event has been handled.
+        uint64_t Timestamp = 0; ///< When the underlying input happened, on the Now() clock; 0 if unknown.
+
+        /**
+         * @brief Returns the current time on the clock event timestamps use.
+         * @return Nanoseconds of std::chrono::steady_clock.
+         */
+        static uint64_t Now()
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
 
         /**
          * @brief Gets the event type of this event.
@@ -95,11 +117,31 @@ namespace Vex
          */
         virtual int GetCategoryFlags() const = 0;
 
+        /**
+         * @brief Writes a description of this event into a fmt output buffer.
+         *
+         * This is what the fmt/spdlog formatter for events calls, so logging an event formats it
+         * straight into the logger's buffer, and only if the log level is enabled.
+         * @param out Output iterator of the buffer being formatted into.
+         * @return Iterator past the written text. The base version writes the event's name.
+         */
+        virtual fmt::format_context::iterator FormatTo(fmt::format_context::iterator out) const
+        {
+            return fmt::format_to(out, "{}", GetName());
+        }
+
         /**
          * @brief Converts this event to a string representation.
-         * @return A string representing the event's name.
+         *
+         * Allocates; prefer passing the event itself to a logging macro, e.g. VEX_CORE_TRACE("{0}", e).
+         * @return A string describing the event.
          */
-        virtual std::string ToString() const { return GetName(); }
+        std::string ToString() const
+        {
+            fmt::memory_buffer buffer;
+            FormatTo(fmt::format_context::iterator(buffer));
+            return fmt::to_string(buffer);
+        }
 
         /**
          * @brief Checks if the event is in a given category.
@@ -164,4 +206,17 @@ namespace Vex
     }
 }
 
+/**
+ * @brief fmt formatter for every type derived from Vex::Event.
+ *
+ * Forwards to Event::FormatTo so events can be passed directly to fmt and spdlog without
+ * building an intermediate std::string.
+ */
+template<typename T>
+struct fmt::formatter<T, char, std::enable_if_t<std::is_base_of_v<Vex::Event, T>>>
+{
+    constexpr auto parse(fmt::format_parse_context& ctx) { return ctx.begin(); }
+
+    auto format(const T& e, fmt::format_context& ctx) const { return e.FormatTo(ctx.out()); }
+};
 
@@ -0,0 +1,26 @@
+﻿#include "VexPch.h"
+#include "EventQueue.h"
+
+namespace Vex
+{
+    EventQueue::EventQueue(size_t arenaBlockSize, size_t reserve)
+        : m_Arena(arenaBlockSize)
+    {
+        m_Events.reserve(reserve);
+    }
+
+    EventQueue::~EventQueue()
+    {
+        Clear();
+    }
+
+    void EventQueue::Clear()
+    {
+        // Events live in the arena, so only their destructors run here; the memory is reclaimed by the reset.
+        for (Event* event : m_Events)
+            event->~Event();
+
+        m_Events.clear();
+        m_Arena.Reset();
+    }
+}
@@ -0,0 +1,76 @@
+﻿#pragma once
+
+#include "Event.h"
+#include "Vex/Memory/LinearAllocator.h"
+
+namespace Vex
+{
+    /**
+     * @class EventQueue
+     * @brief Per-frame queue of polymorphic events backed by a linear arena.
+     *
+     * The window pump appends events with Push<T>(), which constructs the event in place inside the
+     * arena. Once per frame the application drains the queue in a single batch, after which the
+     * events are destroyed and the arena is rewound. In steady state neither pushing nor draining
+     * touches the heap.
+     */
+    class VEX_API EventQueue
+    {
+    public:
+        /**
+         * @brief Constructs an empty queue.
+         * @param arenaBlockSize Size in bytes of each arena block holding the events.
+         * @param reserve Number of event slots reserved up front.
+         */
+        explicit EventQueue(size_t arenaBlockSize = 64 * 1024, size_t reserve = 1024);
+        ~EventQueue();
+
+        EventQueue(const EventQueue&) = delete;
+        EventQueue& operator=(const EventQueue&) = delete;
+
+        /**
+         * @brief Constructs an event of type T at the back of the queue.
+         * @tparam T The event type to construct.
+         * @param args Arguments forwarded to the event constructor.
+         * @return Reference to the queued event, valid until the queue is drained or cleared.
+         */
+        template<typename T, typename... Args>
+        T& Push(Args&&... args)
+        {
+            static_assert(std::is_base_of_v<Event, T>, "EventQueue only holds Event types");
+
+            void* memory = m_Arena.Allocate(sizeof(T), alignof(T));
+            T* event = new (memory) T(std::forward<Args>(args)...);
+            m_Events.push_back(event);
+            return *event;
+        }
+
+        /**
+         * @brief Hands every queued event to func in order, then clears the queue.
+         *
+         * Events pushed by func while draining are appended and delivered in the same batch.
+         * @param func Callable invoked as func(Event&).
+         */
+        template<typename F>
+        void Drain(F&& func)
+        {
+            for (size_t i = 0; i < m_Events.size(); i++)
+                func(*m_Events[i]);
+
+            Clear();
+        }
+
+        /** @brief Destroys all queued events and rewinds the arena. */
+        void Clear();
+
+        /** @return Number of events currently queued. */
+        size_t GetSize() const { return m_Events.size(); }
+
+        /** @return True if no events are queued. */
+        bool IsEmpty() const { return m_Events.empty(); }
+
+    private:
+        LinearAllocator m_Arena;        ///< Storage for the event objects themselves.
+        std::vector<Event*> m_Events;   ///< Queued events in push order.
+    };
+}
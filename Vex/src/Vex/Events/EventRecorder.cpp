@@ -0,0 +1,225 @@
+﻿#include "VexPch.h"
+#include "EventRecorder.h"
+
+#include "ApplicationEvent.h"
+#include "KeyEvent.h"
+#include "MouseEvent.h"
+#include "Vex/Log.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace Vex
+{
+    static uint64_t NowNanoseconds()
+    {
+        using namespace std::chrono;
+        return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * Fills the type and payload of a record. Returns false for event types that cannot be recorded.
+     */
+    static bool SerializeEvent(const Event& e, RecordedEvent& record)
+    {
+        record.Type = static_cast<uint16_t>(e.GetEventType());
+        record.Flags = 0;
+        record.Reserved = 0;
+        std::memset(&record.Payload, 0, sizeof(record.Payload));
+
+        switch (e.GetEventType())
+        {
+        case EventType::WindowClose:
+            return true;
+
+        case EventType::WindowResize:
+        {
+            auto& resize = static_cast<const WindowResizeEvent&>(e);
+            record.Payload.Resize = { resize.GetWidth(), resize.GetHeight() };
+            return true;
+        }
+
+        case EventType::KeyPressed:
+        {
+            auto& key = static_cast<const KeyPressedEvent&>(e);
+            record.Payload.Key = { key.GetKeyCode() };
+            record.Flags = key.IsRepeat() ? 1 : 0;
+            return true;
+        }
+
+        case EventType::KeyReleased:
+        case EventType::KeyTyped:
+            record.Payload.Key = { static_cast<const KeyEvent&>(e).GetKeyCode() };
+            return true;
+
+        case EventType::MouseMoved:
+        {
+            auto& move = static_cast<const MouseMovedEvent&>(e);
+            record.Payload.Move = { move.GetX(), move.GetY(), move.GetDeltaX(), move.GetDeltaY() };
+            return true;
+        }
+
+        case EventType::MouseScrolled:
+        {
+            auto& scroll = static_cast<const MouseScrolledEvent&>(e);
+            record.Payload.Scroll = { scroll.GetXOffset(), scroll.GetYOffset() };
+            return true;
+        }
+
+        case EventType::MouseButtonPressed:
+        case EventType::MouseButtonReleased:
+            record.Payload.Button = { static_cast<const MouseButtonEvent&>(e).GetMouseButton() };
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * Reconstructs a recorded event in place inside the queue's arena.
+     */
+    static void DeserializeEvent(const RecordedEvent& record, EventQueue& queue)
+    {
+        const auto& payload = record.Payload;
+
+        switch (static_cast<EventType>(record.Type))
+        {
+        case EventType::WindowClose:         queue.Push<WindowCloseEvent>(); break;
+        case EventType::WindowResize:        queue.Push<WindowResizeEvent>(payload.Resize.Width, payload.Resize.Height); break;
+        case EventType::KeyPressed:          queue.Push<KeyPressedEvent>(static_cast<KeyCode>(payload.Key.KeyCode), record.Flags != 0); break;
+        case EventType::KeyReleased:         queue.Push<KeyReleasedEvent>(static_cast<KeyCode>(payload.Key.KeyCode)); break;
+        case EventType::KeyTyped:            queue.Push<KeyTypedEvent>(static_cast<KeyCode>(payload.Key.KeyCode)); break;
+        case EventType::MouseMoved:          queue.Push<MouseMovedEvent>(payload.Move.X, payload.Move.Y, payload.Move.DeltaX, payload.Move.DeltaY); break;
+        case EventType::MouseScrolled:       queue.Push<MouseScrolledEvent>(payload.Scroll.XOffset, payload.Scroll.YOffset); break;
+        case EventType::MouseButtonPressed:  queue.Push<MouseButtonPressedEvent>(static_cast<MouseCode>(payload.Button.Button)); break;
+        case EventType::MouseButtonReleased: queue.Push<MouseButtonReleasedEvent>(static_cast<MouseCode>(payload.Button.Button)); break;
+        default: break;
+        }
+    }
+
+    EventRecorder::~EventRecorder()
+    {
+        Stop();
+    }
+
+    bool EventRecorder::Start(const std::string& path, uint64_t frame)
+    {
+        Stop();
+
+        m_File = std::fopen(path.c_str(), "wb");
+        if (!m_File)
+        {
+            VEX_CORE_ERROR("Failed to open event recording '{0}'", path);
+            return false;
+        }
+
+        // Records are small; let the C runtime batch them into large writes
+        std::setvbuf(m_File, nullptr, _IOFBF, 256 * 1024);
+
+        RecordingHeader header;
+        std::fwrite(&header, sizeof(header), 1, m_File);
+
+        // Anchored on the starting frame, not the first event, so idle frames at the start are replayed too
+        m_FirstFrame = frame;
+        m_StartTime = NowNanoseconds();
+        m_RecordCount = 0;
+        m_FrameCount = 0;
+
+        VEX_CORE_INFO("Recording events to '{0}'", path);
+        return true;
+    }
+
+    void EventRecorder::Stop(uint64_t endFrame)
+    {
+        if (!m_File)
+            return;
+
+        // Idle frames at the end count as well, so a replay runs exactly as long as the session did
+        RecordingHeader header;
+        header.FrameCount = std::max(endFrame > m_FirstFrame ? endFrame - m_FirstFrame : 0, m_FrameCount);
+
+        std::fseek(m_File, 0, SEEK_SET);
+        std::fwrite(&header, sizeof(header), 1, m_File);
+        std::fclose(m_File);
+        m_File = nullptr;
+
+        VEX_CORE_INFO("Event recording stopped ({0} events over {1} frames)", m_RecordCount, header.FrameCount);
+    }
+
+    void EventRecorder::Record(const Event& e, uint64_t frame)
+    {
+        if (!m_File || frame < m_FirstFrame)
+            return;
+
+        RecordedEvent record;
+        if (!SerializeEvent(e, record))
+            return;
+
+        record.Frame = frame - m_FirstFrame;
+        m_FrameCount = record.Frame + 1;
+        record.Timestamp = NowNanoseconds() - m_StartTime;
+
+        std::fwrite(&record, sizeof(record), 1, m_File);
+        m_RecordCount++;
+    }
+
+    bool EventPlayer::Open(const std::string& path)
+    {
+        Close();
+
+        if (!m_File.Open(path))
+        {
+            VEX_CORE_ERROR("Failed to map event recording '{0}'", path);
+            return false;
+        }
+
+        RecordingHeader header;
+        if (m_File.GetSize() < sizeof(header))
+        {
+            VEX_CORE_ERROR("Event recording '{0}' is truncated", path);
+            Close();
+            return false;
+        }
+
+        std::memcpy(&header, m_File.GetData(), sizeof(header));
+        if (header.Magic != RecordingHeader::MagicValue || header.Version != RecordingHeader::CurrentVersion
+            || header.RecordSize != sizeof(RecordedEvent))
+        {
+            VEX_CORE_ERROR("'{0}' is not a compatible event recording", path);
+            Close();
+            return false;
+        }
+
+        size_t count = (m_File.GetSize() - sizeof(header)) / sizeof(RecordedEvent);
+        m_Cursor = reinterpret_cast<const RecordedEvent*>(m_File.GetData() + sizeof(header));
+        m_End = m_Cursor + count;
+        m_FrameCount = header.FrameCount;
+        m_FramesFed = 0;
+
+        VEX_CORE_INFO("Replaying {0} events over {1} frames from '{2}'", count, m_FrameCount, path);
+        return true;
+    }
+
+    void EventPlayer::Close()
+    {
+        m_File.Close();
+        m_Cursor = m_End = nullptr;
+        m_FrameCount = m_FramesFed = 0;
+    }
+
+    size_t EventPlayer::Feed(uint64_t frame, EventQueue& queue)
+    {
+        size_t count = 0;
+
+        while (m_Cursor != m_End && m_Cursor->Frame <= frame)
+        {
+            DeserializeEvent(*m_Cursor, queue);
+            m_Cursor++;
+            count++;
+        }
+
+        m_FramesFed = std::max(m_FramesFed, frame + 1);
+        return count;
+    }
+}
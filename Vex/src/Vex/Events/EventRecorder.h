@@ -0,0 +1,146 @@
+﻿#pragma once
+
+#include "Event.h"
+#include "EventQueue.h"
+#include "Vex/Memory/MappedFile.h"
+
+#include <cstdio>
+#include <string>
+
+namespace Vex
+{
+    /**
+     * @brief Fixed-size on-disk representation of a single event.
+     *
+     * Recordings are a RecordingHeader followed by a tightly packed array of these, in frame order.
+     */
+    struct RecordedEvent
+    {
+        uint64_t Frame;         ///< Frame the event was dispatched in, relative to the frame the recording started in.
+        uint64_t Timestamp;     ///< Nanoseconds since the start of the recording.
+        uint16_t Type;          ///< The EventType of the recorded event.
+        uint16_t Flags;         ///< Type-specific flags (e.g. key repeat).
+        uint32_t Reserved;
+        union
+        {
+            struct { uint32_t Width, Height; } Resize;
+            struct { uint32_t KeyCode; } Key;
+            struct { float X, Y, DeltaX, DeltaY; } Move;
+            struct { float XOffset, YOffset; } Scroll;
+            struct { uint32_t Button; } Button;
+            uint8_t Raw[16];
+        } Payload;
+    };
+
+    static_assert(sizeof(RecordedEvent) == 40, "RecordedEvent is part of the recording file format");
+
+    /**
+     * @brief Header at the start of every recording file.
+     */
+    struct RecordingHeader
+    {
+        static constexpr uint32_t MagicValue = 0x52584556; ///< "VEXR"
+        static constexpr uint32_t CurrentVersion = 2;
+
+        uint32_t Magic = MagicValue;
+        uint32_t Version = CurrentVersion;
+        uint32_t RecordSize = sizeof(RecordedEvent);
+        uint32_t Reserved = 0;
+        uint64_t FrameCount = 0;    ///< Length of the session in frames, including frames without events; written on Stop.
+    };
+
+    static_assert(sizeof(RecordingHeader) == 24, "RecordingHeader is part of the recording file format");
+
+    /**
+     * @class EventRecorder
+     * @brief Writes every dispatched event to a compact binary file.
+     *
+     * Sits between the window pump and Application::OnEvent so a session can be replayed bit-for-bit
+     * with EventPlayer. Event types without a binary representation are skipped.
+     */
+    class VEX_API EventRecorder
+    {
+    public:
+        EventRecorder() = default;
+        ~EventRecorder();
+
+        EventRecorder(const EventRecorder&) = delete;
+        EventRecorder& operator=(const EventRecorder&) = delete;
+
+        /**
+         * @brief Starts a new recording, replacing any file at the given path.
+         * @param path Path of the recording file.
+         * @param frame Index of the current frame; recorded frames are stored relative to it.
+         * @return True if the file could be opened for writing.
+         */
+        bool Start(const std::string& path, uint64_t frame = 0);
+
+        /**
+         * @brief Writes the session length into the header and closes the recording.
+         * @param endFrame First frame not part of the recording, in the numbering passed to Start and Record;
+         * 0 ends the session with the frame of the last recorded event.
+         */
+        void Stop(uint64_t endFrame = 0);
+
+        /**
+         * @brief Appends an event to the recording.
+         * @param e The event being dispatched.
+         * @param frame Index of the current frame.
+         */
+        void Record(const Event& e, uint64_t frame);
+
+        /** @return True while a recording is open. */
+        bool IsRecording() const { return m_File != nullptr; }
+
+    private:
+        std::FILE* m_File = nullptr;
+        uint64_t m_FirstFrame = 0;
+        uint64_t m_StartTime = 0;
+        uint64_t m_RecordCount = 0;
+        uint64_t m_FrameCount = 0;  ///< Relative frame of the last recorded event, plus one.
+    };
+
+    /**
+     * @class EventPlayer
+     * @brief Replays a recording produced by EventRecorder.
+     *
+     * The file is memory-mapped and events are reconstructed directly into an EventQueue, so playback
+     * performs no per-event allocation and does not involve the window system at all.
+     */
+    class VEX_API EventPlayer
+    {
+    public:
+        /**
+         * @brief Maps a recording for playback.
+         * @param path Path of the recording file.
+         * @return True if the file exists and has a valid header.
+         */
+        bool Open(const std::string& path);
+
+        /** @brief Unmaps the recording. */
+        void Close();
+
+        /**
+         * @brief Pushes every event recorded up to the given frame into the queue.
+         *
+         * Call it once per frame with increasing frames, including frames that have no events.
+         * @param frame Index of the frame being played, relative to the start of playback.
+         * @param queue Queue receiving the reconstructed events.
+         * @return The number of events pushed.
+         */
+        size_t Feed(uint64_t frame, EventQueue& queue);
+
+        /** @return True while a recording is mapped. */
+        bool IsPlaying() const { return m_File.IsOpen(); }
+
+        /** @return True once every recorded event has been fed and the recorded session length has been played. */
+        bool IsFinished() const { return m_Cursor == m_End && m_FramesFed >= m_FrameCount; }
+
+    private:
+        MappedFile m_File;
+        const RecordedEvent* m_Cursor = nullptr;
+        const RecordedEvent* m_End = nullptr;
+        uint64_t m_FrameCount = 0;
+        uint64_t m_FramesFed = 0;   ///< One past the last frame passed to Feed.
+    };
+}
@@ -0,0 +1,41 @@
+﻿#include "VexPch.h"
+#include "EventRegistry.h"
+
+namespace Vex
+{
+    EventRegistry::SubscriptionId EventRegistry::AddHandler(EventType type, HandlerFn invoke, void* context)
+    {
+        SubscriptionId id = m_NextId++;
+        m_Handlers[static_cast<size_t>(type)].push_back({ invoke, context, id });
+        return id;
+    }
+
+    uint32_t EventRegistry::GetEventMask() const
+    {
+        uint32_t mask = 0;
+        for (size_t type = 0; type < m_Handlers.size(); type++)
+        {
+            if (!m_Handlers[type].empty())
+                mask |= EventTypeBit(static_cast<EventType>(type));
+        }
+
+        return mask;
+    }
+
+    void EventRegistry::Unsubscribe(SubscriptionId id)
+    {
+        for (std::vector<Handler>& handlers : m_Handlers)
+        {
+            auto it = std::find_if(handlers.begin(), handlers.end(), [id](const Handler& h) { return h.Id == id; });
+            if (it != handlers.end())
+            {
+                handlers.erase(it);
+                break;
+            }
+        }
+
+        auto owned = std::find_if(m_OwnedCallables.begin(), m_OwnedCallables.end(), [id](const OwnedCallable& c) { return c.Id == id; });
+        if (owned != m_OwnedCallables.end())
+            m_OwnedCallables.erase(owned);
+    }
+}
@@ -0,0 +1,131 @@
+﻿#pragma once
+
+#include "Event.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * @class EventRegistry
+     * @brief Type-indexed table of event handlers.
+     *
+     * Handlers are registered once per event type, keyed by the type's EVENT_CLASS_TYPE static type.
+     * Dispatching an event costs a single GetEventType() call to select the handler array, followed by
+     * a loop over that array's contiguous entries. The loop stops as soon as a handler marks the event
+     * as handled.
+     *
+     * Handlers must not subscribe or unsubscribe while an event is being dispatched.
+     */
+    class VEX_API EventRegistry
+    {
+    public:
+        using SubscriptionId = uint32_t;
+
+        EventRegistry() = default;
+        EventRegistry(const EventRegistry&) = delete;
+        EventRegistry& operator=(const EventRegistry&) = delete;
+
+        /**
+         * @brief Subscribes a callable to events of type T.
+         *
+         * The callable is moved into storage owned by the registry.
+         * @tparam T The event type to handle.
+         * @param func Callable invoked as bool(T&); returning true marks the event as handled.
+         * @return An id that can be passed to Unsubscribe().
+         */
+        template<typename T, typename F>
+        SubscriptionId Subscribe(F&& func)
+        {
+            using Callable = std::decay_t<F>;
+            static_assert(std::is_base_of_v<Event, T>, "EventRegistry only dispatches Event types");
+
+            auto storage = std::make_shared<Callable>(std::forward<F>(func));
+            SubscriptionId id = AddHandler(T::GetStaticType(), &InvokeCallable<T, Callable>, storage.get());
+            m_OwnedCallables.push_back({ id, std::move(storage) });
+            return id;
+        }
+
+        /**
+         * @brief Subscribes a member function to events of type T without any extra storage.
+         * @tparam T The event type to handle.
+         * @tparam Method Pointer to a member function of C with signature bool(T&).
+         * @param instance The object the member function is called on. Must outlive the subscription.
+         * @return An id that can be passed to Unsubscribe().
+         */
+        template<typename T, auto Method, typename C>
+        SubscriptionId Subscribe(C* instance)
+        {
+            static_assert(std::is_base_of_v<Event, T>, "EventRegistry only dispatches Event types");
+            return AddHandler(T::GetStaticType(), &InvokeMethod<T, C, Method>, instance);
+        }
+
+        /**
+         * @brief Removes a handler previously added with Subscribe().
+         * @param id The id returned by Subscribe().
+         */
+        void Unsubscribe(SubscriptionId id);
+
+        /**
+         * @brief Dispatches an event to every handler registered for its type, in subscription order.
+         * @param e The event to dispatch. Dispatch stops once e.Handled is set.
+         * @return True if at least one handler is registered for the event's type.
+         */
+        bool Dispatch(Event& e) const
+        {
+            const std::vector<Handler>& handlers = m_Handlers[static_cast<size_t>(e.GetEventType())];
+
+            for (const Handler& handler : handlers)
+            {
+                if (e.Handled)
+                    break;
+
+                e.Handled |= handler.Invoke(handler.Context, e);
+            }
+
+            return !handlers.empty();
+        }
+
+        /** @return True if any handler is registered for the given event type. */
+        bool HasHandlers(EventType type) const { return !m_Handlers[static_cast<size_t>(type)].empty(); }
+
+        /** @return The EventTypeBit of every type that has at least one handler. */
+        uint32_t GetEventMask() const;
+
+    private:
+        using HandlerFn = bool(*)(void* context, Event& e);
+
+        struct Handler
+        {
+            HandlerFn Invoke;       ///< Type-restoring trampoline.
+            void* Context;          ///< Callable or object instance passed to Invoke.
+            SubscriptionId Id;
+        };
+
+        struct OwnedCallable
+        {
+            SubscriptionId Id;
+            std::shared_ptr<void> Storage;
+        };
+
+        SubscriptionId AddHandler(EventType type, HandlerFn invoke, void* context);
+
+        template<typename T, typename Callable>
+        static bool InvokeCallable(void* context, Event& e)
+        {
+            return (*static_cast<Callable*>(context))(static_cast<T&>(e));
+        }
+
+        template<typename T, typename C, auto Method>
+        static bool InvokeMethod(void* context, Event& e)
+        {
+            return (static_cast<C*>(context)->*Method)(static_cast<T&>(e));
+        }
+
+        std::array<std::vector<Handler>, static_cast<size_t>(EventType::Count)> m_Handlers;
+        std::vector<OwnedCallable> m_OwnedCallables;
+        SubscriptionId m_NextId = 1;
+    };
+}
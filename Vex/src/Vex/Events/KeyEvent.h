@@ -57,14 +57,13 @@ namespace Vex {
         bool IsRepeat() const { return m_IsRepeat; }
 
         /**
-         * @brief Converts the event to a string representation for logging or debugging.
-         * @return A string describing the event, including the key code and repeat status.
+         * @brief Writes the event description straight into the fmt buffer for logging or debugging.
+         * @param out Output iterator of the buffer being formatted into.
+         * @return Iterator past the written text describing the event, including the key code and repeat status.
          */
-        std::string ToString() const override
+        fmt::format_context::iterator FormatTo(fmt::format_context::iterator out) const override
         {
-            std::stringstream ss;
-            ss << "KeyPressedEvent: " << m_KeyCode << " (repeat = " << m_IsRepeat << ")";
-            return ss.str();
+            return fmt::format_to(out, "KeyPressedEvent: {} (repeat = {})", m_KeyCode, m_IsRepeat);
         }
 
         EVENT_CLASS_TYPE(KeyPressed) ///< Event type for key pressed.
@@ -89,14 +88,13 @@ namespace Vex {
             : KeyEvent(keycode) {}
 
         /**
-         * @brief Converts the event to a string representation for logging or debugging.
-         * @return A string describing the event, including the key code.
+         * @brief Writes the event description straight into the fmt buffer for logging or debugging.
+         * @param out Output iterator of the buffer being formatted into.
+         * @return Iterator past the written text describing the event, including the key code.
          */
-        std::string ToString() const override
+        fmt::format_context::iterator FormatTo(fmt::format_context::iterator out) const override
         {
-            std::stringstream ss;
-            ss << "KeyReleasedEvent: " << m_KeyCode;
-            return ss.str();
+            return fmt::format_to(out, "KeyReleasedEvent: {}", m_KeyCode);
         }
 
         EVENT_CLASS_TYPE(KeyReleased) ///< Event type for key released.
@@ -119,14 +117,13 @@ namespace Vex {
             : KeyEvent(keycode) {}
 
         /**
-         * @brief Converts the event to a string representation for logging or debugging.
-         * @return A string describing the event, including the key code.
+         * @brief Writes the event description straight into the fmt buffer for logging or debugging.
+         * @param out Output iterator of the buffer being formatted into.
+         * @return Iterator past the written text describing the event, including the key code.
          */
-        std::string ToString() const override
+        fmt::format_context::iterator FormatTo(fmt::format_context::iterator out) const override
         {
-            std::stringstream ss;
-            ss << "KeyTypedEvent: " << m_KeyCode;
-            return ss.str();
+            return fmt::format_to(out, "KeyTypedEvent: {}", m_KeyCode);
         }
 
         EVENT_CLASS_TYPE(KeyTyped) ///< Event type for key typed.
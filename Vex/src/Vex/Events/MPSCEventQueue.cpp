@@ -0,0 +1,81 @@
+﻿#include "VexPch.h"
+#include "MPSCEventQueue.h"
+
+namespace Vex
+{
+    static size_t RoundUpToPowerOfTwo(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+    MPSCEventQueue::MPSCEventQueue(size_t capacity)
+    {
+        size_t size = RoundUpToPowerOfTwo(std::max<size_t>(capacity, 2));
+
+        m_Slots = std::make_unique<Slot[]>(size);
+        m_Mask = size - 1;
+
+        for (size_t i = 0; i < size; i++)
+            m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MPSCEventQueue::~MPSCEventQueue()
+    {
+        // Destroy anything that was posted but never drained
+        Drain([](Event&) {});
+    }
+
+    MPSCEventQueue::Slot* MPSCEventQueue::ClaimSlot()
+    {
+        size_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            Slot* slot = &m_Slots[pos & m_Mask];
+            size_t sequence = slot->Sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                // Slot is free for this lap: try to take it
+                if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    return slot;
+            }
+            else if (diff < 0)
+            {
+                // The consumer has not released this slot yet: the ring is full
+                return nullptr;
+            }
+            else
+            {
+                // Another producer took it first
+                pos = m_EnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void MPSCEventQueue::Publish(Slot* slot)
+    {
+        // The slot was claimed at position Sequence; Sequence + 1 marks it as readable
+        size_t sequence = slot->Sequence.load(std::memory_order_relaxed);
+        slot->Sequence.store(sequence + 1, std::memory_order_release);
+    }
+
+    MPSCEventQueue::Slot* MPSCEventQueue::PeekSlot()
+    {
+        Slot* slot = &m_Slots[m_DequeuePos & m_Mask];
+        size_t sequence = slot->Sequence.load(std::memory_order_acquire);
+
+        return sequence == m_DequeuePos + 1 ? slot : nullptr;
+    }
+
+    void MPSCEventQueue::Release(Slot* slot)
+    {
+        // Hand the slot to the producer that will claim it on the next lap
+        slot->Sequence.store(m_DequeuePos + m_Mask + 1, std::memory_order_release);
+        m_DequeuePos++;
+    }
+}
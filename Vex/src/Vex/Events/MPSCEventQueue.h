@@ -0,0 +1,129 @@
+﻿#pragma once
+
+#include "Event.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace Vex
+{
+    /**
+     * @class MPSCEventQueue
+     * @brief Bounded, lock-free multi-producer/single-consumer queue of polymorphic events.
+     *
+     * Any thread may Post() events; exactly one thread (the main loop) may Drain() them. Events are
+     * constructed in place inside fixed-size slots of a ring allocated once at construction, so posting
+     * never allocates and never blocks: when the ring is full, Post() fails and returns false.
+     *
+     * Each slot carries a sequence number that tells producers and the consumer whose turn it is,
+     * following Dmitry Vyukov's bounded queue design.
+     */
+    class VEX_API MPSCEventQueue
+    {
+    public:
+        static constexpr size_t MaxEventSize = 112;  ///< Largest event type that fits in a slot.
+
+        /**
+         * @brief Constructs the queue.
+         * @param capacity Number of slots. Rounded up to a power of two.
+         */
+        explicit MPSCEventQueue(size_t capacity = 4096);
+        ~MPSCEventQueue();
+
+        MPSCEventQueue(const MPSCEventQueue&) = delete;
+        MPSCEventQueue& operator=(const MPSCEventQueue&) = delete;
+
+        /**
+         * @brief Constructs an event of type T in the next free slot. Safe to call from any thread.
+         *
+         * The event's Timestamp is set to the time of posting.
+         * @tparam T The event type to post.
+         * @param args Arguments forwarded to the event constructor.
+         * @return False if the queue is full and the event was dropped.
+         */
+        template<typename T, typename... Args>
+        bool Post(Args&&... args)
+        {
+            return PostAt<T>(Event::Now(), std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Like Post(), but keeps a timestamp taken earlier, e.g. by the window that read the input.
+         * @param timestamp The event's Timestamp, on the Event::Now() clock.
+         */
+        template<typename T, typename... Args>
+        bool PostAt(uint64_t timestamp, Args&&... args)
+        {
+            static_assert(std::is_base_of_v<Event, T>, "MPSCEventQueue only holds Event types");
+            static_assert(sizeof(T) <= MaxEventSize && alignof(T) <= alignof(std::max_align_t),
+                "Event type is too large for an MPSCEventQueue slot");
+
+            Slot* slot = ClaimSlot();
+            if (!slot)
+                return false;
+
+            slot->Object = new (slot->Storage) T(std::forward<Args>(args)...);
+            slot->Object->Timestamp = timestamp;
+            Publish(slot);
+            return true;
+        }
+
+        /**
+         * @brief Hands every event published so far to func in order, then destroys it. Consumer thread only.
+         *
+         * At most one ring's worth of events is drained per call, so producers that keep posting
+         * cannot stall the consumer indefinitely.
+         * @param func Callable invoked as func(Event&).
+         * @return The number of events drained.
+         */
+        template<typename F>
+        size_t Drain(F&& func)
+        {
+            size_t count = 0;
+
+            while (count <= m_Mask)
+            {
+                Slot* slot = PeekSlot();
+                if (!slot)
+                    break;
+
+                func(*slot->Object);
+                slot->Object->~Event();
+                Release(slot);
+                count++;
+            }
+
+            return count;
+        }
+
+        /** @return Number of slots in the ring. */
+        size_t GetCapacity() const { return m_Mask + 1; }
+
+    private:
+        struct alignas(64) Slot
+        {
+            std::atomic<size_t> Sequence;
+            Event* Object;  ///< The event constructed in Storage.
+            alignas(std::max_align_t) std::byte Storage[MaxEventSize];
+        };
+
+        /** Reserves a slot for a producer, or returns nullptr if the ring is full. */
+        Slot* ClaimSlot();
+
+        /** Makes a constructed event visible to the consumer. */
+        void Publish(Slot* slot);
+
+        /** Returns the next published slot, or nullptr if none is ready. */
+        Slot* PeekSlot();
+
+        /** Hands a consumed slot back to the producers. */
+        void Release(Slot* slot);
+
+        std::unique_ptr<Slot[]> m_Slots;
+        size_t m_Mask;
+
+        alignas(64) std::atomic<size_t> m_EnqueuePos{ 0 };  ///< Shared by producers.
+        alignas(64) size_t m_DequeuePos = 0;                ///< Owned by the consumer.
+    };
+}
@@ -9,7 +9,9 @@ namespace Vex {
      * @class MouseMovedEvent
      * @brief Represents an event where the mouse is moved.
      * 
-     * This event contains the X and Y coordinates of the mouse at the time of movement.
+     * This event contains the X and Y coordinates of the mouse at the time of movement, along with
+     * the relative motion since the previous position. When mouse coalescing is enabled, a single
+     * event carries the final position and the motion accumulated over all merged events.
      */
     class MouseMovedEvent : public Vex::Event
     {
@@ -18,9 +20,11 @@ namespace Vex {
          * @brief Constructs a MouseMovedEvent with specific X and Y coordinates.
          * @param x The X coordinate of the mouse.
          * @param y The Y coordinate of the mouse.
+         * @param deltaX The relative motion along X since the previous position.
+         * @param deltaY The relative motion along Y since the previous position.
          */
-        MouseMovedEvent(float x, float y)
-            : m_MouseX(x), m_MouseY(y) {}
+        MouseMovedEvent(float x, float y, float deltaX = 0.0f, float deltaY = 0.0f)
+            : m_MouseX(x), m_MouseY(y), m_DeltaX(deltaX), m_DeltaY(deltaY) {}
 
         /**
          * @brief Gets the X coordinate of the mouse.
@@ -35,14 +39,25 @@ namespace Vex {
         float GetY() const { return m_MouseY; }
 
         /**
-         * @brief Converts the event to a string representation.
-         * @return A string describing the mouse move event, including X and Y coordinates.
+         * @brief Gets the relative motion along X.
+         * @return The X distance moved since the previous position.
          */
-        std::string ToString() const override
+        float GetDeltaX() const { return m_DeltaX; }
+
+        /**
+         * @brief Gets the relative motion along Y.
+         * @return The Y distance moved since the previous position.
+         */
+        float GetDeltaY() const { return m_DeltaY; }
+
+        /**
+         * @brief Writes the event description straight into the fmt buffer.
+         * @param out Output iterator of the buffer being formatted into.
+         * @return Iterator past the written text describing the mouse move event, including X and Y coordinates.
+         */
+        fmt::format_context::iterator FormatTo(fmt::format_context::iterator out) const override
         {
-            std::stringstream ss;
-            ss << "MouseMovedEvent: " << m_MouseX << ", " << m_MouseY;
-            return ss.str();
+            return fmt::format_to(out, "MouseMovedEvent: {}, {}", m_MouseX, m_MouseY);
         }
 
         // Specifies the event type for MouseMoved events.
@@ -53,6 +68,7 @@ namespace Vex {
 
     private:
         float m_MouseX, m_MouseY; ///< The X and Y coordinates of the mouse.
+        float m_DeltaX, m_DeltaY; ///< The relative motion since the previous position.
     };
 
     /**
@@ -85,14 +101,13 @@ namespace Vex {
         float GetYOffset() const { return m_YOffset; }
 
         /**
-         * @brief Converts the event to a string representation.
-         * @return A string describing the mouse scroll event, including X and Y offsets.
+         * @brief Writes the event description straight into the fmt buffer.
+         * @param out Output iterator of the buffer being formatted into.
+         * @return Iterator past the written text describing the mouse scroll event, including X and Y offsets.
          */
-        std::string ToString() const override
+        fmt::format_context::iterator FormatTo(fmt::format_context::iterator out) const override
         {
-            std::stringstream ss;
-            ss << "MouseScrolledEvent: " << GetXOffset() << ", " << GetYOffset();
-            return ss.str();
+            return fmt::format_to(out, "MouseScrolledEvent: {}, {}", GetXOffset(), GetYOffset());
         }
 
         // Specifies the event type for MouseScrolled events.
@@ -151,14 +166,13 @@ namespace Vex {
             : MouseButtonEvent(button) {}
 
         /**
-         * @brief Converts the event to a string representation.
-         * @return A string describing the mouse button pressed event, including the button code.
+         * @brief Writes the event description straight into the fmt buffer.
+         * @param out Output iterator of the buffer being formatted into.
+         * @return Iterator past the written text describing the mouse button pressed event, including the button code.
          */
-        std::string ToString() const override
+        fmt::format_context::iterator FormatTo(fmt::format_context::iterator out) const override
         {
-            std::stringstream ss;
-            ss << "MouseButtonPressedEvent: " << m_Button;
-            return ss.str();
+            return fmt::format_to(out, "MouseButtonPressedEvent: {}", m_Button);
         }
 
         // Specifies the event type for MouseButtonPressed events.
@@ -182,14 +196,13 @@ namespace Vex {
             : MouseButtonEvent(button) {}
 
         /**
-         * @brief Converts the event to a string representation.
-         * @return A string describing the mouse button released event, including the button code.
+         * @brief Writes the event description straight into the fmt buffer.
+         * @param out Output iterator of the buffer being formatted into.
+         * @return Iterator past the written text describing the mouse button released event, including the button code.
          */
-        std::string ToString() const override
+        fmt::format_context::iterator FormatTo(fmt::format_context::iterator out) const override
         {
-            std::stringstream ss;
-            ss << "MouseButtonReleasedEvent: " << m_Button;
-            return ss.str();
+            return fmt::format_to(out, "MouseButtonReleasedEvent: {}", m_Button);
         }
 
         // Specifies the event type for MouseButtonReleased events.
@@ -0,0 +1,50 @@
+﻿#include "VexPch.h"
+#include "MouseEventCoalescer.h"
+
+namespace Vex
+{
+    bool MouseEventCoalescer::AddMotion(uint64_t timestamp, float x, float y, float deltaX, float deltaY)
+    {
+        if (!m_Active)
+            return false;
+
+        if (m_HasMotion)
+        {
+            m_Stats.MouseMovedMerged++;
+        }
+        else
+        {
+            m_HasMotion = true;
+            m_MotionTimestamp = timestamp;
+            m_ScrollFirst = m_HasScroll;
+            m_DeltaX = m_DeltaY = 0.0f;
+        }
+
+        m_X = x;
+        m_Y = y;
+        m_DeltaX += deltaX;
+        m_DeltaY += deltaY;
+        return true;
+    }
+
+    bool MouseEventCoalescer::AddScroll(uint64_t timestamp, float xOffset, float yOffset)
+    {
+        if (!m_Active)
+            return false;
+
+        if (m_HasScroll)
+        {
+            m_Stats.MouseScrolledMerged++;
+        }
+        else
+        {
+            m_HasScroll = true;
+            m_ScrollTimestamp = timestamp;
+            m_ScrollX = m_ScrollY = 0.0f;
+        }
+
+        m_ScrollX += xOffset;
+        m_ScrollY += yOffset;
+        return true;
+    }
+}
@@ -0,0 +1,92 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <atomic>
+
+namespace Vex
+{
+    /**
+     * Counters reported by windows that coalesce high-frequency mouse events.
+     */
+    struct EventCoalescingStats
+    {
+        uint64_t MouseMovedMerged = 0;      ///< MouseMovedEvents folded into a neighbouring event.
+        uint64_t MouseScrolledMerged = 0;   ///< MouseScrolledEvents folded into a neighbouring event.
+    };
+
+    /**
+     * @class MouseEventCoalescer
+     * @brief Merges consecutive mouse motion and scroll events within one window pump.
+     *
+     * Shared by the window backends. Motion and scroll are held back independently, so both may be
+     * pending at once: motion keeps the latest position and sums the deltas, scroll sums the offsets,
+     * and each keeps the timestamp of its first event. The window flushes before translating any other
+     * event and at the end of the pump, so no event overtakes the ones held back, and the two pending
+     * events come out in the order they started.
+     *
+     * SetEnabled() may be called from any thread. The pumping thread reads the flag once in BeginPump(),
+     * so a change cannot take effect in the middle of a pump.
+     */
+    class VEX_API MouseEventCoalescer
+    {
+    public:
+        /** Enables or disables coalescing from the next pump on. */
+        void SetEnabled(bool enabled) { m_Enabled.store(enabled, std::memory_order_relaxed); }
+
+        /** @return True if coalescing is enabled. */
+        bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+        /** Takes the enabled flag for the pump that is starting. Call on the pumping thread only. */
+        void BeginPump() { m_Active = m_Enabled.load(std::memory_order_relaxed); }
+
+        /**
+         * Holds back a mouse motion event while coalescing.
+         * @return False if coalescing is off for this pump, in which case the caller emits the event itself.
+         */
+        bool AddMotion(uint64_t timestamp, float x, float y, float deltaX, float deltaY);
+
+        /**
+         * Holds back a mouse scroll event while coalescing.
+         * @return False if coalescing is off for this pump, in which case the caller emits the event itself.
+         */
+        bool AddScroll(uint64_t timestamp, float xOffset, float yOffset);
+
+        /**
+         * Emits the held-back events, in the order they started, and clears them.
+         * @param emitMotion Called as (timestamp, x, y, deltaX, deltaY) for a pending motion event.
+         * @param emitScroll Called as (timestamp, xOffset, yOffset) for a pending scroll event.
+         */
+        template<typename MotionFn, typename ScrollFn>
+        void Flush(MotionFn&& emitMotion, ScrollFn&& emitScroll)
+        {
+            if (m_HasScroll && m_ScrollFirst)
+                emitScroll(m_ScrollTimestamp, m_ScrollX, m_ScrollY);
+
+            if (m_HasMotion)
+                emitMotion(m_MotionTimestamp, m_X, m_Y, m_DeltaX, m_DeltaY);
+
+            if (m_HasScroll && !m_ScrollFirst)
+                emitScroll(m_ScrollTimestamp, m_ScrollX, m_ScrollY);
+
+            m_HasMotion = m_HasScroll = m_ScrollFirst = false;
+        }
+
+        /** @return How many events have been merged away so far. */
+        const EventCoalescingStats& GetStats() const { return m_Stats; }
+
+    private:
+        std::atomic<bool> m_Enabled{ false };   ///< May be set from any thread.
+        bool m_Active = false;                  ///< m_Enabled as read at the start of the current pump.
+
+        bool m_HasMotion = false, m_HasScroll = false;
+        bool m_ScrollFirst = false;             ///< True if the pending scroll started before the pending motion.
+        float m_X = 0.0f, m_Y = 0.0f;           ///< Latest mouse position.
+        float m_DeltaX = 0.0f, m_DeltaY = 0.0f; ///< Motion accumulated across merged events.
+        float m_ScrollX = 0.0f, m_ScrollY = 0.0f;   ///< Scroll offsets accumulated across merged events.
+        uint64_t m_MotionTimestamp = 0;         ///< Timestamp of the first merged motion event.
+        uint64_t m_ScrollTimestamp = 0;         ///< Timestamp of the first merged scroll event.
+
+        EventCoalescingStats m_Stats;
+    };
+}
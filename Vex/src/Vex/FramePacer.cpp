@@ -0,0 +1,85 @@
+﻿#include "VexPch.h"
+#include "FramePacer.h"
+
+#include <cmath>
+#include <thread>
+
+namespace Vex
+{
+    FramePacer::FramePacer(double targetFrameRate)
+    {
+#ifdef VEX_PLATFORM_WINDOWS
+        // Raise the scheduler resolution to 1 ms so short sleeps are not rounded up to ~15.6 ms
+        timeBeginPeriod(1);
+#endif
+        SetTargetFrameRate(targetFrameRate);
+    }
+
+    FramePacer::~FramePacer()
+    {
+#ifdef VEX_PLATFORM_WINDOWS
+        timeEndPeriod(1);
+#endif
+    }
+
+    void FramePacer::SetTargetFrameRate(double targetFrameRate)
+    {
+        m_TargetFrameRate = targetFrameRate > 0.0 ? targetFrameRate : 0.0;
+        m_FrameDuration = m_TargetFrameRate > 0.0
+            ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_TargetFrameRate))
+            : Clock::duration::zero();
+        m_NextFrame = Clock::now() + m_FrameDuration;
+    }
+
+    void FramePacer::Wait()
+    {
+        if (m_TargetFrameRate <= 0.0)
+            return;
+
+        Clock::time_point now = Clock::now();
+
+        if (now < m_NextFrame)
+        {
+            SleepUntilNear(m_NextFrame);
+
+            // Spin for the last stretch; sleeping here would overshoot the deadline
+            while (Clock::now() < m_NextFrame)
+                std::this_thread::yield();
+
+            m_NextFrame += m_FrameDuration;
+        }
+        else
+        {
+            // Missed the deadline: don't try to catch up with a burst of short frames
+            m_NextFrame = now + m_FrameDuration;
+        }
+    }
+
+    void FramePacer::SleepUntilNear(Clock::time_point deadline)
+    {
+        while (true)
+        {
+            double remaining = std::chrono::duration<double>(deadline - Clock::now()).count();
+            if (remaining <= m_SleepEstimate)
+                break;
+
+            Clock::time_point start = Clock::now();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            double observed = std::chrono::duration<double>(Clock::now() - start).count();
+
+            // Update the running mean and variance of how long a 1 ms sleep really takes
+            m_SleepCount++;
+            double delta = observed - m_SleepMean;
+            m_SleepMean += delta / static_cast<double>(m_SleepCount);
+            m_SleepM2 += delta * (observed - m_SleepMean);
+            m_SleepEstimate = m_SleepMean + std::sqrt(m_SleepM2 / static_cast<double>(m_SleepCount - 1));
+
+            // Keep the statistics responsive to changes in scheduler behaviour
+            if (m_SleepCount > 1000)
+            {
+                m_SleepCount = 1;
+                m_SleepM2 = 0.0;
+            }
+        }
+    }
+}
@@ -0,0 +1,59 @@
+﻿#pragma once
+
+#include "Core.h"
+
+#include <chrono>
+
+namespace Vex
+{
+    /**
+     * Holds the main loop to a target frame rate without burning a core.
+     *
+     * Waiting is split into two phases: the pacer sleeps in short slices while the remaining time is larger
+     * than its running estimate of how long a slice really takes (mean plus one standard deviation), then
+     * spins for the last fraction of a millisecond so the frame starts on time.
+     */
+    class VEX_API FramePacer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * Creates a pacer.
+         * @param targetFrameRate Frames per second to hold; 0 disables pacing.
+         */
+        explicit FramePacer(double targetFrameRate = 0.0);
+        ~FramePacer();
+
+        FramePacer(const FramePacer&) = delete;
+        FramePacer& operator=(const FramePacer&) = delete;
+
+        /**
+         * Changes the target frame rate. 0 disables pacing.
+         */
+        void SetTargetFrameRate(double targetFrameRate);
+
+        /** Returns the target frame rate, or 0 if pacing is disabled. */
+        double GetTargetFrameRate() const { return m_TargetFrameRate; }
+
+        /**
+         * Blocks until the start of the next frame. Call once at the end of every frame.
+         * If the frame overran its budget the schedule restarts from now instead of trying to catch up.
+         */
+        void Wait();
+
+    private:
+        /** Sleeps in short slices until the remaining time drops below the sleep estimate. */
+        void SleepUntilNear(Clock::time_point deadline);
+
+        double m_TargetFrameRate = 0.0;
+        Clock::duration m_FrameDuration{};
+        Clock::time_point m_NextFrame;
+
+        // Running statistics of observed sleep slice durations, in seconds (Welford's algorithm)
+        double m_SleepEstimate = 0.002;
+        double m_SleepMean = 0.002;
+        double m_SleepM2 = 0.0;
+        uint64_t m_SleepCount = 1;
+    };
+}
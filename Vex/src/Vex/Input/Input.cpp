@@ -0,0 +1,93 @@
+﻿#include "VexPch.h"
+#include "Input.h"
+
+#include "Vex/Events/KeyEvent.h"
+#include "Vex/Events/MouseEvent.h"
+
+#include <cstring>
+
+namespace Vex
+{
+    InputState Input::s_State;
+
+    void Input::BeginFrame()
+    {
+        std::memcpy(s_State.PreviousKeys, s_State.Keys, sizeof(s_State.Keys));
+        s_State.PreviousMouseButtons = s_State.MouseButtons;
+
+        s_State.MouseDeltaX = s_State.MouseDeltaY = 0.0f;
+        s_State.ScrollX = s_State.ScrollY = 0.0f;
+    }
+
+    void Input::UpdateKey(uint32_t scancode, bool pressed)
+    {
+        if (scancode >= InputState::ScancodeCount)
+            return;
+
+        uint64_t mask = 1ull << (scancode & 63);
+        uint64_t& word = s_State.Keys[scancode >> 6];
+        word = pressed ? (word | mask) : (word & ~mask);
+    }
+
+    void Input::UpdateMouseButton(MouseCode button, bool pressed)
+    {
+        if (button >= 32)
+            return;
+
+        uint32_t mask = 1u << button;
+        s_State.MouseButtons = pressed ? (s_State.MouseButtons | mask) : (s_State.MouseButtons & ~mask);
+    }
+
+    void Input::UpdateMousePosition(float x, float y, float deltaX, float deltaY)
+    {
+        s_State.MouseX = x;
+        s_State.MouseY = y;
+        s_State.MouseDeltaX += deltaX;
+        s_State.MouseDeltaY += deltaY;
+    }
+
+    void Input::UpdateScroll(float xOffset, float yOffset)
+    {
+        s_State.ScrollX += xOffset;
+        s_State.ScrollY += yOffset;
+    }
+
+    void Input::ApplyEvent(const Event& e)
+    {
+        switch (e.GetEventType())
+        {
+        case EventType::KeyPressed:
+            UpdateKey(GetScancode(static_cast<const KeyEvent&>(e).GetKeyCode()), true);
+            break;
+
+        case EventType::KeyReleased:
+            UpdateKey(GetScancode(static_cast<const KeyEvent&>(e).GetKeyCode()), false);
+            break;
+
+        case EventType::MouseMoved:
+        {
+            auto& move = static_cast<const MouseMovedEvent&>(e);
+            UpdateMousePosition(move.GetX(), move.GetY(), move.GetDeltaX(), move.GetDeltaY());
+            break;
+        }
+
+        case EventType::MouseScrolled:
+        {
+            auto& scroll = static_cast<const MouseScrolledEvent&>(e);
+            UpdateScroll(scroll.GetXOffset(), scroll.GetYOffset());
+            break;
+        }
+
+        case EventType::MouseButtonPressed:
+            UpdateMouseButton(static_cast<const MouseButtonEvent&>(e).GetMouseButton(), true);
+            break;
+
+        case EventType::MouseButtonReleased:
+            UpdateMouseButton(static_cast<const MouseButtonEvent&>(e).GetMouseButton(), false);
+            break;
+
+        default:
+            break;
+        }
+    }
+}
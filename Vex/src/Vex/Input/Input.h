@@ -0,0 +1,148 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Vex/Input/KeyCodes.h"
+#include "Vex/Input/MouseCodes.h"
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+namespace Vex
+{
+    class Event;
+
+    /**
+     * Keyboard and mouse state for the current and the previous frame.
+     *
+     * Keys are bits indexed by SDL scancode (the physical key), so the whole keyboard fits in a few
+     * cache lines and comparing the two frames is a single AND-NOT per 64 keys.
+     */
+    struct InputState
+    {
+        static constexpr uint32_t ScancodeCount = 512;  ///< Matches SDL_NUM_SCANCODES.
+        static constexpr uint32_t KeyWordCount = ScancodeCount / 64;
+
+        uint64_t Keys[KeyWordCount] = {};
+        uint64_t PreviousKeys[KeyWordCount] = {};
+
+        uint32_t MouseButtons = 0;          ///< Bit n is set while MouseCode n is held.
+        uint32_t PreviousMouseButtons = 0;
+
+        float MouseX = 0.0f, MouseY = 0.0f;
+        float MouseDeltaX = 0.0f, MouseDeltaY = 0.0f;   ///< Motion accumulated this frame.
+        float ScrollX = 0.0f, ScrollY = 0.0f;           ///< Scrolling accumulated this frame.
+    };
+
+    /**
+     * @class Input
+     * @brief Polling interface to keyboard and mouse state.
+     *
+     * The window updates the state while it pumps OS events, so queries made from layers during the
+     * frame see everything up to that frame's pump. Every query is a table lookup and a bit test; none
+     * allocate. "Just pressed" and "just released" compare this frame to the previous one, so a tap
+     * shorter than a frame is only visible through events.
+     *
+     * KeyCode queries refer to the physical key that produces that key code on a US layout, which keeps
+     * WASD-style bindings in place on other layouts. Main thread only.
+     */
+    class VEX_API Input
+    {
+    public:
+        static bool IsKeyPressed(KeyCode key) { return TestBit(s_State.Keys, GetScancode(key)); }
+        static bool IsKeyJustPressed(KeyCode key) { return TestChange(s_State.Keys, s_State.PreviousKeys, GetScancode(key)); }
+        static bool IsKeyJustReleased(KeyCode key) { return TestChange(s_State.PreviousKeys, s_State.Keys, GetScancode(key)); }
+
+        static bool IsMouseButtonPressed(MouseCode button) { return TestMouseBit(s_State.MouseButtons, button); }
+        static bool IsMouseButtonJustPressed(MouseCode button) { return TestMouseBit(s_State.MouseButtons & ~s_State.PreviousMouseButtons, button); }
+        static bool IsMouseButtonJustReleased(MouseCode button) { return TestMouseBit(s_State.PreviousMouseButtons & ~s_State.MouseButtons, button); }
+
+        static std::pair<float, float> GetMousePosition() { return { s_State.MouseX, s_State.MouseY }; }
+        static float GetMouseX() { return s_State.MouseX; }
+        static float GetMouseY() { return s_State.MouseY; }
+
+        /** @return Mouse motion accumulated during this frame's pump. */
+        static std::pair<float, float> GetMouseDelta() { return { s_State.MouseDeltaX, s_State.MouseDeltaY }; }
+
+        /** @return Scrolling accumulated during this frame's pump. */
+        static std::pair<float, float> GetScrollDelta() { return { s_State.ScrollX, s_State.ScrollY }; }
+
+        static const InputState& GetState() { return s_State; }
+
+        /**
+         * @brief Maps a key code to the scancode its state is stored under.
+         * @return The scancode, or 0 (never set) if the key code has no physical key.
+         */
+        static uint32_t GetScancode(KeyCode key);
+
+        // Called by window backends while pumping events
+
+        /** Rolls the current state into the previous frame and clears the per-frame deltas. */
+        static void BeginFrame();
+
+        static void UpdateKey(uint32_t scancode, bool pressed);
+        static void UpdateMouseButton(MouseCode button, bool pressed);
+        static void UpdateMousePosition(float x, float y, float deltaX, float deltaY);
+        static void UpdateScroll(float xOffset, float yOffset);
+
+        /**
+         * Updates the state from an already translated event, for windows pumped on another thread.
+         * Keys go through GetScancode, so they land on their US-layout position.
+         */
+        static void ApplyEvent(const Event& e);
+
+    private:
+        static bool TestBit(const uint64_t* words, uint32_t bit)
+        {
+            return (words[bit >> 6] >> (bit & 63)) & 1u;
+        }
+
+        /** True if the bit is set in set and clear in clear. */
+        static bool TestChange(const uint64_t* set, const uint64_t* clear, uint32_t bit)
+        {
+            return ((set[bit >> 6] & ~clear[bit >> 6]) >> (bit & 63)) & 1u;
+        }
+
+        /** Codes past bit 31 are never tracked, so they read as released instead of shifting out of range. */
+        static bool TestMouseBit(uint32_t buttons, MouseCode button)
+        {
+            return button < 32 && ((buttons >> button) & 1u);
+        }
+
+        /** US layout positions of the keys that produce ASCII key codes. */
+        static constexpr std::array<uint8_t, 128> BuildAsciiScancodes()
+        {
+            std::array<uint8_t, 128> table = {};
+
+            for (int c = 'a'; c <= 'z'; c++)
+                table[c] = table[c - 'a' + 'A'] = static_cast<uint8_t>(4 + c - 'a');
+            for (int c = '1'; c <= '9'; c++)
+                table[c] = static_cast<uint8_t>(30 + c - '1');
+            table['0'] = 39;
+
+            table['\r'] = 40;   table[27] = 41;     table['\b'] = 42;   table['\t'] = 43;
+            table[' '] = 44;    table['-'] = 45;    table['='] = 46;    table['['] = 47;
+            table[']'] = 48;    table['\\'] = 49;   table[';'] = 51;    table['\''] = 52;
+            table['`'] = 53;    table[','] = 54;    table['.'] = 55;    table['/'] = 56;
+            table[127] = 76;
+
+            return table;
+        }
+
+        static InputState s_State;
+    };
+
+    inline uint32_t Input::GetScancode(KeyCode key)
+    {
+        // Keys without a character are already scancode | (1 << 30)
+        constexpr KeyCode scancodeMask = 1u << 30;
+        if (key & scancodeMask)
+        {
+            uint32_t scancode = key & ~scancodeMask;
+            return scancode < InputState::ScancodeCount ? scancode : 0;
+        }
+
+        static constexpr std::array<uint8_t, 128> asciiScancodes = BuildAsciiScancodes();
+        return key < asciiScancodes.size() ? asciiScancodes[key] : 0;
+    }
+}
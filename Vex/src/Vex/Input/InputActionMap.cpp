@@ -0,0 +1,160 @@
+﻿#include "VexPch.h"
+#include "InputActionMap.h"
+
+#include "Vex/Log.h"
+
+namespace Vex
+{
+    InputActionID InputActionMap::AddAction(const std::string& name)
+    {
+        InputActionID existing = FindAction(name);
+        if (existing != InvalidInputID)
+            return existing;
+
+        m_Actions.push_back({ name, {} });
+        m_ActionStates.push_back(0);
+        return static_cast<InputActionID>(m_Actions.size() - 1);
+    }
+
+    InputAxisID InputActionMap::AddAxis(const std::string& name)
+    {
+        InputAxisID existing = FindAxis(name);
+        if (existing != InvalidInputID)
+            return existing;
+
+        m_Axes.push_back({ name, {} });
+        m_AxisValues.push_back(0.0f);
+        return static_cast<InputAxisID>(m_Axes.size() - 1);
+    }
+
+    InputActionID InputActionMap::FindAction(const std::string& name) const
+    {
+        for (size_t i = 0; i < m_Actions.size(); i++)
+        {
+            if (m_Actions[i].Name == name)
+                return static_cast<InputActionID>(i);
+        }
+
+        return InvalidInputID;
+    }
+
+    InputAxisID InputActionMap::FindAxis(const std::string& name) const
+    {
+        for (size_t i = 0; i < m_Axes.size(); i++)
+        {
+            if (m_Axes[i].Name == name)
+                return static_cast<InputAxisID>(i);
+        }
+
+        return InvalidInputID;
+    }
+
+    uint32_t InputActionMap::Bind(InputActionID action, const InputBinding& binding)
+    {
+        return AddBinding(m_Actions, m_ActionTable, action, binding, 1.0f);
+    }
+
+    void InputActionMap::Rebind(InputActionID action, uint32_t bindingIndex, const InputBinding& binding)
+    {
+        BindingSlot& slot = m_Actions[action].Bindings[bindingIndex];
+        slot.Binding = binding;
+        m_ActionTable[slot.Entry].InputBit = ToInputBit(binding);
+    }
+
+    void InputActionMap::Unbind(InputActionID action, uint32_t bindingIndex)
+    {
+        RemoveBinding(m_Actions, m_ActionTable, action, bindingIndex);
+    }
+
+    uint32_t InputActionMap::BindAxis(InputAxisID axis, const InputBinding& binding, float scale)
+    {
+        return AddBinding(m_Axes, m_AxisTable, axis, binding, scale);
+    }
+
+    void InputActionMap::RebindAxis(InputAxisID axis, uint32_t bindingIndex, const InputBinding& binding, float scale)
+    {
+        BindingSlot& slot = m_Axes[axis].Bindings[bindingIndex];
+        slot.Binding = binding;
+
+        TableEntry& entry = m_AxisTable[slot.Entry];
+        entry.InputBit = ToInputBit(binding);
+        entry.Scale = scale;
+    }
+
+    void InputActionMap::UnbindAxis(InputAxisID axis, uint32_t bindingIndex)
+    {
+        RemoveBinding(m_Axes, m_AxisTable, axis, bindingIndex);
+    }
+
+    void InputActionMap::Update(const InputState& state)
+    {
+        // Last frame's down bit becomes this frame's was-down bit
+        for (uint8_t& actionState : m_ActionStates)
+            actionState = static_cast<uint8_t>((actionState & ActionDown) << 1);
+
+        for (const TableEntry& entry : m_ActionTable)
+            m_ActionStates[entry.Target] |= IsInputDown(state, entry.InputBit) ? ActionDown : 0;
+
+        for (float& value : m_AxisValues)
+            value = 0.0f;
+
+        for (const TableEntry& entry : m_AxisTable)
+            m_AxisValues[entry.Target] += IsInputDown(state, entry.InputBit) ? entry.Scale : 0.0f;
+
+        for (float& value : m_AxisValues)
+            value = std::clamp(value, -1.0f, 1.0f);
+    }
+
+    uint16_t InputActionMap::ToInputBit(const InputBinding& binding)
+    {
+        // Bit 0 is the unknown scancode, which is never set, so unmappable bindings simply never fire
+        if (binding.Source == InputBinding::Device::Key)
+            return static_cast<uint16_t>(Input::GetScancode(static_cast<KeyCode>(binding.Code)));
+
+        if (binding.Code >= 32)
+        {
+            VEX_CORE_WARN("Mouse button {0} cannot be bound", binding.Code);
+            return 0;
+        }
+
+        return static_cast<uint16_t>(MouseButtonBitBase + binding.Code);
+    }
+
+    bool InputActionMap::IsInputDown(const InputState& state, uint16_t inputBit)
+    {
+        if (inputBit < MouseButtonBitBase)
+            return (state.Keys[inputBit >> 6] >> (inputBit & 63)) & 1u;
+
+        return (state.MouseButtons >> (inputBit - MouseButtonBitBase)) & 1u;
+    }
+
+    uint32_t InputActionMap::AddBinding(std::vector<Target>& targets, std::vector<TableEntry>& table, uint16_t target, const InputBinding& binding, float scale)
+    {
+        std::vector<BindingSlot>& bindings = targets[target].Bindings;
+        uint32_t bindingIndex = static_cast<uint32_t>(bindings.size());
+
+        bindings.push_back({ binding, static_cast<uint32_t>(table.size()) });
+        table.push_back({ ToInputBit(binding), target, static_cast<uint16_t>(bindingIndex), scale });
+
+        return bindingIndex;
+    }
+
+    void InputActionMap::RemoveBinding(std::vector<Target>& targets, std::vector<TableEntry>& table, uint16_t target, uint32_t bindingIndex)
+    {
+        std::vector<BindingSlot>& bindings = targets[target].Bindings;
+        uint32_t entry = bindings[bindingIndex].Entry;
+
+        // Move the last compiled entry into the gap and point its owner at the new position
+        if (entry != table.size() - 1)
+        {
+            table[entry] = table.back();
+            targets[table[entry].Target].Bindings[table[entry].BindingIndex].Entry = entry;
+        }
+        table.pop_back();
+
+        // Keep the target's bindings in order; only its own later entries need their index fixed
+        bindings.erase(bindings.begin() + bindingIndex);
+        for (uint32_t i = bindingIndex; i < bindings.size(); i++)
+            table[bindings[i].Entry].BindingIndex = static_cast<uint16_t>(i);
+    }
+}
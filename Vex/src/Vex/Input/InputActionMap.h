@@ -0,0 +1,151 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Vex/Input/Input.h"
+
+#include <string>
+#include <vector>
+
+namespace Vex
+{
+    using InputActionID = uint16_t;
+    using InputAxisID = uint16_t;
+
+    constexpr uint16_t InvalidInputID = 0xFFFF;
+
+    /**
+     * A physical input an action or axis can be bound to.
+     */
+    struct InputBinding
+    {
+        enum class Device : uint8_t
+        {
+            Key,
+            MouseButton
+        };
+
+        Device Source = Device::Key;
+        uint32_t Code = 0;  ///< A KeyCode or a MouseCode, depending on Source.
+
+        static InputBinding FromKey(KeyCode key) { return { Device::Key, key }; }
+        static InputBinding FromMouseButton(MouseCode button) { return { Device::MouseButton, button }; }
+
+        bool operator==(const InputBinding& other) const { return Source == other.Source && Code == other.Code; }
+    };
+
+    /**
+     * @class InputActionMap
+     * @brief Named actions (Jump, Fire) and axes (MoveX) resolved from bindings once per frame.
+     *
+     * Names are only looked up while setting the map up. The bindings of all actions, and separately of
+     * all axes, are compiled into a flat table of (input bit, target) entries, where the input bit is the
+     * scancode or mouse button's position in the InputState. Update() is a single sweep over those
+     * tables, after which every query is an array read.
+     *
+     * Rebinding patches the affected table entry in place; unbinding swaps the last entry into the gap.
+     * Nothing is recompiled from scratch.
+     */
+    class VEX_API InputActionMap
+    {
+    public:
+        /** @return The ID of a new action, or of the existing action with that name. */
+        InputActionID AddAction(const std::string& name);
+
+        /** @return The ID of a new axis, or of the existing axis with that name. */
+        InputAxisID AddAxis(const std::string& name);
+
+        /** @return The action's ID, or InvalidInputID if there is none with that name. */
+        InputActionID FindAction(const std::string& name) const;
+
+        /** @return The axis's ID, or InvalidInputID if there is none with that name. */
+        InputAxisID FindAxis(const std::string& name) const;
+
+        /**
+         * @brief Adds a binding to an action. The action is down while any of its bindings is.
+         * @return Index of the binding within the action, for Rebind and Unbind.
+         */
+        uint32_t Bind(InputActionID action, const InputBinding& binding);
+
+        /** @brief Replaces one of an action's bindings, e.g. from a key rebinding menu. */
+        void Rebind(InputActionID action, uint32_t bindingIndex, const InputBinding& binding);
+
+        /** @brief Removes one of an action's bindings; later bindings move down one index. */
+        void Unbind(InputActionID action, uint32_t bindingIndex);
+
+        /**
+         * @brief Adds a binding to an axis. The axis value is the sum of the scales of its held
+         * bindings, clamped to [-1, 1].
+         * @return Index of the binding within the axis, for RebindAxis and UnbindAxis.
+         */
+        uint32_t BindAxis(InputAxisID axis, const InputBinding& binding, float scale);
+
+        /** @brief Replaces one of an axis's bindings and its scale. */
+        void RebindAxis(InputAxisID axis, uint32_t bindingIndex, const InputBinding& binding, float scale);
+
+        /** @brief Removes one of an axis's bindings; later bindings move down one index. */
+        void UnbindAxis(InputAxisID axis, uint32_t bindingIndex);
+
+        /** @brief Resolves every action and axis from the polled input state. Call once per frame. */
+        void Update(const InputState& state);
+
+        bool IsPressed(InputActionID action) const { return m_ActionStates[action] & ActionDown; }
+        bool IsJustPressed(InputActionID action) const { return m_ActionStates[action] == ActionDown; }
+        bool IsJustReleased(InputActionID action) const { return m_ActionStates[action] == ActionWasDown; }
+
+        float GetAxis(InputAxisID axis) const { return m_AxisValues[axis]; }
+
+        const std::string& GetActionName(InputActionID action) const { return m_Actions[action].Name; }
+        const std::string& GetAxisName(InputAxisID axis) const { return m_Axes[axis].Name; }
+
+        /** @return Number of bindings an action or axis has. */
+        uint32_t GetBindingCount(InputActionID action) const { return static_cast<uint32_t>(m_Actions[action].Bindings.size()); }
+        uint32_t GetAxisBindingCount(InputAxisID axis) const { return static_cast<uint32_t>(m_Axes[axis].Bindings.size()); }
+
+        const InputBinding& GetBinding(InputActionID action, uint32_t bindingIndex) const { return m_Actions[action].Bindings[bindingIndex].Binding; }
+        const InputBinding& GetAxisBinding(InputAxisID axis, uint32_t bindingIndex) const { return m_Axes[axis].Bindings[bindingIndex].Binding; }
+
+    private:
+        static constexpr uint8_t ActionDown = 1 << 0;
+        static constexpr uint8_t ActionWasDown = 1 << 1;
+
+        /** First input bit used for mouse buttons; scancodes come before. */
+        static constexpr uint16_t MouseButtonBitBase = InputState::ScancodeCount;
+
+        /** One compiled binding. */
+        struct TableEntry
+        {
+            uint16_t InputBit;      ///< Scancode, or MouseButtonBitBase + button.
+            uint16_t Target;        ///< Action or axis ID.
+            uint16_t BindingIndex;  ///< Position in the target's binding list, to find the way back.
+            float Scale;            ///< Axes only.
+        };
+
+        struct BindingSlot
+        {
+            InputBinding Binding;
+            uint32_t Entry;     ///< Position of the compiled binding in the table.
+        };
+
+        struct Target
+        {
+            std::string Name;
+            std::vector<BindingSlot> Bindings;
+        };
+
+        static uint16_t ToInputBit(const InputBinding& binding);
+
+        static bool IsInputDown(const InputState& state, uint16_t inputBit);
+
+        static uint32_t AddBinding(std::vector<Target>& targets, std::vector<TableEntry>& table, uint16_t target, const InputBinding& binding, float scale);
+        static void RemoveBinding(std::vector<Target>& targets, std::vector<TableEntry>& table, uint16_t target, uint32_t bindingIndex);
+
+        std::vector<Target> m_Actions;
+        std::vector<Target> m_Axes;
+
+        std::vector<TableEntry> m_ActionTable;
+        std::vector<TableEntry> m_AxisTable;
+
+        std::vector<uint8_t> m_ActionStates;    ///< ActionDown | ActionWasDown per action.
+        std::vector<float> m_AxisValues;
+    };
+}
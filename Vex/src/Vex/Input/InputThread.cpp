@@ -0,0 +1,166 @@
+﻿#include "VexPch.h"
+#include "InputThread.h"
+
+#include "Vex/Debug/Instrumentor.h"
+#include "Vex/Events/ApplicationEvent.h"
+#include "Vex/Events/KeyEvent.h"
+#include "Vex/Events/MouseEvent.h"
+#include "Vex/Log.h"
+
+namespace Vex
+{
+    InputThread::InputThread(const WindowProps& props, double pollRate, size_t queueCapacity)
+        : m_Queue(queueCapacity),
+          m_PollPeriod(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double>(1.0 / std::max(pollRate, 1.0))))
+    {
+        m_Thread = std::thread([this, props]() { ThreadLoop(props); });
+
+        // The application needs the window before its first frame
+        m_Ready.wait(false, std::memory_order_acquire);
+
+        if (!m_Window)
+        {
+            m_Thread.join();
+            VEX_CORE_ERROR("Input thread could not create the window");
+            return;
+        }
+
+        VEX_CORE_INFO("Input thread pumping at {0} Hz", pollRate);
+    }
+
+    InputThread::~InputThread()
+    {
+        m_Stop.store(true, std::memory_order_relaxed);
+        if (m_Thread.joinable())
+            m_Thread.join();
+    }
+
+    void InputThread::ThreadLoop(WindowProps props)
+    {
+        props.UpdateInputState = false;
+
+        // An exception must not end the thread before m_Ready is set, or the constructor waits forever
+        try
+        {
+            m_Window = std::unique_ptr<Window>(Window::Create(props));
+        }
+        catch (const std::exception& error)
+        {
+            VEX_CORE_ERROR("Window creation failed on the input thread: {0}", error.what());
+        }
+        catch (...)
+        {
+            VEX_CORE_ERROR("Window creation failed on the input thread");
+        }
+
+        if (m_Window)
+            m_Window->SetEventCallback([this](Event& e) { Forward(e); });
+
+        m_Ready.store(true, std::memory_order_release);
+        m_Ready.notify_one();
+
+        if (!m_Window)
+            return;
+
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point next = Clock::now();
+
+        while (!m_Stop.load(std::memory_order_relaxed))
+        {
+            {
+                VEX_PROFILE_SCOPE("InputThread::Pump");
+                m_Window->OnUpdate();
+            }
+            m_PumpCount.fetch_add(1, std::memory_order_relaxed);
+
+            // Pump on a fixed schedule; after a stall, resume from now rather than bursting to catch up
+            next = std::max(next + m_PollPeriod, Clock::now() - m_PollPeriod);
+            std::this_thread::sleep_until(next);
+        }
+
+        m_Window.reset();
+    }
+
+    void InputThread::Forward(Event& e)
+    {
+        uint64_t timestamp = e.Timestamp;
+
+        auto post = [&](auto&& tryPost)
+        {
+            // Input is never dropped; a full queue means the main thread is behind, so wait for it
+            while (!tryPost())
+            {
+                if (m_Stop.load(std::memory_order_relaxed))
+                    return;
+                std::this_thread::yield();
+            }
+        };
+
+        switch (e.GetEventType())
+        {
+        case EventType::WindowClose:
+            post([&]() { return m_Queue.PostAt<WindowCloseEvent>(timestamp); });
+            break;
+
+        case EventType::WindowResize:
+        {
+            auto& resize = static_cast<WindowResizeEvent&>(e);
+            post([&]() { return m_Queue.PostAt<WindowResizeEvent>(timestamp, resize.GetWidth(), resize.GetHeight()); });
+            break;
+        }
+
+        case EventType::KeyPressed:
+        {
+            auto& key = static_cast<KeyPressedEvent&>(e);
+            post([&]() { return m_Queue.PostAt<KeyPressedEvent>(timestamp, key.GetKeyCode(), key.IsRepeat()); });
+            break;
+        }
+
+        case EventType::KeyReleased:
+        {
+            auto& key = static_cast<KeyReleasedEvent&>(e);
+            post([&]() { return m_Queue.PostAt<KeyReleasedEvent>(timestamp, key.GetKeyCode()); });
+            break;
+        }
+
+        case EventType::KeyTyped:
+        {
+            auto& key = static_cast<KeyTypedEvent&>(e);
+            post([&]() { return m_Queue.PostAt<KeyTypedEvent>(timestamp, key.GetKeyCode()); });
+            break;
+        }
+
+        case EventType::MouseMoved:
+        {
+            auto& move = static_cast<MouseMovedEvent&>(e);
+            post([&]() { return m_Queue.PostAt<MouseMovedEvent>(timestamp, move.GetX(), move.GetY(), move.GetDeltaX(), move.GetDeltaY()); });
+            break;
+        }
+
+        case EventType::MouseScrolled:
+        {
+            auto& scroll = static_cast<MouseScrolledEvent&>(e);
+            post([&]() { return m_Queue.PostAt<MouseScrolledEvent>(timestamp, scroll.GetXOffset(), scroll.GetYOffset()); });
+            break;
+        }
+
+        case EventType::MouseButtonPressed:
+        {
+            MouseCode button = static_cast<MouseButtonEvent&>(e).GetMouseButton();
+            post([&]() { return m_Queue.PostAt<MouseButtonPressedEvent>(timestamp, button); });
+            break;
+        }
+
+        case EventType::MouseButtonReleased:
+        {
+            MouseCode button = static_cast<MouseButtonEvent&>(e).GetMouseButton();
+            post([&]() { return m_Queue.PostAt<MouseButtonReleasedEvent>(timestamp, button); });
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+}
@@ -0,0 +1,84 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Vex/Events/MPSCEventQueue.h"
+#include "Vex/Window.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace Vex
+{
+    /**
+     * @class InputThread
+     * @brief Owns the window on a dedicated thread that pumps OS events at a fixed high rate.
+     *
+     * With the main thread pumping once per frame, input is only sampled at the frame rate and a slow
+     * frame delays everything behind it. Here the window is pumped every 1 / pollRate seconds instead,
+     * each event keeps the timestamp the window gave it, and events reach the main thread through a
+     * lock-free queue in the order they happened.
+     *
+     * SDL on Windows ties a window's message queue to the thread that created it, so the window is
+     * created, pumped and destroyed on this thread, never on the main thread. The window does not update
+     * the Input polling state itself; the main thread applies drained events with Input::ApplyEvent.
+     * Other threads may only use the window's thread-safe members (e.g. HeadlessWindow injection) while
+     * the input thread runs.
+     */
+    class VEX_API InputThread
+    {
+    public:
+        /**
+         * @brief Starts the thread and waits until it has created the window, or failed to.
+         *
+         * If the window could not be created the error is logged, the thread has already exited and
+         * IsValid() returns false; nothing but destruction may follow then.
+         * @param props Properties of the window to create.
+         * @param pollRate Pumps per second.
+         * @param queueCapacity Events that may be waiting for the main thread before the pump stalls.
+         */
+        InputThread(const WindowProps& props, double pollRate = 1000.0, size_t queueCapacity = 4096);
+
+        /** Stops the thread, which destroys the window. */
+        ~InputThread();
+
+        InputThread(const InputThread&) = delete;
+        InputThread& operator=(const InputThread&) = delete;
+
+        /** @return False if the thread failed to create the window. */
+        bool IsValid() const { return m_Window != nullptr; }
+
+        /** Returns the window owned by the thread. */
+        Window& GetWindow() { return *m_Window; }
+
+        /**
+         * @brief Hands every event pumped so far to func in order. Main thread only.
+         * @param func Callable invoked as func(Event&).
+         * @return The number of events drained.
+         */
+        template<typename F>
+        size_t Drain(F&& func)
+        {
+            return m_Queue.Drain(std::forward<F>(func));
+        }
+
+        /** @return Number of times the window has been pumped. */
+        uint64_t GetPumpCount() const { return m_PumpCount.load(std::memory_order_relaxed); }
+
+    private:
+        void ThreadLoop(WindowProps props);
+
+        /** Copies a window event into the queue, waiting for the main thread if the queue is full. */
+        void Forward(Event& e);
+
+        MPSCEventQueue m_Queue;
+        std::chrono::steady_clock::duration m_PollPeriod;
+
+        std::unique_ptr<Window> m_Window;   ///< Created and destroyed by the input thread.
+        std::atomic<bool> m_Ready{ false };     ///< Set once the window exists or creating it failed.
+        std::atomic<bool> m_Stop{ false };
+        std::atomic<uint64_t> m_PumpCount{ 0 };
+        std::thread m_Thread;
+    };
+}
@@ -2,7 +2,11 @@
 
 namespace Vex
 {
-    using KeyCode = uint16_t;
+    /**
+     * SDL2 keycode. Keys that produce a character use that character; every other key is its
+     * scancode with bit 30 set, so values go well beyond 16 bits.
+     */
+    using KeyCode = uint32_t;
 
     namespace Key
     {
@@ -58,74 +62,74 @@ namespace Vex
             Z                   = 122,  // Z
 
             LeftBracket         = 91,   // [
-            Backslash           = 92,   // \
+            Backslash           = 92,   // Backslash
             RightBracket        = 93,   // ]
             GraveAccent         = 96,   // `
 
-            World1              = 161,  // non-US #1
-            World2              = 162,  // non-US #2
+            World1              = 1073741874,   // non-US #1
+            World2              = 1073741924,   // non-US #2
 
-            // Function keys
+            // Function keys. Keys without a character use SDL's scancode | (1 << 30) encoding.
             Escape              = 27,   // Escape
             Enter               = 13,   // Enter
             Tab                 = 9,    // Tab
             Backspace           = 8,    // Backspace
-            Insert              = 277,  // Insert
+            Insert              = 1073741897,   // Insert
             Delete              = 127,  // Delete
-            Right               = 275,  // Right Arrow
-            Left                = 276,  // Left Arrow
-            Down                = 274,  // Down Arrow
-            Up                  = 273,  // Up Arrow
-            PageUp              = 280,  // Page Up
-            PageDown            = 281,  // Page Down
-            Home                = 278,  // Home
-            End                 = 279,  // End
-            CapsLock            = 304,  // Caps Lock
-            ScrollLock          = 305,  // Scroll Lock
-            NumLock             = 300,  // Num Lock
-            PrintScreen         = 316,  // Print Screen
-            Pause               = 19,   // Pause
-            F1                  = 282,  // F1
-            F2                  = 283,  // F2
-            F3                  = 284,  // F3
-            F4                  = 285,  // F4
-            F5                  = 286,  // F5
-            F6                  = 287,  // F6
-            F7                  = 288,  // F7
-            F8                  = 289,  // F8
-            F9                  = 290,  // F9
-            F10                 = 291,  // F10
-            F11                 = 292,  // F11
-            F12                 = 293,  // F12
+            Right               = 1073741903,   // Right Arrow
+            Left                = 1073741904,   // Left Arrow
+            Down                = 1073741905,   // Down Arrow
+            Up                  = 1073741906,   // Up Arrow
+            PageUp              = 1073741899,   // Page Up
+            PageDown            = 1073741902,   // Page Down
+            Home                = 1073741898,   // Home
+            End                 = 1073741901,   // End
+            CapsLock            = 1073741881,   // Caps Lock
+            ScrollLock          = 1073741895,   // Scroll Lock
+            NumLock             = 1073741907,   // Num Lock
+            PrintScreen         = 1073741894,   // Print Screen
+            Pause               = 1073741896,   // Pause
+            F1                  = 1073741882,   // F1
+            F2                  = 1073741883,   // F2
+            F3                  = 1073741884,   // F3
+            F4                  = 1073741885,   // F4
+            F5                  = 1073741886,   // F5
+            F6                  = 1073741887,   // F6
+            F7                  = 1073741888,   // F7
+            F8                  = 1073741889,   // F8
+            F9                  = 1073741890,   // F9
+            F10                 = 1073741891,   // F10
+            F11                 = 1073741892,   // F11
+            F12                 = 1073741893,   // F12
 
             // Keypad keys
-            KP0                 = 320,  // Numpad 0
-            KP1                 = 321,  // Numpad 1
-            KP2                 = 322,  // Numpad 2
-            KP3                 = 323,  // Numpad 3
-            KP4                 = 324,  // Numpad 4
-            KP5                 = 325,  // Numpad 5
-            KP6                 = 326,  // Numpad 6
-            KP7                 = 327,  // Numpad 7
-            KP8                 = 328,  // Numpad 8
-            KP9                 = 329,  // Numpad 9
-            KPDecimal           = 330,  // Numpad .
-            KPDivide            = 331,  // Numpad /
-            KPMultiply          = 332,  // Numpad *
-            KPSubtract          = 333,  // Numpad -
-            KPAdd               = 334,  // Numpad +
-            KPEnter             = 335,  // Numpad Enter
-            KPEqual             = 336,  // Numpad =
+            KP0                 = 1073741922,   // Numpad 0
+            KP1                 = 1073741913,   // Numpad 1
+            KP2                 = 1073741914,   // Numpad 2
+            KP3                 = 1073741915,   // Numpad 3
+            KP4                 = 1073741916,   // Numpad 4
+            KP5                 = 1073741917,   // Numpad 5
+            KP6                 = 1073741918,   // Numpad 6
+            KP7                 = 1073741919,   // Numpad 7
+            KP8                 = 1073741920,   // Numpad 8
+            KP9                 = 1073741921,   // Numpad 9
+            KPDecimal           = 1073741923,   // Numpad .
+            KPDivide            = 1073741908,   // Numpad /
+            KPMultiply          = 1073741909,   // Numpad *
+            KPSubtract          = 1073741910,   // Numpad -
+            KPAdd               = 1073741911,   // Numpad +
+            KPEnter             = 1073741912,   // Numpad Enter
+            KPEqual             = 1073741927,   // Numpad =
 
-            LeftShift           = 303,  // Left Shift
-            LeftControl         = 305,  // Left Control
-            LeftAlt             = 306,  // Left Alt
-            LeftSuper           = 1073742048, // Left Super (Win/Command)
-            RightShift          = 304,  // Right Shift
-            RightControl        = 306,  // Right Control
-            RightAlt            = 307,  // Right Alt
-            RightSuper          = 1073742050, // Right Super (Win/Command)
-            Menu                = 1073742081 // Menu key (sometimes used as "App" key)
+            LeftShift           = 1073742049,   // Left Shift
+            LeftControl         = 1073742048,   // Left Control
+            LeftAlt             = 1073742050,   // Left Alt
+            LeftSuper           = 1073742051,   // Left Super (Win/Command)
+            RightShift          = 1073742053,   // Right Shift
+            RightControl        = 1073742052,   // Right Control
+            RightAlt            = 1073742054,   // Right Alt
+            RightSuper          = 1073742055,   // Right Super (Win/Command)
+            Menu                = 1073741925    // Menu key (sometimes used as "App" key)
         };
     }
 }
@@ -0,0 +1,168 @@
+﻿#include "VexPch.h"
+#include "JobSystem.h"
+
+#include "Vex/Debug/Instrumentor.h"
+#include "Vex/Log.h"
+
+#include <chrono>
+
+namespace Vex
+{
+    // Identifies the job system and worker slot the current thread belongs to
+    static thread_local JobSystem* t_JobSystem = nullptr;
+    static thread_local uint32_t t_WorkerIndex = 0;
+
+    JobSystem::JobSystem(uint32_t workerCount)
+    {
+        if (workerCount == 0)
+        {
+            uint32_t hardwareThreads = std::thread::hardware_concurrency();
+            workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        // Slot 0 belongs to the owning thread, which works while it waits
+        m_Workers.reserve(workerCount + 1);
+        for (uint32_t i = 0; i <= workerCount; i++)
+            m_Workers.push_back(std::make_unique<Worker>());
+
+        // A job system created while another one owns this thread (e.g. a benchmark's) hands it back when destroyed
+        m_PreviousOwner = t_JobSystem;
+        m_PreviousOwnerIndex = t_WorkerIndex;
+
+        t_JobSystem = this;
+        t_WorkerIndex = 0;
+
+        for (uint32_t i = 1; i <= workerCount; i++)
+            m_Workers[i]->Thread = std::thread([this, i]() { WorkerLoop(i); });
+
+        VEX_CORE_INFO("Job system started with {0} worker threads", workerCount);
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_WakeMutex);
+            m_Running.store(false, std::memory_order_release);
+        }
+        m_WakeCondition.notify_all();
+
+        for (size_t i = 1; i < m_Workers.size(); i++)
+            m_Workers[i]->Thread.join();
+
+        if (t_JobSystem == this)
+        {
+            t_JobSystem = m_PreviousOwner;
+            t_WorkerIndex = m_PreviousOwnerIndex;
+        }
+    }
+
+    bool JobSystem::IsWorkerThread() const
+    {
+        return t_JobSystem == this;
+    }
+
+    Job* JobSystem::AllocateJob()
+    {
+        Worker& worker = *m_Workers[t_WorkerIndex];
+        Job* job = &worker.Jobs[worker.NextJob];
+        if (job->Entry.load(std::memory_order_acquire))
+            return nullptr;
+
+        worker.NextJob = (worker.NextJob + 1) & (MaxJobsPerThread - 1);
+        return job;
+    }
+
+    void JobSystem::Schedule(Job* job)
+    {
+        // A full deque falls back to running the job right away
+        if (!m_Workers[t_WorkerIndex]->Queue.Push(job))
+        {
+            Execute(job);
+            return;
+        }
+
+        if (m_SleepingWorkers.load(std::memory_order_acquire) > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_WakeMutex);
+            m_WakeCondition.notify_one();
+        }
+    }
+
+    void JobSystem::Execute(Job* job)
+    {
+        VEX_PROFILE_SCOPE("Job");
+
+        // Read everything needed before the slot is released; its owner may refill it right after
+        JobCounter* counter = job->Counter;
+        job->Entry.load(std::memory_order_relaxed)(*job);
+        job->Entry.store(nullptr, std::memory_order_release);
+
+        if (counter)
+            counter->Pending.fetch_sub(1, std::memory_order_release);
+    }
+
+    Job* JobSystem::FindJob(uint32_t workerIndex)
+    {
+        if (Job* job = m_Workers[workerIndex]->Queue.Pop())
+            return job;
+
+        // Start at the next worker so thieves spread out over the victims
+        uint32_t count = GetThreadCount();
+        for (uint32_t i = 1; i < count; i++)
+        {
+            uint32_t victim = (workerIndex + i) % count;
+            if (Job* job = m_Workers[victim]->Queue.Steal())
+                return job;
+        }
+
+        return nullptr;
+    }
+
+    void JobSystem::Wait(const JobCounter& counter)
+    {
+        while (!counter.IsDone())
+        {
+            Job* job = t_JobSystem == this ? FindJob(t_WorkerIndex) : nullptr;
+            if (job)
+                Execute(job);
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    void JobSystem::WorkerLoop(uint32_t workerIndex)
+    {
+        t_JobSystem = this;
+        t_WorkerIndex = workerIndex;
+
+        // Number of empty polls before a worker goes to sleep
+        constexpr uint32_t spinLimit = 64;
+        uint32_t idleSpins = 0;
+
+        while (m_Running.load(std::memory_order_acquire))
+        {
+            if (Job* job = FindJob(workerIndex))
+            {
+                Execute(job);
+                idleSpins = 0;
+                continue;
+            }
+
+            if (++idleSpins < spinLimit)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // The timeout covers a wakeup racing with the sleeping-worker count
+            std::unique_lock<std::mutex> lock(m_WakeMutex);
+            m_SleepingWorkers.fetch_add(1, std::memory_order_acq_rel);
+            if (m_Running.load(std::memory_order_acquire))
+                m_WakeCondition.wait_for(lock, std::chrono::milliseconds(1));
+            m_SleepingWorkers.fetch_sub(1, std::memory_order_acq_rel);
+            idleSpins = 0;
+        }
+
+        t_JobSystem = nullptr;
+    }
+}
@@ -0,0 +1,185 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Vex/Jobs/WorkStealingDeque.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * Counts outstanding jobs. Every job submitted with a counter increments it and decrements it
+     * when the job finishes; JobSystem::Wait blocks until the count drops back to zero.
+     */
+    struct JobCounter
+    {
+        std::atomic<uint32_t> Pending{ 0 };
+
+        bool IsDone() const { return Pending.load(std::memory_order_acquire) == 0; }
+    };
+
+    /**
+     * A unit of work. The callable is stored inline so submitting a job never allocates.
+     * Sized and aligned to one cache line so neighbouring slots never share one.
+     */
+    struct alignas(64) Job
+    {
+        static constexpr size_t PayloadSize = 48;
+
+        alignas(std::max_align_t) std::byte Payload[PayloadSize];
+        JobCounter* Counter = nullptr;
+        std::atomic<void (*)(Job& job)> Entry{ nullptr };  ///< Invokes and destroys the stored callable; null once the slot is free again.
+    };
+
+    static_assert(sizeof(Job) == 64, "Job must fill exactly one cache line");
+
+    /**
+     * Fixed pool of worker threads executing jobs from per-thread work-stealing deques.
+     *
+     * The thread that creates the JobSystem becomes worker 0 and takes part in the work while it waits on
+     * a counter. Jobs submitted from that thread or from inside another job are queued; jobs submitted from
+     * any other thread run inline.
+     * Each thread owns a ring of MaxJobsPerThread job slots. When the ring wraps around onto a job that
+     * has not finished yet, the new job runs inline instead, so any number of jobs may be submitted.
+     */
+    class VEX_API JobSystem
+    {
+    public:
+        static constexpr size_t MaxJobsPerThread = 4096;
+
+        /**
+         * Starts the worker threads.
+         * @param workerCount Number of threads in addition to the calling one; 0 uses one per remaining hardware thread.
+         */
+        explicit JobSystem(uint32_t workerCount = 0);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /**
+         * Queues a callable for execution on any worker.
+         * @param function Callable taking no arguments; at most Job::PayloadSize bytes.
+         * @param counter Optional counter incremented now and decremented when the job finishes.
+         */
+        template<typename F>
+        void Submit(F&& function, JobCounter* counter = nullptr)
+        {
+            using Callable = std::decay_t<F>;
+            static_assert(sizeof(Callable) <= Job::PayloadSize, "Job callable too large; capture by reference or pointer");
+            static_assert(alignof(Callable) <= alignof(std::max_align_t), "Job callable over-aligned");
+
+            // Threads outside the pool have no deque to push to, and a busy slot cannot be reused; run the work inline
+            Job* job = IsWorkerThread() ? AllocateJob() : nullptr;
+            if (!job)
+            {
+                Callable callable(std::forward<F>(function));
+                callable();
+                return;
+            }
+
+            new (job->Payload) Callable(std::forward<F>(function));
+            job->Counter = counter;
+            job->Entry.store([](Job& self)
+            {
+                Callable* callable = std::launder(reinterpret_cast<Callable*>(self.Payload));
+                (*callable)();
+                callable->~Callable();
+            }, std::memory_order_relaxed);
+
+            if (counter)
+                counter->Pending.fetch_add(1, std::memory_order_relaxed);
+
+            Schedule(job);
+        }
+
+        /**
+         * Splits [0, count) into batches and runs function(begin, end) for each batch in parallel.
+         * Returns immediately; function must stay alive until the counter is done.
+         *
+         * Batches are handed out by splitting the range in halves, so only about log2(batches) jobs per
+         * thread are queued at a time however many batches there are.
+         */
+        template<typename F>
+        void ParallelFor(uint32_t count, uint32_t batchSize, const F& function, JobCounter& counter)
+        {
+            if (count == 0)
+                return;
+
+            batchSize = std::max(batchSize, 1u);
+            Submit([this, &function, &counter, count, batchSize]() { SplitRange(0, count, batchSize, function, counter); }, &counter);
+        }
+
+        /** Splits [0, count) into batches, runs function(begin, end) for each in parallel and waits for all of them. */
+        template<typename F>
+        void ParallelFor(uint32_t count, uint32_t batchSize, const F& function)
+        {
+            JobCounter counter;
+            ParallelFor(count, batchSize, function, counter);
+            Wait(counter);
+        }
+
+        /** Runs queued jobs on the calling thread until the counter reaches zero. */
+        void Wait(const JobCounter& counter);
+
+        /** Returns true if the calling thread is the owning thread or one of the workers. */
+        bool IsWorkerThread() const;
+
+        /** Returns the number of threads executing jobs, including the owning thread. */
+        uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+    private:
+        struct Worker
+        {
+            WorkStealingDeque<Job*> Queue{ MaxJobsPerThread };
+            std::unique_ptr<Job[]> Jobs = std::make_unique<Job[]>(MaxJobsPerThread);
+            size_t NextJob = 0;
+            std::thread Thread;
+        };
+
+        /** Queues the upper half of [begin, end) as a job until one batch is left, then runs that batch. */
+        template<typename F>
+        void SplitRange(uint32_t begin, uint32_t end, uint32_t batchSize, const F& function, JobCounter& counter)
+        {
+            while (end - begin > batchSize)
+            {
+                // Split on a batch boundary so every batch but the last has batchSize elements
+                uint32_t batches = (end - begin - 1) / batchSize + 1;
+                uint32_t middle = begin + batches / 2 * batchSize;
+                Submit([this, &function, &counter, middle, end, batchSize]() { SplitRange(middle, end, batchSize, function, counter); }, &counter);
+                end = middle;
+            }
+
+            function(begin, end);
+        }
+
+        /** @return The calling thread's next free slot, or nullptr if the ring has wrapped onto an unfinished job. */
+        Job* AllocateJob();
+        void Schedule(Job* job);
+        void Execute(Job* job);
+
+        /** Pops from the calling thread's deque, then tries to steal from the others. */
+        Job* FindJob(uint32_t workerIndex);
+        void WorkerLoop(uint32_t workerIndex);
+
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+        std::atomic<bool> m_Running{ true };
+
+        // Idle workers sleep here instead of spinning
+        std::mutex m_WakeMutex;
+        std::condition_variable m_WakeCondition;
+        std::atomic<uint32_t> m_SleepingWorkers{ 0 };
+
+        JobSystem* m_PreviousOwner = nullptr;   ///< Job system the owning thread belonged to before this one.
+        uint32_t m_PreviousOwnerIndex = 0;
+    };
+}
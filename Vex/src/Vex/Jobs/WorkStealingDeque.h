@@ -0,0 +1,116 @@
+﻿#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace Vex
+{
+    /**
+     * @class WorkStealingDeque
+     * @brief Fixed-capacity Chase-Lev work-stealing deque of pointers.
+     *
+     * The owning thread pushes and pops at the bottom (LIFO, cache friendly); any other thread may
+     * steal from the top (FIFO). Follows "Correct and Efficient Work-Stealing for Weak Memory Models"
+     * (Le et al., 2013), with sequentially consistent operations in place of standalone fences.
+     *
+     * @tparam T Pointer type stored in the deque.
+     */
+    template<typename T>
+    class WorkStealingDeque
+    {
+        static_assert(std::is_pointer_v<T>, "WorkStealingDeque stores pointers");
+
+    public:
+        /**
+         * @brief Constructs the deque.
+         * @param capacity Maximum number of items. Must be a power of two.
+         */
+        explicit WorkStealingDeque(size_t capacity = 4096)
+            : m_Buffer(std::make_unique<std::atomic<T>[]>(capacity)), m_Mask(static_cast<int64_t>(capacity) - 1)
+        {
+        }
+
+        /**
+         * @brief Pushes an item at the bottom. Owner thread only.
+         * @return False if the deque is full.
+         */
+        bool Push(T item)
+        {
+            int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+            int64_t top = m_Top.load(std::memory_order_acquire);
+
+            if (bottom - top > m_Mask)
+                return false;
+
+            m_Buffer[bottom & m_Mask].store(item, std::memory_order_relaxed);
+            m_Bottom.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Pops the most recently pushed item. Owner thread only.
+         * @return The item, or nullptr if the deque is empty or the last item was stolen.
+         */
+        T Pop()
+        {
+            int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+            m_Bottom.store(bottom, std::memory_order_seq_cst);
+            int64_t top = m_Top.load(std::memory_order_seq_cst);
+
+            if (top > bottom)
+            {
+                // Empty: restore bottom
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T item = m_Buffer[bottom & m_Mask].load(std::memory_order_relaxed);
+
+            if (top == bottom)
+            {
+                // Last item: race the thieves for it
+                if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    item = nullptr;
+
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return item;
+        }
+
+        /**
+         * @brief Steals the oldest item. Safe to call from any thread.
+         * @return The item, or nullptr if the deque is empty or another thread won the race.
+         */
+        T Steal()
+        {
+            int64_t top = m_Top.load(std::memory_order_seq_cst);
+            int64_t bottom = m_Bottom.load(std::memory_order_seq_cst);
+
+            if (top >= bottom)
+                return nullptr;
+
+            T item = m_Buffer[top & m_Mask].load(std::memory_order_relaxed);
+
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+
+            return item;
+        }
+
+        /** @return An estimate of the number of items; exact only when called by the owner with no thieves active. */
+        size_t GetSizeApprox() const
+        {
+            int64_t size = m_Bottom.load(std::memory_order_relaxed) - m_Top.load(std::memory_order_relaxed);
+            return size > 0 ? static_cast<size_t>(size) : 0;
+        }
+
+    private:
+        std::unique_ptr<std::atomic<T>[]> m_Buffer;
+        int64_t m_Mask;
+
+        alignas(64) std::atomic<int64_t> m_Top{ 0 };
+        alignas(64) std::atomic<int64_t> m_Bottom{ 0 };
+    };
+}
@@ -0,0 +1,10 @@
+﻿#include "VexPch.h"
+#include "Layer.h"
+
+namespace Vex
+{
+    Layer::Layer(const std::string& name)
+        : m_DebugName(name)
+    {
+    }
+}
@@ -0,0 +1,77 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Vex/Events/Event.h"
+#include "Vex/Timestep.h"
+
+#include <string>
+
+namespace Vex
+{
+    /**
+     * Per-layer timing collected by the LayerStack.
+     * "Last" values cover the most recent frame; averages are exponential moving averages over recent frames.
+     */
+    struct LayerStats
+    {
+        float LastUpdateMs = 0.0f;      ///< Time spent in OnUpdate and OnFixedUpdate last frame.
+        float AverageUpdateMs = 0.0f;
+        float LastEventMs = 0.0f;       ///< Time spent in OnEvent last frame, across all events.
+        float AverageEventMs = 0.0f;
+        uint32_t LastEventCount = 0;    ///< Number of events delivered to the layer last frame.
+    };
+
+    /**
+     * A slice of application logic that receives updates and events from the LayerStack.
+     * Layers are updated bottom-up and receive events top-down; overlays always sit above regular layers.
+     */
+    class VEX_API Layer
+    {
+    public:
+        Layer(const std::string& name = "Layer");
+        virtual ~Layer() = default;
+
+        /** Called when the layer is pushed onto the stack. */
+        virtual void OnAttach() {}
+
+        /** Called when the layer is removed from the stack or the stack is destroyed. */
+        virtual void OnDetach() {}
+
+        /** Called once per frame with the time since the previous frame. */
+        virtual void OnUpdate([[maybe_unused]] Timestep ts) {}
+
+        /** Called zero or more times per frame with the fixed simulation step. */
+        virtual void OnFixedUpdate([[maybe_unused]] Timestep step) {}
+
+        /** Called for each event that no layer above this one has handled. */
+        virtual void OnEvent([[maybe_unused]] Event& e) {}
+
+        /** Returns the layer's debug name. */
+        const std::string& GetName() const { return m_DebugName; }
+
+        /** Returns the timing collected for this layer. */
+        const LayerStats& GetStats() const { return m_Stats; }
+
+        /** Returns the event types the layer receives, one EventTypeBit per type; every type by default. */
+        uint32_t GetEventMask() const { return m_EventMask; }
+
+    protected:
+        /**
+         * Restricts OnEvent to the given event types. The window stops producing types that no layer
+         * and no EventRegistry handler asks for, e.g. KeyTyped while no layer takes text input.
+         * @param mask EventTypeBit values of the wanted types, or AllEventTypes.
+         */
+        void SetEventMask(uint32_t mask) { m_EventMask = mask; }
+
+        std::string m_DebugName;
+
+    private:
+        friend class LayerStack;
+
+        LayerStats m_Stats;
+        float m_FrameUpdateMs = 0.0f;   ///< Update time accumulated during the current frame.
+        float m_FrameEventMs = 0.0f;    ///< Event time accumulated during the current frame.
+        uint32_t m_FrameEventCount = 0;
+        uint32_t m_EventMask = AllEventTypes;
+    };
+}
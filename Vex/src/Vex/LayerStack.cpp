@@ -0,0 +1,133 @@
+﻿#include "VexPch.h"
+#include "LayerStack.h"
+
+#include "Vex/Debug/Instrumentor.h"
+
+#include <chrono>
+
+namespace Vex
+{
+    using Clock = std::chrono::steady_clock;
+
+    static float ElapsedMilliseconds(Clock::time_point start, Clock::time_point end)
+    {
+        return std::chrono::duration<float, std::milli>(end - start).count();
+    }
+
+    LayerStack::~LayerStack()
+    {
+        for (Layer* layer : m_Layers)
+        {
+            layer->OnDetach();
+            delete layer;
+        }
+    }
+
+    void LayerStack::PushLayer(Layer* layer)
+    {
+        m_Layers.emplace(m_Layers.begin() + m_LayerInsertIndex, layer);
+        m_LayerInsertIndex++;
+        layer->OnAttach();
+    }
+
+    void LayerStack::PushOverlay(Layer* overlay)
+    {
+        m_Layers.emplace_back(overlay);
+        overlay->OnAttach();
+    }
+
+    void LayerStack::PopLayer(Layer* layer)
+    {
+        auto it = std::find(m_Layers.begin(), m_Layers.begin() + m_LayerInsertIndex, layer);
+        if (it != m_Layers.begin() + m_LayerInsertIndex)
+        {
+            layer->OnDetach();
+            m_Layers.erase(it);
+            m_LayerInsertIndex--;
+        }
+    }
+
+    void LayerStack::PopOverlay(Layer* overlay)
+    {
+        auto it = std::find(m_Layers.begin() + m_LayerInsertIndex, m_Layers.end(), overlay);
+        if (it != m_Layers.end())
+        {
+            overlay->OnDetach();
+            m_Layers.erase(it);
+        }
+    }
+
+    void LayerStack::Update(Timestep ts)
+    {
+        VEX_PROFILE_FUNCTION();
+
+        for (Layer* layer : m_Layers)
+        {
+            Clock::time_point start = Clock::now();
+            layer->OnUpdate(ts);
+            layer->m_FrameUpdateMs += ElapsedMilliseconds(start, Clock::now());
+        }
+    }
+
+    void LayerStack::FixedUpdate(Timestep step)
+    {
+        VEX_PROFILE_FUNCTION();
+
+        for (Layer* layer : m_Layers)
+        {
+            Clock::time_point start = Clock::now();
+            layer->OnFixedUpdate(step);
+            layer->m_FrameUpdateMs += ElapsedMilliseconds(start, Clock::now());
+        }
+    }
+
+    void LayerStack::DispatchEvent(Event& e)
+    {
+        uint32_t typeBit = EventTypeBit(e.GetEventType());
+
+        for (auto it = m_Layers.rbegin(); it != m_Layers.rend(); ++it)
+        {
+            if (e.Handled)
+                break;
+
+            Layer* layer = *it;
+            if (!(layer->m_EventMask & typeBit))
+                continue;
+
+            Clock::time_point start = Clock::now();
+            layer->OnEvent(e);
+            layer->m_FrameEventMs += ElapsedMilliseconds(start, Clock::now());
+            layer->m_FrameEventCount++;
+        }
+    }
+
+    uint32_t LayerStack::GetEventMask() const
+    {
+        uint32_t mask = 0;
+        for (const Layer* layer : m_Layers)
+            mask |= layer->m_EventMask;
+
+        return mask;
+    }
+
+    void LayerStack::EndFrame()
+    {
+        // Smoothing factor of the moving averages; roughly the last 20 frames dominate
+        constexpr float alpha = 0.05f;
+
+        for (Layer* layer : m_Layers)
+        {
+            LayerStats& stats = layer->m_Stats;
+
+            stats.LastUpdateMs = layer->m_FrameUpdateMs;
+            stats.LastEventMs = layer->m_FrameEventMs;
+            stats.LastEventCount = layer->m_FrameEventCount;
+            stats.AverageUpdateMs += alpha * (stats.LastUpdateMs - stats.AverageUpdateMs);
+            stats.AverageEventMs += alpha * (stats.LastEventMs - stats.AverageEventMs);
+
+            layer->m_FrameUpdateMs = 0.0f;
+            layer->m_FrameEventMs = 0.0f;
+            layer->m_FrameEventCount = 0;
+        }
+    }
+}
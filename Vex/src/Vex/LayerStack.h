@@ -0,0 +1,62 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Vex/Layer.h"
+
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * Ordered collection of layers owned by the Application.
+     *
+     * Layers are kept in one contiguous array: regular layers first, overlays after them. Updates run
+     * bottom-up, events propagate top-down and stop as soon as a layer marks the event as handled.
+     * Every update and event call is timed and the results are available from Layer::GetStats().
+     */
+    class VEX_API LayerStack
+    {
+    public:
+        LayerStack() = default;
+        ~LayerStack();
+
+        LayerStack(const LayerStack&) = delete;
+        LayerStack& operator=(const LayerStack&) = delete;
+
+        /** Inserts a layer below all overlays and attaches it. The stack takes ownership. */
+        void PushLayer(Layer* layer);
+
+        /** Inserts an overlay on top of the stack and attaches it. The stack takes ownership. */
+        void PushOverlay(Layer* overlay);
+
+        /** Detaches a layer and removes it. Ownership returns to the caller. */
+        void PopLayer(Layer* layer);
+
+        /** Detaches an overlay and removes it. Ownership returns to the caller. */
+        void PopOverlay(Layer* overlay);
+
+        /** Calls OnUpdate on every layer, bottom-up. */
+        void Update(Timestep ts);
+
+        /** Calls OnFixedUpdate on every layer, bottom-up. */
+        void FixedUpdate(Timestep step);
+
+        /** Delivers an event top-down to the layers whose event mask includes it, until one of them handles it. */
+        void DispatchEvent(Event& e);
+
+        /** Returns the event types at least one layer receives. */
+        uint32_t GetEventMask() const;
+
+        /** Publishes this frame's timings to each layer's stats and starts a new frame. */
+        void EndFrame();
+
+        std::vector<Layer*>::iterator begin() { return m_Layers.begin(); }
+        std::vector<Layer*>::iterator end() { return m_Layers.end(); }
+        std::vector<Layer*>::const_iterator begin() const { return m_Layers.begin(); }
+        std::vector<Layer*>::const_iterator end() const { return m_Layers.end(); }
+
+    private:
+        std::vector<Layer*> m_Layers;
+        size_t m_LayerInsertIndex = 0;  ///< Position of the first overlay.
+    };
+}
@@ -8,10 +8,13 @@
  * - Client Logger (APP): Used for logging messages from applications using the engine.
  *
  * The log format is set to include a timestamp, logger name, and message, with color formatting.
+ * In asynchronous mode both loggers share spdlog's thread pool: a preallocated ring buffer drained
+ * by a single background thread.
  */
 
 #include "VexPch.h"
 #include "Log.h"
+#include "spdlog/async.h"                     // Provides the async thread pool and logger factories
 #include "spdlog/sinks/stdout_color_sinks.h" // Provides colored console output
 
 namespace Vex
@@ -20,6 +23,20 @@ namespace Vex
     std::shared_ptr<spdlog::logger> Log::m_sCoreLogger;
     std::shared_ptr<spdlog::logger> Log::m_sClientLogger;
     
+    /**
+     * @brief Creates a colored console logger using the requested mode.
+     */
+    static std::shared_ptr<spdlog::logger> CreateLogger(const std::string& name, const LogSpecification& spec)
+    {
+        if (spec.Mode == LogMode::Synchronous)
+            return spdlog::stdout_color_mt(name);
+
+        if (spec.OverflowPolicy == LogOverflowPolicy::DropOldest)
+            return spdlog::stdout_color_mt<spdlog::async_factory_nonblock>(name);
+
+        return spdlog::stdout_color_mt<spdlog::async_factory>(name);
+    }
+
     /**
      * @brief Initializes the loggers for the engine and client.
      *
@@ -27,18 +44,33 @@ namespace Vex
      * two separate loggers: one for the Vex engine and another for client applications.
      * Log levels are set to `trace` to capture all log messages.
      */
-    void Log::Init()
+    void Log::Init(const LogSpecification& spec)
     {
         // Set log message format: [HH:MM:SS] LoggerName: Message (with color formatting)
         spdlog::set_pattern("%^[%T] %n: %v%$");
 
+        // One background thread keeps message order identical to the synchronous mode
+        if (spec.Mode == LogMode::Asynchronous)
+            spdlog::init_thread_pool(spec.QueueSize, 1);
+
         // Create core logger (engine)
-        m_sCoreLogger = spdlog::stdout_color_mt("VEX");
+        m_sCoreLogger = CreateLogger("VEX", spec);
         m_sCoreLogger->set_level(spdlog::level::trace);
 
         // Create client logger (application)
-        m_sClientLogger = spdlog::stdout_color_mt("APP");
+        m_sClientLogger = CreateLogger("APP", spec);
         m_sClientLogger->set_level(spdlog::level::trace);
     }
-}
 
+    /**
+     * @brief Flushes and releases the loggers.
+     *
+     * For asynchronous loggers this drains the ring buffer and joins the background thread.
+     */
+    void Log::Shutdown()
+    {
+        m_sCoreLogger.reset();
+        m_sClientLogger.reset();
+        spdlog::shutdown();
+    }
+}
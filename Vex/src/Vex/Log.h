@@ -10,6 +10,10 @@
  * - Call `Vex::Log::Init()` at the start of the application to initialize the loggers.
  * - Use `VEX_CORE_*` macros for engine-related logs.
  * - Use `VEX_*` macros for client application logs.
+ * - Call `Vex::Log::Shutdown()` before exiting to flush any messages still queued.
+ *
+ * Log calls below VEX_LOG_ACTIVE_LEVEL are removed at compile time. Dist builds default to
+ * VEX_LOG_LEVEL_INFO, so `VEX_CORE_TRACE` and `VEX_TRACE` compile to nothing there.
  *
  * @note Uses spdlog for logging.
  */
@@ -22,6 +26,39 @@
 
 namespace Vex
 {
+    /**
+     * @brief Where log messages are formatted and written.
+     */
+    enum class LogMode
+    {
+        Synchronous,    ///< Messages are formatted and written on the calling thread.
+        Asynchronous    ///< Messages are queued in a preallocated ring buffer and written by a background thread.
+    };
+
+    /**
+     * @brief What an asynchronous logger does when its ring buffer is full.
+     */
+    enum class LogOverflowPolicy
+    {
+        Block,          ///< The calling thread waits for room in the queue. No message is lost.
+        DropOldest      ///< The oldest queued message is overwritten. The caller never waits.
+    };
+
+    /**
+     * @struct LogSpecification
+     * @brief Options for Log::Init().
+     */
+    struct LogSpecification
+    {
+#ifdef VEX_DEBUG
+        LogMode Mode = LogMode::Synchronous;                    ///< Debug builds log synchronously so nothing is lost on a crash.
+#else
+        LogMode Mode = LogMode::Asynchronous;                   ///< Keeps console I/O out of the frame.
+#endif
+        LogOverflowPolicy OverflowPolicy = LogOverflowPolicy::Block;
+        size_t QueueSize = 8192;                                ///< Number of messages the async ring buffer holds.
+    };
+
     /**
      * @class Log
      * @brief Handles logging for the Vex Engine.
@@ -40,8 +77,14 @@ namespace Vex
          * @brief Initializes the loggers.
          * 
          * This method sets up the logging format and log levels for both core and client loggers.
+         * @param spec Selects synchronous or asynchronous logging and the async queue behaviour.
          */
-        static void Init();
+        static void Init(const LogSpecification& spec = LogSpecification());
+
+        /**
+         * @brief Flushes all pending messages and stops the background logging thread, if any.
+         */
+        static void Shutdown();
         
         /**
          * @brief Gets the core engine logger.
@@ -57,18 +100,65 @@ namespace Vex
     };
 }
 
+// Compile-time log levels
+#define VEX_LOG_LEVEL_TRACE     0
+#define VEX_LOG_LEVEL_INFO      1
+#define VEX_LOG_LEVEL_WARN      2
+#define VEX_LOG_LEVEL_ERROR     3
+#define VEX_LOG_LEVEL_FATAL     4
+#define VEX_LOG_LEVEL_OFF       5
+
+// Lowest level that is compiled in; anything below it expands to nothing
+#ifndef VEX_LOG_ACTIVE_LEVEL
+    #ifdef VEX_DIST
+        #define VEX_LOG_ACTIVE_LEVEL VEX_LOG_LEVEL_INFO
+    #else
+        #define VEX_LOG_ACTIVE_LEVEL VEX_LOG_LEVEL_TRACE
+    #endif
+#endif
+
+#define VEX_LOG_DISABLED(...)   (void)0
+
 // Logging macros for easy access
 
 // Core (engine) logging macros
-#define VEX_CORE_TRACE(...)     ::Vex::Log::GetCoreLogger()->trace(__VA_ARGS__)
-#define VEX_CORE_INFO(...)      ::Vex::Log::GetCoreLogger()->info(__VA_ARGS__)
-#define VEX_CORE_WARN(...)      ::Vex::Log::GetCoreLogger()->warn(__VA_ARGS__)
-#define VEX_CORE_ERROR(...)     ::Vex::Log::GetCoreLogger()->error(__VA_ARGS__)
-#define VEX_CORE_FATAL(...)     ::Vex::Log::GetCoreLogger()->fatal(__VA_ARGS__)
-
-// Client application logging macros
-#define VEX_TRACE(...)          ::Vex::Log::GetClientLogger()->trace(__VA_ARGS__)
-#define VEX_INFO(...)           ::Vex::Log::GetClientLogger()->info(__VA_ARGS__)
-#define VEX_WARN(...)           ::Vex::Log::GetClientLogger()->warn(__VA_ARGS__)
-#define VEX_ERROR(...)          ::Vex::Log::GetClientLogger()->error(__VA_ARGS__)
-#define VEX_FATAL(...)          ::Vex::Log::GetClientLogger()->fatal(__VA_ARGS__)
+#if VEX_LOG_ACTIVE_LEVEL <= VEX_LOG_LEVEL_TRACE
+    #define VEX_CORE_TRACE(...)     ::Vex::Log::GetCoreLogger()->trace(__VA_ARGS__)
+    #define VEX_TRACE(...)          ::Vex::Log::GetClientLogger()->trace(__VA_ARGS__)
+#else
+    #define VEX_CORE_TRACE(...)     VEX_LOG_DISABLED(__VA_ARGS__)
+    #define VEX_TRACE(...)          VEX_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if VEX_LOG_ACTIVE_LEVEL <= VEX_LOG_LEVEL_INFO
+    #define VEX_CORE_INFO(...)      ::Vex::Log::GetCoreLogger()->info(__VA_ARGS__)
+    #define VEX_INFO(...)           ::Vex::Log::GetClientLogger()->info(__VA_ARGS__)
+#else
+    #define VEX_CORE_INFO(...)      VEX_LOG_DISABLED(__VA_ARGS__)
+    #define VEX_INFO(...)           VEX_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if VEX_LOG_ACTIVE_LEVEL <= VEX_LOG_LEVEL_WARN
+    #define VEX_CORE_WARN(...)      ::Vex::Log::GetCoreLogger()->warn(__VA_ARGS__)
+    #define VEX_WARN(...)           ::Vex::Log::GetClientLogger()->warn(__VA_ARGS__)
+#else
+    #define VEX_CORE_WARN(...)      VEX_LOG_DISABLED(__VA_ARGS__)
+    #define VEX_WARN(...)           VEX_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if VEX_LOG_ACTIVE_LEVEL <= VEX_LOG_LEVEL_ERROR
+    #define VEX_CORE_ERROR(...)     ::Vex::Log::GetCoreLogger()->error(__VA_ARGS__)
+    #define VEX_ERROR(...)          ::Vex::Log::GetClientLogger()->error(__VA_ARGS__)
+#else
+    #define VEX_CORE_ERROR(...)     VEX_LOG_DISABLED(__VA_ARGS__)
+    #define VEX_ERROR(...)          VEX_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+// spdlog calls its highest level "critical"
+#if VEX_LOG_ACTIVE_LEVEL <= VEX_LOG_LEVEL_FATAL
+    #define VEX_CORE_FATAL(...)     ::Vex::Log::GetCoreLogger()->critical(__VA_ARGS__)
+    #define VEX_FATAL(...)          ::Vex::Log::GetClientLogger()->critical(__VA_ARGS__)
+#else
+    #define VEX_CORE_FATAL(...)     VEX_LOG_DISABLED(__VA_ARGS__)
+    #define VEX_FATAL(...)          VEX_LOG_DISABLED(__VA_ARGS__)
+#endif
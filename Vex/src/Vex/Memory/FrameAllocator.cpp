@@ -0,0 +1,16 @@
+﻿#include "VexPch.h"
+#include "FrameAllocator.h"
+
+namespace Vex
+{
+    DoubleBufferedAllocator::DoubleBufferedAllocator(size_t blockSize)
+        : m_Buffers{ LinearAllocator(blockSize), LinearAllocator(blockSize) }
+    {
+    }
+
+    void DoubleBufferedAllocator::Swap()
+    {
+        m_Current ^= 1;
+        m_Buffers[m_Current].Reset();
+    }
+}
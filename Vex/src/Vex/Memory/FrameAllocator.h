@@ -0,0 +1,96 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Vex/Memory/LinearAllocator.h"
+
+#include <string>
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * @class DoubleBufferedAllocator
+     * @brief Pair of linear allocators whose memory stays valid for two frames.
+     *
+     * Allocations go to the current buffer. Swap() makes the other buffer current and resets it, so
+     * anything allocated during frame N can still be read during frame N + 1, e.g. to hand data from
+     * the simulation of one frame to the consumers of the next.
+     */
+    class VEX_API DoubleBufferedAllocator
+    {
+    public:
+        explicit DoubleBufferedAllocator(size_t blockSize = 64 * 1024);
+
+        /**
+         * @brief Allocates from the current buffer.
+         * @see LinearAllocator::Allocate
+         */
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+        {
+            return m_Buffers[m_Current].Allocate(size, alignment);
+        }
+
+        /** @brief Flips buffers and resets the new current one, releasing what was allocated two frames ago. */
+        void Swap();
+
+        /** @return The buffer allocations currently go to. */
+        LinearAllocator& GetCurrent() { return m_Buffers[m_Current]; }
+
+        /** @return The buffer filled during the previous frame. */
+        const LinearAllocator& GetPrevious() const { return m_Buffers[m_Current ^ 1]; }
+
+    private:
+        LinearAllocator m_Buffers[2];
+        uint32_t m_Current = 0;
+    };
+
+    /**
+     * @class FrameStlAllocator
+     * @brief STL allocator adaptor that draws from a LinearAllocator.
+     *
+     * deallocate() is a no-op; memory comes back when the underlying allocator is reset. Containers
+     * using it must not outlive that reset.
+     *
+     * @tparam T Element type.
+     */
+    template<typename T>
+    class FrameStlAllocator
+    {
+    public:
+        using value_type = T;
+
+        explicit FrameStlAllocator(LinearAllocator& allocator) noexcept
+            : m_Allocator(&allocator)
+        {
+        }
+
+        template<typename U>
+        FrameStlAllocator(const FrameStlAllocator<U>& other) noexcept
+            : m_Allocator(other.GetAllocator())
+        {
+        }
+
+        T* allocate(size_t count)
+        {
+            return static_cast<T*>(m_Allocator->Allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, size_t) noexcept {}
+
+        LinearAllocator* GetAllocator() const noexcept { return m_Allocator; }
+
+        template<typename U>
+        bool operator==(const FrameStlAllocator<U>& other) const noexcept { return m_Allocator == other.GetAllocator(); }
+
+        template<typename U>
+        bool operator!=(const FrameStlAllocator<U>& other) const noexcept { return m_Allocator != other.GetAllocator(); }
+
+    private:
+        LinearAllocator* m_Allocator;
+    };
+
+    template<typename T>
+    using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+
+    using FrameString = std::basic_string<char, std::char_traits<char>, FrameStlAllocator<char>>;
+}
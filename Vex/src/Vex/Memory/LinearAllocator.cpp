@@ -0,0 +1,67 @@
+﻿#include "VexPch.h"
+#include "LinearAllocator.h"
+
+#include <cstring>
+
+namespace Vex
+{
+    static size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    LinearAllocator::LinearAllocator(size_t blockSize)
+        : m_BlockSize(blockSize)
+    {
+        m_Blocks.push_back({ static_cast<std::byte*>(::operator new(m_BlockSize, std::align_val_t(alignof(std::max_align_t)))), m_BlockSize });
+        m_Capacity = m_BlockSize;
+    }
+
+    LinearAllocator::~LinearAllocator()
+    {
+        for (Block& block : m_Blocks)
+            ::operator delete(block.Data, std::align_val_t(alignof(std::max_align_t)));
+    }
+
+    void* LinearAllocator::Allocate(size_t size, size_t alignment)
+    {
+        while (true)
+        {
+            Block& block = m_Blocks[m_CurrentBlock];
+            uintptr_t base = reinterpret_cast<uintptr_t>(block.Data);
+            size_t offset = AlignUp(base + m_Offset, alignment) - base;
+
+            if (offset + size <= block.Size)
+            {
+                m_Used += offset + size - m_Offset;
+                m_PeakUsed = std::max(m_PeakUsed, m_Used);
+                m_Offset = offset + size;
+                return block.Data + offset;
+            }
+
+            // Current block exhausted: move on to the next retained block, or grow the chain.
+            m_Used += block.Size - m_Offset;
+            m_Offset = 0;
+
+            if (++m_CurrentBlock == m_Blocks.size())
+            {
+                size_t newSize = std::max(m_BlockSize, AlignUp(size, alignment) + alignment);
+                m_Blocks.push_back({ static_cast<std::byte*>(::operator new(newSize, std::align_val_t(alignof(std::max_align_t)))), newSize });
+                m_Capacity += newSize;
+            }
+        }
+    }
+
+    void LinearAllocator::Reset()
+    {
+#ifdef VEX_DEBUG
+        for (size_t i = 0; i < m_CurrentBlock; i++)
+            std::memset(m_Blocks[i].Data, PoisonByte, m_Blocks[i].Size);
+        std::memset(m_Blocks[m_CurrentBlock].Data, PoisonByte, m_Offset);
+#endif
+
+        m_CurrentBlock = 0;
+        m_Offset = 0;
+        m_Used = 0;
+    }
+}
@@ -0,0 +1,75 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * @class LinearAllocator
+     * @brief Bump allocator that hands out memory from a chain of fixed-size blocks.
+     *
+     * Allocation is a pointer bump inside the current block. Individual allocations are never
+     * freed; instead the whole allocator is rewound with Reset(). Blocks are kept across resets,
+     * so once the allocator has grown to its steady-state size it no longer touches the heap.
+     * Debug builds overwrite released memory with PoisonByte on every reset so stale pointers
+     * read obviously bad data.
+     */
+    class VEX_API LinearAllocator
+    {
+    public:
+        static constexpr unsigned char PoisonByte = 0xDD;
+
+        /**
+         * @brief Constructs the allocator and reserves its first block.
+         * @param blockSize Size in bytes of each block in the chain.
+         */
+        explicit LinearAllocator(size_t blockSize = 64 * 1024);
+        ~LinearAllocator();
+
+        LinearAllocator(const LinearAllocator&) = delete;
+        LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+        /**
+         * @brief Allocates a block of memory with the requested alignment.
+         * @param size Number of bytes to allocate.
+         * @param alignment Required alignment (must be a power of two).
+         * @return Pointer to the allocated memory. Never null.
+         */
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * @brief Rewinds the allocator to the start of its first block.
+         *
+         * Invalidates every pointer handed out since the last reset. No memory is released.
+         * In debug builds the released bytes are filled with PoisonByte.
+         */
+        void Reset();
+
+        /** @return Number of bytes handed out since the last reset (including alignment padding). */
+        size_t GetUsed() const { return m_Used; }
+
+        /** @return Largest value GetUsed() has reached since the allocator was created. */
+        size_t GetPeakUsed() const { return m_PeakUsed; }
+
+        /** @return Total number of bytes owned by the allocator across all blocks. */
+        size_t GetCapacity() const { return m_Capacity; }
+
+    private:
+        struct Block
+        {
+            std::byte* Data;
+            size_t Size;
+        };
+
+        std::vector<Block> m_Blocks;
+        size_t m_BlockSize;
+        size_t m_CurrentBlock = 0;  ///< Index of the block currently being bumped.
+        size_t m_Offset = 0;        ///< Offset of the next free byte in the current block.
+        size_t m_Used = 0;
+        size_t m_PeakUsed = 0;      ///< High-water mark of m_Used.
+        size_t m_Capacity = 0;
+    };
+}
@@ -0,0 +1,50 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <cstddef>
+#include <string>
+
+namespace Vex
+{
+    /**
+     * @class MappedFile
+     * @brief Read-only memory mapping of a whole file.
+     *
+     * The implementation is platform-specific; see Platform/<OS>/<OS>MappedFile.cpp.
+     */
+    class VEX_API MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Maps the file at the given path, unmapping any previously mapped file.
+         * @param path Path of the file to map.
+         * @return True on success.
+         */
+        bool Open(const std::string& path);
+
+        /** @brief Unmaps the file. Safe to call when nothing is mapped. */
+        void Close();
+
+        /** @return Pointer to the first byte of the mapping, or nullptr if nothing is mapped. */
+        const std::byte* GetData() const { return m_Data; }
+
+        /** @return Size of the mapping in bytes. */
+        size_t GetSize() const { return m_Size; }
+
+        /** @return True if a file is currently mapped. */
+        bool IsOpen() const { return m_Data != nullptr; }
+
+    private:
+        const std::byte* m_Data = nullptr;
+        size_t m_Size = 0;
+        void* m_FileHandle = nullptr;       ///< Native file handle, if the platform needs to keep one.
+        void* m_MappingHandle = nullptr;    ///< Native mapping handle, if the platform needs to keep one.
+    };
+}
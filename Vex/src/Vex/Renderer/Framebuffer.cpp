@@ -0,0 +1,81 @@
+﻿#include "VexPch.h"
+#include "Framebuffer.h"
+
+#include "Vex/Log.h"
+
+#include <cstdio>
+
+namespace Vex
+{
+    Framebuffer::Framebuffer(uint32_t width, uint32_t height)
+    {
+        Resize(width, height);
+    }
+
+    void Framebuffer::Resize(uint32_t width, uint32_t height)
+    {
+        m_Width = width;
+        m_Height = height;
+        m_Stride = (width + 3) & ~3u;
+        m_Pixels.assign(static_cast<size_t>(m_Stride) * height, 0);
+    }
+
+    void Framebuffer::Clear(uint32_t color)
+    {
+        std::fill(m_Pixels.begin(), m_Pixels.end(), color);
+    }
+
+    bool Framebuffer::SaveBMP(const std::string& path) const
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            VEX_CORE_ERROR("Failed to open image '{0}' for writing", path);
+            return false;
+        }
+
+        uint32_t imageSize = m_Width * m_Height * 4;
+
+        // BITMAPFILEHEADER followed by a BITMAPINFOHEADER, written field by field to avoid packing concerns
+        auto put16 = [file](uint16_t value) { std::fwrite(&value, sizeof(value), 1, file); };
+        auto put32 = [file](uint32_t value) { std::fwrite(&value, sizeof(value), 1, file); };
+
+        put16(0x4D42);              // "BM"
+        put32(54 + imageSize);      // File size
+        put32(0);                   // Reserved
+        put32(54);                  // Offset of the pixel data
+
+        put32(40);                  // Header size
+        put32(m_Width);
+        put32(static_cast<uint32_t>(-static_cast<int32_t>(m_Height)));  // Negative height: rows stored top-down
+        put16(1);                   // Planes
+        put16(32);                  // Bits per pixel
+        put32(0);                   // BI_RGB
+        put32(imageSize);
+        put32(2835);                // 72 DPI
+        put32(2835);
+        put32(0);
+        put32(0);
+
+        // BMP stores B, G, R, A
+        std::vector<uint32_t> row(m_Width);
+        for (uint32_t y = 0; y < m_Height; y++)
+        {
+            const uint32_t* source = GetRow(y);
+            for (uint32_t x = 0; x < m_Width; x++)
+            {
+                uint32_t pixel = source[x];
+                row[x] = (pixel & 0xFF00FF00u) | ((pixel & 0xFFu) << 16) | ((pixel >> 16) & 0xFFu);
+            }
+
+            std::fwrite(row.data(), sizeof(uint32_t), m_Width, file);
+        }
+
+        bool ok = std::ferror(file) == 0;
+        std::fclose(file);
+
+        if (!ok)
+            VEX_CORE_ERROR("Failed to write image '{0}'", path);
+        return ok;
+    }
+}
@@ -0,0 +1,58 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <string>
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * Packs a color into the framebuffer's pixel format: bytes R, G, B, A in memory.
+     */
+    constexpr uint32_t PackColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255)
+    {
+        return static_cast<uint32_t>(r) | (static_cast<uint32_t>(g) << 8) | (static_cast<uint32_t>(b) << 16) | (static_cast<uint32_t>(a) << 24);
+    }
+
+    /**
+     * @class Framebuffer
+     * @brief CPU-side 32-bit RGBA color buffer.
+     *
+     * Rows are padded to a multiple of four pixels so four-wide SIMD stores never leave the row.
+     */
+    class VEX_API Framebuffer
+    {
+    public:
+        Framebuffer(uint32_t width, uint32_t height);
+
+        /** Reallocates the buffer; the contents are undefined afterwards. */
+        void Resize(uint32_t width, uint32_t height);
+
+        /** Fills the whole buffer with one color. */
+        void Clear(uint32_t color);
+
+        uint32_t GetWidth() const { return m_Width; }
+        uint32_t GetHeight() const { return m_Height; }
+
+        /** @return Distance between rows, in pixels. */
+        uint32_t GetStride() const { return m_Stride; }
+
+        uint32_t* GetPixels() { return m_Pixels.data(); }
+        const uint32_t* GetPixels() const { return m_Pixels.data(); }
+
+        uint32_t* GetRow(uint32_t y) { return m_Pixels.data() + static_cast<size_t>(y) * m_Stride; }
+        const uint32_t* GetRow(uint32_t y) const { return m_Pixels.data() + static_cast<size_t>(y) * m_Stride; }
+
+        /**
+         * @brief Writes the buffer to an uncompressed 32-bit BMP file.
+         * @return False if the file could not be written.
+         */
+        bool SaveBMP(const std::string& path) const;
+
+    private:
+        uint32_t m_Width = 0, m_Height = 0;
+        uint32_t m_Stride = 0;
+        std::vector<uint32_t> m_Pixels;
+    };
+}
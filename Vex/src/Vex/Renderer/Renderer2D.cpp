@@ -0,0 +1,278 @@
+﻿#include "VexPch.h"
+#include "Renderer2D.h"
+
+#include "Vex/Debug/Instrumentor.h"
+#include "Vex/Jobs/JobSystem.h"
+#include "Vex/Log.h"
+
+#include <bit>
+#include <chrono>
+
+namespace Vex
+{
+    /**
+     * One recorded quad. Texture coordinates are 16-bit unorm so a command stays at 40 bytes.
+     */
+    struct QuadCommand
+    {
+        uint64_t SortKey;
+        float X, Y, Width, Height;
+        uint16_t U0, V0, U1, V1;
+        uint32_t Color;
+        TextureHandle Texture;
+    };
+
+    static_assert(sizeof(QuadCommand) == 40, "QuadCommand should stay compact");
+
+    /**
+     * What the radix sort moves around: the key and the command it belongs to.
+     */
+    struct SortEntry
+    {
+        uint64_t Key;
+        uint32_t Index;
+    };
+
+    struct Renderer2DData
+    {
+        Renderer2DBackend* Backend = nullptr;
+        JobSystem* Jobs = nullptr;
+
+        // Capacity is kept across scenes so steady-state frames do not allocate
+        std::vector<QuadCommand> Commands;
+        std::vector<SortEntry> SortEntries;
+        std::vector<SortEntry> SortScratch;
+        std::vector<Renderer2DDrawCall> DrawCalls;
+
+        Renderer2DStats Stats;
+    };
+
+    static Renderer2DData s_Data;
+
+    static constexpr uint32_t ParallelBuildThreshold = 16384;  ///< Smaller scenes write their vertices on the calling thread.
+    static constexpr uint32_t BuildBatchSize = 4096;            ///< Quads per vertex-writing job.
+    static constexpr uint32_t TextureKeyMask = 0xFFFFFF;
+
+    static uint16_t ToUnorm16(float value)
+    {
+        return static_cast<uint16_t>(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+    }
+
+    /**
+     * Maps a float to an unsigned integer with the same ordering, so depth can be sorted as key bits.
+     */
+    static uint32_t OrderedDepthBits(float depth)
+    {
+        uint32_t bits = std::bit_cast<uint32_t>(depth);
+        return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+    }
+
+    static float DepthFromOrderedBits(uint32_t bits)
+    {
+        return std::bit_cast<float>((bits & 0x80000000u) ? bits & 0x7FFFFFFFu : ~bits);
+    }
+
+    /**
+     * Stable LSD radix sort on the full 64-bit key, one byte per pass. Histograms for all passes are
+     * built in a single read, and passes where every key has the same byte (typically the layer and
+     * texture bytes of a scene using few of them) are skipped.
+     */
+    static void RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch)
+    {
+        const size_t count = entries.size();
+        if (count < 2)
+            return;
+
+        scratch.resize(count);
+
+        uint32_t histograms[8][256] = {};
+        for (const SortEntry& entry : entries)
+        {
+            for (uint32_t pass = 0; pass < 8; pass++)
+                histograms[pass][(entry.Key >> (pass * 8)) & 0xFF]++;
+        }
+
+        SortEntry* source = entries.data();
+        SortEntry* destination = scratch.data();
+
+        for (uint32_t pass = 0; pass < 8; pass++)
+        {
+            uint32_t shift = pass * 8;
+            uint32_t* histogram = histograms[pass];
+            if (histogram[(source[0].Key >> shift) & 0xFF] == count)
+                continue;
+
+            uint32_t offsets[256];
+            uint32_t offset = 0;
+            for (uint32_t bucket = 0; bucket < 256; bucket++)
+            {
+                offsets[bucket] = offset;
+                offset += histogram[bucket];
+            }
+
+            for (size_t i = 0; i < count; i++)
+                destination[offsets[(source[i].Key >> shift) & 0xFF]++] = source[i];
+
+            std::swap(source, destination);
+        }
+
+        if (source != entries.data())
+            entries.swap(scratch);
+    }
+
+    /**
+     * Expands sorted commands [begin, end) into four vertices each, at four times their sorted position.
+     */
+    static void WriteVertices(QuadVertex* vertices, uint32_t begin, uint32_t end)
+    {
+        constexpr float unorm = 1.0f / 65535.0f;
+
+        for (uint32_t i = begin; i < end; i++)
+        {
+            const SortEntry& entry = s_Data.SortEntries[i];
+            const QuadCommand& command = s_Data.Commands[entry.Index];
+
+            float x0 = command.X, y0 = command.Y;
+            float x1 = x0 + command.Width, y1 = y0 + command.Height;
+            float z = DepthFromOrderedBits(static_cast<uint32_t>(entry.Key));
+            float u0 = command.U0 * unorm, v0 = command.V0 * unorm;
+            float u1 = command.U1 * unorm, v1 = command.V1 * unorm;
+
+            QuadVertex* quad = vertices + static_cast<size_t>(i) * 4;
+            quad[0] = { x0, y0, z, u0, v0, command.Color };
+            quad[1] = { x1, y0, z, u1, v0, command.Color };
+            quad[2] = { x1, y1, z, u1, v1, command.Color };
+            quad[3] = { x0, y1, z, u0, v1, command.Color };
+        }
+    }
+
+    static void Record(float x, float y, float width, float height, TextureHandle texture,
+        float u0, float v0, float u1, float v1, uint32_t color, uint8_t layer, float depth)
+    {
+        s_Data.Commands.push_back({
+            Renderer2D::MakeSortKey(layer, texture, depth),
+            x, y, width, height,
+            ToUnorm16(u0), ToUnorm16(v0), ToUnorm16(u1), ToUnorm16(v1),
+            color, texture
+        });
+    }
+
+    void Renderer2D::Init(Renderer2DBackend& backend, JobSystem* jobSystem)
+    {
+        s_Data.Backend = &backend;
+        s_Data.Jobs = jobSystem;
+        s_Data.Commands.clear();
+        s_Data.Stats = Renderer2DStats();
+    }
+
+    void Renderer2D::Shutdown()
+    {
+        s_Data = Renderer2DData();
+    }
+
+    TextureHandle Renderer2D::CreateTexture(const uint32_t* pixels, uint32_t width, uint32_t height)
+    {
+        if (!s_Data.Backend)
+        {
+            VEX_CORE_ERROR("Renderer2D::CreateTexture called before Renderer2D::Init");
+            return 0;
+        }
+
+        TextureHandle texture = s_Data.Backend->CreateTexture(pixels, width, height);
+        if (texture > TextureKeyMask)
+            VEX_CORE_WARN("Texture handle {0} does not fit the sort key; batching by texture will be wrong", texture);
+        return texture;
+    }
+
+    void Renderer2D::BeginScene()
+    {
+        s_Data.Commands.clear();
+    }
+
+    void Renderer2D::EndScene()
+    {
+        VEX_PROFILE_FUNCTION();
+
+        if (!s_Data.Backend)
+        {
+            VEX_CORE_ERROR("Renderer2D::EndScene called before Renderer2D::Init");
+            return;
+        }
+
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point start = Clock::now();
+
+        const uint32_t quadCount = static_cast<uint32_t>(s_Data.Commands.size());
+
+        s_Data.SortEntries.resize(quadCount);
+        for (uint32_t i = 0; i < quadCount; i++)
+            s_Data.SortEntries[i] = { s_Data.Commands[i].SortKey, i };
+
+        RadixSort(s_Data.SortEntries, s_Data.SortScratch);
+
+        Clock::time_point sorted = Clock::now();
+
+        QuadVertex* vertices = s_Data.Backend->MapVertices(quadCount * 4);
+        if (s_Data.Jobs && quadCount >= ParallelBuildThreshold)
+            s_Data.Jobs->ParallelFor(quadCount, BuildBatchSize, [vertices](uint32_t begin, uint32_t end) { WriteVertices(vertices, begin, end); });
+        else
+            WriteVertices(vertices, 0, quadCount);
+
+        // Sorting grouped quads by texture within each layer; consecutive runs become draw calls
+        s_Data.DrawCalls.clear();
+        uint32_t batches = 0;
+        for (uint32_t i = 0; i < quadCount; )
+        {
+            TextureHandle texture = static_cast<TextureHandle>(s_Data.SortEntries[i].Key >> 32) & TextureKeyMask;
+
+            uint32_t end = i + 1;
+            while (end < quadCount && (static_cast<TextureHandle>(s_Data.SortEntries[end].Key >> 32) & TextureKeyMask) == texture)
+                end++;
+
+            for (uint32_t first = i; first < end; first += MaxQuadsPerDrawCall)
+                s_Data.DrawCalls.push_back({ s_Data.Commands[s_Data.SortEntries[first].Index].Texture, first * 4, std::min(end - first, MaxQuadsPerDrawCall) });
+
+            batches++;
+            i = end;
+        }
+
+        s_Data.Backend->Submit(s_Data.DrawCalls.data(), static_cast<uint32_t>(s_Data.DrawCalls.size()));
+
+        Clock::time_point built = Clock::now();
+
+        Renderer2DStats& stats = s_Data.Stats;
+        stats.Quads = quadCount;
+        stats.Batches = batches;
+        stats.DrawCalls = static_cast<uint32_t>(s_Data.DrawCalls.size());
+        stats.Vertices = quadCount * 4;
+        stats.Indices = quadCount * 6;
+        stats.SortMilliseconds = std::chrono::duration<float, std::milli>(sorted - start).count();
+        stats.BuildMilliseconds = std::chrono::duration<float, std::milli>(built - sorted).count();
+    }
+
+    void Renderer2D::DrawQuad(float x, float y, float width, float height, uint32_t color, uint8_t layer, float depth)
+    {
+        Record(x, y, width, height, 0, 0.0f, 0.0f, 1.0f, 1.0f, color, layer, depth);
+    }
+
+    void Renderer2D::DrawSprite(float x, float y, float width, float height, TextureHandle texture, uint32_t tint, uint8_t layer, float depth)
+    {
+        Record(x, y, width, height, texture, 0.0f, 0.0f, 1.0f, 1.0f, tint, layer, depth);
+    }
+
+    void Renderer2D::DrawSprite(float x, float y, float width, float height, TextureHandle texture,
+        float u0, float v0, float u1, float v1, uint32_t tint, uint8_t layer, float depth)
+    {
+        Record(x, y, width, height, texture, u0, v0, u1, v1, tint, layer, depth);
+    }
+
+    uint64_t Renderer2D::MakeSortKey(uint8_t layer, TextureHandle texture, float depth)
+    {
+        return (static_cast<uint64_t>(layer) << 56) | (static_cast<uint64_t>(texture & TextureKeyMask) << 32) | OrderedDepthBits(depth);
+    }
+
+    const Renderer2DStats& Renderer2D::GetStats()
+    {
+        return s_Data.Stats;
+    }
+}
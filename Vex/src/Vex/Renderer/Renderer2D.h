@@ -0,0 +1,81 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Vex/Renderer/Renderer2DBackend.h"
+
+#include <cstdint>
+
+namespace Vex
+{
+    class JobSystem;
+
+    /**
+     * Counters of the last scene submitted.
+     */
+    struct Renderer2DStats
+    {
+        uint32_t Quads = 0;
+        uint32_t Batches = 0;           ///< Runs of quads sharing a texture after sorting.
+        uint32_t DrawCalls = 0;         ///< Batches split at MaxQuadsPerDrawCall.
+        uint32_t Vertices = 0;
+        uint32_t Indices = 0;           ///< Six per quad, for backends drawing indexed triangles.
+        float SortMilliseconds = 0.0f;
+        float BuildMilliseconds = 0.0f; ///< Writing vertices and forming draw calls.
+    };
+
+    /**
+     * @class Renderer2D
+     * @brief Batched renderer for colored and textured screen-space quads.
+     *
+     * Draw functions only append a fixed-size command with a 64-bit sort key; nothing touches the backend
+     * until EndScene(). There the keys are radix-sorted, the sorted commands are expanded into vertices
+     * written straight into the backend's mapped memory (in parallel when a job system is given) and
+     * consecutive quads sharing a texture become one draw call.
+     *
+     * The sort key orders a scene by layer first, then by texture so batches are as long as possible,
+     * then by depth (ascending). Equal keys keep their submission order. Quads that must overlap in a
+     * given order regardless of texture therefore belong on different layers.
+     *
+     * Main thread only.
+     */
+    class VEX_API Renderer2D
+    {
+    public:
+        static constexpr uint32_t MaxQuadsPerDrawCall = 16384;  ///< 65536 vertices, addressable with 16-bit indices.
+
+        /**
+         * @param backend Receives the vertices and draw calls; must outlive Shutdown().
+         * @param jobSystem Optional; used to write vertices in parallel for large scenes.
+         */
+        static void Init(Renderer2DBackend& backend, JobSystem* jobSystem = nullptr);
+        static void Shutdown();
+
+        /** Uploads a texture through the backend. */
+        static TextureHandle CreateTexture(const uint32_t* pixels, uint32_t width, uint32_t height);
+
+        /** Starts recording a scene. */
+        static void BeginScene();
+
+        /** Sorts, batches and submits the scene to the backend. */
+        static void EndScene();
+
+        static void DrawQuad(float x, float y, float width, float height, uint32_t color, uint8_t layer = 0, float depth = 0.0f);
+
+        static void DrawSprite(float x, float y, float width, float height, TextureHandle texture,
+            uint32_t tint = 0xFFFFFFFFu, uint8_t layer = 0, float depth = 0.0f);
+
+        /**
+         * @brief Draws part of a texture, e.g. a frame of a sprite sheet.
+         * @param u0,v0,u1,v1 Texture coordinates of the top-left and bottom-right corners, in [0, 1].
+         */
+        static void DrawSprite(float x, float y, float width, float height, TextureHandle texture,
+            float u0, float v0, float u1, float v1, uint32_t tint = 0xFFFFFFFFu, uint8_t layer = 0, float depth = 0.0f);
+
+        /**
+         * @brief Sort key of a command: layer in the top 8 bits, texture in the next 24, depth in the low 32.
+         */
+        static uint64_t MakeSortKey(uint8_t layer, TextureHandle texture, float depth);
+
+        static const Renderer2DStats& GetStats();
+    };
+}
@@ -0,0 +1,64 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <cstdint>
+
+namespace Vex
+{
+    /**
+     * Texture created by a Renderer2DBackend. 0 means no texture: the quad is filled with its color.
+     */
+    using TextureHandle = uint32_t;
+
+    /**
+     * One corner of a 2D quad as written into the backend's vertex memory.
+     */
+    struct QuadVertex
+    {
+        float X, Y, Z;
+        float U, V;
+        uint32_t Color;     ///< RGBA8, see PackColor().
+    };
+
+    /**
+     * A run of consecutive quads sharing one texture. Quad n of the call uses vertices
+     * FirstVertex + 4n .. FirstVertex + 4n + 3, in the order top-left, top-right, bottom-right, bottom-left.
+     */
+    struct Renderer2DDrawCall
+    {
+        TextureHandle Texture;
+        uint32_t FirstVertex;
+        uint32_t QuadCount;
+    };
+
+    /**
+     * @class Renderer2DBackend
+     * @brief What Renderer2D needs from a graphics API.
+     *
+     * Every frame Renderer2D maps vertex memory once, writes all of the frame's vertices into it and then
+     * submits the draw calls that read them. A GPU backend returns persistently mapped buffer memory
+     * (one region per frame in flight) so the vertices are written straight to where the GPU reads them.
+     */
+    class VEX_API Renderer2DBackend
+    {
+    public:
+        virtual ~Renderer2DBackend() = default;
+
+        /**
+         * @brief Uploads an RGBA8 texture.
+         * @return A handle other than 0.
+         */
+        virtual TextureHandle CreateTexture(const uint32_t* pixels, uint32_t width, uint32_t height) = 0;
+
+        /**
+         * @brief Returns memory for this frame's vertices.
+         *
+         * Valid until the next call. May be written from several threads, each to its own range.
+         */
+        virtual QuadVertex* MapVertices(uint32_t vertexCount) = 0;
+
+        /** Draws the frame from the vertices last mapped. */
+        virtual void Submit(const Renderer2DDrawCall* drawCalls, uint32_t drawCallCount) = 0;
+    };
+}
@@ -0,0 +1,505 @@
+﻿#include "VexPch.h"
+#include "SoftwareRasterizer.h"
+
+#include "Vex/Debug/Instrumentor.h"
+#include "Vex/Jobs/JobSystem.h"
+#include "Vex/Window.h"
+
+#ifdef VEX_PLATFORM_WINDOWS
+    #include <SDL.h>
+#endif
+
+#if defined(_M_X64) || defined(__SSE2__)
+    #define VEX_RASTER_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define VEX_RASTER_SSE2 0
+#endif
+
+#include <bit>
+#include <chrono>
+#include <cmath>
+
+namespace Vex
+{
+    // Four-lane float and integer vectors. The rasterizer is written against these so the SSE2 and the
+    // scalar builds share one implementation.
+#if VEX_RASTER_SSE2
+    struct Float4 { __m128 V; };
+    struct Int4 { __m128i V; };
+
+    static inline Float4 Splat(float value) { return { _mm_set1_ps(value) }; }
+    static inline Float4 Ramp(float start) { return { _mm_setr_ps(start, start + 1.0f, start + 2.0f, start + 3.0f) }; }
+    static inline Float4 operator+(Float4 a, Float4 b) { return { _mm_add_ps(a.V, b.V) }; }
+    static inline Float4 operator-(Float4 a, Float4 b) { return { _mm_sub_ps(a.V, b.V) }; }
+    static inline Float4 operator*(Float4 a, Float4 b) { return { _mm_mul_ps(a.V, b.V) }; }
+    static inline Float4 Min(Float4 a, Float4 b) { return { _mm_min_ps(a.V, b.V) }; }
+    static inline Float4 Max(Float4 a, Float4 b) { return { _mm_max_ps(a.V, b.V) }; }
+    static inline Int4 CmpGt(Float4 a, Float4 b) { return { _mm_castps_si128(_mm_cmpgt_ps(a.V, b.V)) }; }
+    static inline Int4 CmpEq(Float4 a, Float4 b) { return { _mm_castps_si128(_mm_cmpeq_ps(a.V, b.V)) }; }
+
+    static inline Int4 SplatInt(uint32_t value) { return { _mm_set1_epi32(static_cast<int>(value)) }; }
+    static inline Int4 operator&(Int4 a, Int4 b) { return { _mm_and_si128(a.V, b.V) }; }
+    static inline Int4 operator|(Int4 a, Int4 b) { return { _mm_or_si128(a.V, b.V) }; }
+    static inline Int4 AndNot(Int4 mask, Int4 value) { return { _mm_andnot_si128(mask.V, value.V) }; }
+    template<int N> static inline Int4 ShiftLeft(Int4 a) { return { _mm_slli_epi32(a.V, N) }; }
+    template<int N> static inline Int4 ShiftRight(Int4 a) { return { _mm_srli_epi32(a.V, N) }; }
+    static inline Float4 ToFloat(Int4 a) { return { _mm_cvtepi32_ps(a.V) }; }
+    static inline Int4 Truncate(Float4 a) { return { _mm_cvttps_epi32(a.V) }; }
+    static inline Int4 Load4(const uint32_t* pixels) { return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels)) }; }
+    static inline void Store4(uint32_t* pixels, Int4 value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), value.V); }
+    static inline uint32_t MaskBits(Int4 mask) { return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(mask.V))); }
+
+    /** Lanes x + i with start <= x + i < end. */
+    static inline Int4 RangeMask(int32_t x, int32_t start, int32_t end)
+    {
+        __m128i lanes = _mm_add_epi32(_mm_set1_epi32(x), _mm_setr_epi32(0, 1, 2, 3));
+        __m128i afterStart = _mm_cmpgt_epi32(lanes, _mm_set1_epi32(start - 1));
+        __m128i beforeEnd = _mm_cmplt_epi32(lanes, _mm_set1_epi32(end));
+        return { _mm_and_si128(afterStart, beforeEnd) };
+    }
+
+    static inline Int4 Gather(const uint32_t* row, Int4 indices)
+    {
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), indices.V);
+        return { _mm_setr_epi32(static_cast<int>(row[lanes[0]]), static_cast<int>(row[lanes[1]]),
+            static_cast<int>(row[lanes[2]]), static_cast<int>(row[lanes[3]])) };
+    }
+#else
+    struct Float4 { float V[4]; };
+    struct Int4 { uint32_t V[4]; };
+
+    template<typename T, typename F>
+    static inline T Lanewise(F&& function)
+    {
+        T result;
+        for (int i = 0; i < 4; i++)
+            result.V[i] = function(i);
+        return result;
+    }
+
+    static inline Float4 Splat(float value) { return Lanewise<Float4>([&](int) { return value; }); }
+    static inline Float4 Ramp(float start) { return Lanewise<Float4>([&](int i) { return start + static_cast<float>(i); }); }
+    static inline Float4 operator+(Float4 a, Float4 b) { return Lanewise<Float4>([&](int i) { return a.V[i] + b.V[i]; }); }
+    static inline Float4 operator-(Float4 a, Float4 b) { return Lanewise<Float4>([&](int i) { return a.V[i] - b.V[i]; }); }
+    static inline Float4 operator*(Float4 a, Float4 b) { return Lanewise<Float4>([&](int i) { return a.V[i] * b.V[i]; }); }
+    static inline Float4 Min(Float4 a, Float4 b) { return Lanewise<Float4>([&](int i) { return std::min(a.V[i], b.V[i]); }); }
+    static inline Float4 Max(Float4 a, Float4 b) { return Lanewise<Float4>([&](int i) { return std::max(a.V[i], b.V[i]); }); }
+    static inline Int4 CmpGt(Float4 a, Float4 b) { return Lanewise<Int4>([&](int i) { return a.V[i] > b.V[i] ? ~0u : 0u; }); }
+    static inline Int4 CmpEq(Float4 a, Float4 b) { return Lanewise<Int4>([&](int i) { return a.V[i] == b.V[i] ? ~0u : 0u; }); }
+
+    static inline Int4 SplatInt(uint32_t value) { return Lanewise<Int4>([&](int) { return value; }); }
+    static inline Int4 operator&(Int4 a, Int4 b) { return Lanewise<Int4>([&](int i) { return a.V[i] & b.V[i]; }); }
+    static inline Int4 operator|(Int4 a, Int4 b) { return Lanewise<Int4>([&](int i) { return a.V[i] | b.V[i]; }); }
+    static inline Int4 AndNot(Int4 mask, Int4 value) { return Lanewise<Int4>([&](int i) { return ~mask.V[i] & value.V[i]; }); }
+    template<int N> static inline Int4 ShiftLeft(Int4 a) { return Lanewise<Int4>([&](int i) { return a.V[i] << N; }); }
+    template<int N> static inline Int4 ShiftRight(Int4 a) { return Lanewise<Int4>([&](int i) { return a.V[i] >> N; }); }
+    static inline Float4 ToFloat(Int4 a) { return Lanewise<Float4>([&](int i) { return static_cast<float>(static_cast<int32_t>(a.V[i])); }); }
+    static inline Int4 Truncate(Float4 a) { return Lanewise<Int4>([&](int i) { return static_cast<uint32_t>(static_cast<int32_t>(a.V[i])); }); }
+    static inline Int4 Load4(const uint32_t* pixels) { return Lanewise<Int4>([&](int i) { return pixels[i]; }); }
+    static inline void Store4(uint32_t* pixels, Int4 value) { for (int i = 0; i < 4; i++) pixels[i] = value.V[i]; }
+
+    static inline uint32_t MaskBits(Int4 mask)
+    {
+        uint32_t bits = 0;
+        for (int i = 0; i < 4; i++)
+            bits |= (mask.V[i] >> 31) << i;
+        return bits;
+    }
+
+    static inline Int4 RangeMask(int32_t x, int32_t start, int32_t end)
+    {
+        return Lanewise<Int4>([&](int i) { return x + i >= start && x + i < end ? ~0u : 0u; });
+    }
+
+    static inline Int4 Gather(const uint32_t* row, Int4 indices)
+    {
+        return Lanewise<Int4>([&](int i) { return row[indices.V[i]]; });
+    }
+#endif
+
+    /** Four pixels split into channels, each 0..255. */
+    struct Color4
+    {
+        Float4 R, G, B, A;
+    };
+
+    static inline Color4 Unpack(Int4 pixels)
+    {
+        Int4 byteMask = SplatInt(0xFF);
+        return {
+            ToFloat(pixels & byteMask),
+            ToFloat(ShiftRight<8>(pixels) & byteMask),
+            ToFloat(ShiftRight<16>(pixels) & byteMask),
+            ToFloat(ShiftRight<24>(pixels))
+        };
+    }
+
+    static inline Int4 Pack(const Color4& color)
+    {
+        Float4 zero = Splat(0.0f), max = Splat(255.0f), half = Splat(0.5f);
+        auto channel = [&](Float4 value) { return Truncate(Min(Max(value, zero), max) + half); };
+
+        return channel(color.R) | ShiftLeft<8>(channel(color.G)) | ShiftLeft<16>(channel(color.B)) | ShiftLeft<24>(channel(color.A));
+    }
+
+    static inline Color4 BlendOver(const Color4& source, const Color4& destination)
+    {
+        Float4 alpha = source.A * Splat(1.0f / 255.0f);
+        return {
+            destination.R + (source.R - destination.R) * alpha,
+            destination.G + (source.G - destination.G) * alpha,
+            destination.B + (source.B - destination.B) * alpha,
+            source.A + destination.A * (Splat(1.0f) - alpha)
+        };
+    }
+
+    /** Writes the masked lanes of four pixels, blending over what is there if requested. */
+    static inline void WritePixels(uint32_t* destination, Int4 mask, const Color4& color, bool blend)
+    {
+        Int4 old = Load4(destination);
+        Int4 pixels = Pack(blend ? BlendOver(color, Unpack(old)) : color);
+        Store4(destination, (mask & pixels) | AndNot(mask, old));
+    }
+
+    static inline float Channel(uint32_t color, int channel)
+    {
+        return static_cast<float>((color >> (channel * 8)) & 0xFF);
+    }
+
+    SoftwareRasterizer::SoftwareRasterizer(JobSystem& jobSystem, uint32_t width, uint32_t height)
+        : m_JobSystem(jobSystem), m_Framebuffer(width, height)
+    {
+        Resize(width, height);
+    }
+
+    void SoftwareRasterizer::Resize(uint32_t width, uint32_t height)
+    {
+        m_Framebuffer.Resize(width, height);
+
+        m_TilesX = (width + TileSize - 1) / TileSize;
+        m_TilesY = (height + TileSize - 1) / TileSize;
+        m_Bins.resize(static_cast<size_t>(m_TilesX) * m_TilesY);
+        m_TilePixels.resize(m_Bins.size());
+    }
+
+    void SoftwareRasterizer::BeginFrame(uint32_t clearColor)
+    {
+        m_ClearColor = clearColor;
+        m_Triangles.clear();
+        m_Quads.clear();
+
+        for (std::vector<uint32_t>& bin : m_Bins)
+            bin.clear();
+
+        m_Stats = RasterizerStats();
+    }
+
+    void SoftwareRasterizer::DrawTriangle(const RasterVertex& v0, const RasterVertex& v1, const RasterVertex& v2)
+    {
+        const RasterVertex* vertices[3] = { &v0, &v1, &v2 };
+
+        float area = (v1.X - v0.X) * (v2.Y - v0.Y) - (v1.Y - v0.Y) * (v2.X - v0.X);
+        if (area == 0.0f)
+            return;
+
+        // Orient every edge so the inside is positive, whatever the winding
+        float sign = area > 0.0f ? 1.0f : -1.0f;
+
+        TriangleSetup setup;
+        setup.InvArea = 1.0f / (area * sign);
+
+        for (int i = 0; i < 3; i++)
+        {
+            // Edge i runs between the two vertices other than i, so its value is vertex i's weight
+            const RasterVertex& a = *vertices[(i + 1) % 3];
+            const RasterVertex& b = *vertices[(i + 2) % 3];
+
+            setup.EdgeA[i] = -(b.Y - a.Y) * sign;
+            setup.EdgeB[i] = (b.X - a.X) * sign;
+            setup.EdgeX[i] = a.X;
+            setup.EdgeY[i] = a.Y;
+
+            // Pixel centers exactly on an edge belong to left edges and flat top edges only
+            setup.TopLeft[i] = setup.EdgeA[i] > 0.0f || (setup.EdgeA[i] == 0.0f && setup.EdgeB[i] > 0.0f);
+
+            for (int c = 0; c < 4; c++)
+                setup.Color[i][c] = Channel(vertices[i]->Color, c);
+        }
+
+        float minX = std::min({ v0.X, v1.X, v2.X }), maxX = std::max({ v0.X, v1.X, v2.X });
+        float minY = std::min({ v0.Y, v1.Y, v2.Y }), maxY = std::max({ v0.Y, v1.Y, v2.Y });
+
+        setup.MinX = std::max(static_cast<int32_t>(std::floor(minX)), 0);
+        setup.MinY = std::max(static_cast<int32_t>(std::floor(minY)), 0);
+        setup.MaxX = std::min(static_cast<int32_t>(std::ceil(maxX)), static_cast<int32_t>(m_Framebuffer.GetWidth()) - 1);
+        setup.MaxY = std::min(static_cast<int32_t>(std::ceil(maxY)), static_cast<int32_t>(m_Framebuffer.GetHeight()) - 1);
+        if (setup.MinX > setup.MaxX || setup.MinY > setup.MaxY)
+            return;
+
+        setup.Blend = (v0.Color >> 24) < 255 || (v1.Color >> 24) < 255 || (v2.Color >> 24) < 255;
+
+        m_Triangles.push_back(setup);
+        m_Stats.Triangles++;
+        Bin(static_cast<uint32_t>(m_Triangles.size() - 1), setup.MinX, setup.MinY, setup.MaxX, setup.MaxY);
+    }
+
+    void SoftwareRasterizer::DrawQuad(float x, float y, float width, float height, uint32_t color)
+    {
+        DrawQuad(x, y, width, height, RasterTexture(), 0.0f, 0.0f, 1.0f, 1.0f, color);
+    }
+
+    void SoftwareRasterizer::DrawQuad(float x, float y, float width, float height, const RasterTexture& texture,
+        float u0, float v0, float u1, float v1, uint32_t tint)
+    {
+        if (width <= 0.0f || height <= 0.0f)
+            return;
+
+        QuadSetup setup;
+        setup.X0 = x;
+        setup.Y0 = y;
+        setup.X1 = x + width;
+        setup.Y1 = y + height;
+        setup.Texture = texture.Pixels && texture.Width && texture.Height ? texture : RasterTexture();
+        setup.Color = tint;
+
+        // Texel coordinates at pixel center p are U0 + p * DU
+        setup.DU = (u1 - u0) / width * static_cast<float>(setup.Texture.Width);
+        setup.DV = (v1 - v0) / height * static_cast<float>(setup.Texture.Height);
+        setup.U0 = u0 * static_cast<float>(setup.Texture.Width) - x * setup.DU;
+        setup.V0 = v0 * static_cast<float>(setup.Texture.Height) - y * setup.DV;
+
+        // Covered pixels are those whose centers fall inside [X0, X1) x [Y0, Y1)
+        setup.MinX = std::max(static_cast<int32_t>(std::ceil(setup.X0 - 0.5f)), 0);
+        setup.MinY = std::max(static_cast<int32_t>(std::ceil(setup.Y0 - 0.5f)), 0);
+        setup.MaxX = std::min(static_cast<int32_t>(std::ceil(setup.X1 - 0.5f)) - 1, static_cast<int32_t>(m_Framebuffer.GetWidth()) - 1);
+        setup.MaxY = std::min(static_cast<int32_t>(std::ceil(setup.Y1 - 0.5f)) - 1, static_cast<int32_t>(m_Framebuffer.GetHeight()) - 1);
+        if (setup.MinX > setup.MaxX || setup.MinY > setup.MaxY)
+            return;
+
+        setup.Blend = setup.Texture.Pixels || (tint >> 24) < 255;
+
+        m_Quads.push_back(setup);
+        m_Stats.Quads++;
+        Bin(static_cast<uint32_t>(m_Quads.size() - 1) | QuadFlag, setup.MinX, setup.MinY, setup.MaxX, setup.MaxY);
+    }
+
+    void SoftwareRasterizer::Bin(uint32_t entry, int32_t minX, int32_t minY, int32_t maxX, int32_t maxY)
+    {
+        uint32_t tileX0 = static_cast<uint32_t>(minX) / TileSize, tileX1 = static_cast<uint32_t>(maxX) / TileSize;
+        uint32_t tileY0 = static_cast<uint32_t>(minY) / TileSize, tileY1 = static_cast<uint32_t>(maxY) / TileSize;
+
+        for (uint32_t ty = tileY0; ty <= tileY1; ty++)
+        {
+            for (uint32_t tx = tileX0; tx <= tileX1; tx++)
+                m_Bins[ty * m_TilesX + tx].push_back(entry);
+        }
+
+        m_Stats.BinnedPrimitives += (tileX1 - tileX0 + 1) * (tileY1 - tileY0 + 1);
+    }
+
+    void SoftwareRasterizer::EndFrame()
+    {
+        VEX_PROFILE_FUNCTION();
+
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point start = Clock::now();
+
+        // One job per tile; each job owns its tile's pixels outright
+        m_JobSystem.ParallelFor(static_cast<uint32_t>(m_Bins.size()), 1, [this](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t tile = begin; tile < end; tile++)
+                m_TilePixels[tile] = RenderTile(tile);
+        });
+
+        for (uint64_t pixels : m_TilePixels)
+            m_Stats.PixelsShaded += pixels;
+
+        m_Stats.RasterMilliseconds = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    }
+
+    uint64_t SoftwareRasterizer::RenderTile(uint32_t tileIndex)
+    {
+        int32_t tileX0 = static_cast<int32_t>((tileIndex % m_TilesX) * TileSize);
+        int32_t tileY0 = static_cast<int32_t>((tileIndex / m_TilesX) * TileSize);
+        int32_t tileX1 = std::min(tileX0 + static_cast<int32_t>(TileSize), static_cast<int32_t>(m_Framebuffer.GetWidth()));
+        int32_t tileY1 = std::min(tileY0 + static_cast<int32_t>(TileSize), static_cast<int32_t>(m_Framebuffer.GetHeight()));
+
+        for (int32_t y = tileY0; y < tileY1; y++)
+            std::fill(m_Framebuffer.GetRow(y) + tileX0, m_Framebuffer.GetRow(y) + tileX1, m_ClearColor);
+
+        uint64_t pixelsShaded = 0;
+        const Float4 zero = Splat(0.0f);
+
+        for (uint32_t entry : m_Bins[tileIndex])
+        {
+            if (entry & QuadFlag)
+            {
+                const QuadSetup& quad = m_Quads[entry & ~QuadFlag];
+
+                int32_t xStart = std::max(quad.MinX, tileX0), xEnd = std::min(quad.MaxX + 1, tileX1);
+                int32_t yStart = std::max(quad.MinY, tileY0), yEnd = std::min(quad.MaxY + 1, tileY1);
+                int32_t xAligned = xStart & ~3;
+
+                Color4 tint = { Splat(Channel(quad.Color, 0)), Splat(Channel(quad.Color, 1)), Splat(Channel(quad.Color, 2)), Splat(Channel(quad.Color, 3)) };
+                Int4 solid = SplatInt(quad.Color);
+                pixelsShaded += static_cast<uint64_t>(xEnd - xStart) * static_cast<uint64_t>(yEnd - yStart);
+
+                for (int32_t y = yStart; y < yEnd; y++)
+                {
+                    uint32_t* row = m_Framebuffer.GetRow(y);
+
+                    if (!quad.Blend)
+                    {
+                        for (int32_t x = xAligned; x < xEnd; x += 4)
+                        {
+                            if (x >= xStart && x + 4 <= xEnd)
+                            {
+                                Store4(row + x, solid);
+                                continue;
+                            }
+
+                            Int4 mask = RangeMask(x, xStart, xEnd);
+                            Store4(row + x, (mask & solid) | AndNot(mask, Load4(row + x)));
+                        }
+                        continue;
+                    }
+
+                    if (!quad.Texture.Pixels)
+                    {
+                        for (int32_t x = xAligned; x < xEnd; x += 4)
+                            WritePixels(row + x, RangeMask(x, xStart, xEnd), tint, true);
+                        continue;
+                    }
+
+                    // Nearest sampling; clamp in float before truncating so edge texels repeat
+                    const RasterTexture& texture = quad.Texture;
+                    float v = quad.V0 + (static_cast<float>(y) + 0.5f) * quad.DV;
+                    uint32_t texelY = static_cast<uint32_t>(std::clamp(v, 0.0f, static_cast<float>(texture.Height - 1)));
+                    const uint32_t* texelRow = texture.Pixels + static_cast<size_t>(texelY) * texture.Width;
+
+                    Float4 uMax = Splat(static_cast<float>(texture.Width - 1));
+                    Float4 du = Splat(quad.DU), u0 = Splat(quad.U0);
+                    Float4 scale = Splat(1.0f / 255.0f);
+
+                    for (int32_t x = xAligned; x < xEnd; x += 4)
+                    {
+                        Float4 u = Min(Max(u0 + Ramp(static_cast<float>(x) + 0.5f) * du, zero), uMax);
+                        Color4 texel = Unpack(Gather(texelRow, Truncate(u)));
+
+                        Color4 color = {
+                            texel.R * tint.R * scale, texel.G * tint.G * scale,
+                            texel.B * tint.B * scale, texel.A * tint.A * scale
+                        };
+                        WritePixels(row + x, RangeMask(x, xStart, xEnd), color, true);
+                    }
+                }
+                continue;
+            }
+
+            const TriangleSetup& triangle = m_Triangles[entry];
+
+            int32_t xStart = std::max(triangle.MinX, tileX0) & ~3;
+            int32_t xEnd = std::min(triangle.MaxX + 1, tileX1);
+            int32_t yStart = std::max(triangle.MinY, tileY0), yEnd = std::min(triangle.MaxY + 1, tileY1);
+
+            Float4 edgeA[3], edgeStep[3];
+            Int4 topLeft[3];
+            for (int i = 0; i < 3; i++)
+            {
+                edgeA[i] = Splat(triangle.EdgeA[i]);
+                edgeStep[i] = Splat(triangle.EdgeA[i] * 4.0f);
+                topLeft[i] = SplatInt(triangle.TopLeft[i] ? ~0u : 0u);
+            }
+
+            Float4 invArea = Splat(triangle.InvArea);
+            Float4 vertexColor[3][4];
+            for (int i = 0; i < 3; i++)
+            {
+                for (int c = 0; c < 4; c++)
+                    vertexColor[i][c] = Splat(triangle.Color[i][c]);
+            }
+
+            for (int32_t y = yStart; y < yEnd; y++)
+            {
+                uint32_t* row = m_Framebuffer.GetRow(y);
+                float py = static_cast<float>(y) + 0.5f;
+
+                // Edge values for the first four pixels of the row; stepped four pixels at a time from there
+                Float4 px = Ramp(static_cast<float>(xStart) + 0.5f);
+                Float4 edge[3];
+                for (int i = 0; i < 3; i++)
+                    edge[i] = edgeA[i] * (px - Splat(triangle.EdgeX[i])) + Splat(triangle.EdgeB[i] * (py - triangle.EdgeY[i]));
+
+                for (int32_t x = xStart; x < xEnd; x += 4)
+                {
+                    Int4 mask = RangeMask(x, x, xEnd);
+                    for (int i = 0; i < 3; i++)
+                        mask = mask & (CmpGt(edge[i], zero) | (CmpEq(edge[i], zero) & topLeft[i]));
+
+                    uint32_t bits = MaskBits(mask);
+                    if (bits)
+                    {
+                        Float4 w0 = edge[0] * invArea, w1 = edge[1] * invArea, w2 = edge[2] * invArea;
+                        Color4 color = {
+                            w0 * vertexColor[0][0] + w1 * vertexColor[1][0] + w2 * vertexColor[2][0],
+                            w0 * vertexColor[0][1] + w1 * vertexColor[1][1] + w2 * vertexColor[2][1],
+                            w0 * vertexColor[0][2] + w1 * vertexColor[1][2] + w2 * vertexColor[2][2],
+                            w0 * vertexColor[0][3] + w1 * vertexColor[1][3] + w2 * vertexColor[2][3]
+                        };
+
+                        WritePixels(row + x, mask, color, triangle.Blend);
+                        pixelsShaded += std::popcount(bits);
+                    }
+
+                    for (int i = 0; i < 3; i++)
+                        edge[i] = edge[i] + edgeStep[i];
+                }
+            }
+        }
+
+        return pixelsShaded;
+    }
+
+    bool SoftwareRasterizer::Present([[maybe_unused]] Window& window)
+    {
+#ifdef VEX_PLATFORM_WINDOWS
+        SDL_Window* sdlWindow = static_cast<SDL_Window*>(window.GetNativeWindow());
+        if (!sdlWindow)
+            return false;
+
+        SDL_Surface* surface = SDL_GetWindowSurface(sdlWindow);
+        if (!surface || surface->format->BytesPerPixel != 4 || SDL_LockSurface(surface) != 0)
+            return false;
+
+        // Window surfaces are usually B, G, R, X in memory; the framebuffer is R, G, B, A
+        bool swapRedBlue = surface->format->Rmask == 0x00FF0000u;
+        uint32_t width = std::min(static_cast<uint32_t>(surface->w), m_Framebuffer.GetWidth());
+        uint32_t height = std::min(static_cast<uint32_t>(surface->h), m_Framebuffer.GetHeight());
+
+        for (uint32_t y = 0; y < height; y++)
+        {
+            const uint32_t* source = m_Framebuffer.GetRow(y);
+            uint32_t* destination = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(surface->pixels) + static_cast<size_t>(y) * surface->pitch);
+
+            if (!swapRedBlue)
+            {
+                std::copy(source, source + width, destination);
+                continue;
+            }
+
+            for (uint32_t x = 0; x < width; x++)
+            {
+                uint32_t pixel = source[x];
+                destination[x] = (pixel & 0xFF00FF00u) | ((pixel & 0xFFu) << 16) | ((pixel >> 16) & 0xFFu);
+            }
+        }
+
+        SDL_UnlockSurface(surface);
+        return SDL_UpdateWindowSurface(sdlWindow) == 0;
+#else
+        return false;
+#endif
+    }
+}
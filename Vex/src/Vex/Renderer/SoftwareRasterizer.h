@@ -0,0 +1,140 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Vex/Renderer/Framebuffer.h"
+
+#include <vector>
+
+namespace Vex
+{
+    class JobSystem;
+    class Window;
+
+    /**
+     * Screen-space vertex: position in pixels (origin top-left) and a packed RGBA color.
+     */
+    struct RasterVertex
+    {
+        float X, Y;
+        uint32_t Color;
+    };
+
+    /**
+     * Non-owning view of RGBA pixels sampled by textured quads. Must stay alive until EndFrame() returns.
+     */
+    struct RasterTexture
+    {
+        const uint32_t* Pixels = nullptr;
+        uint32_t Width = 0, Height = 0;
+    };
+
+    /**
+     * Counters of the last frame rendered.
+     */
+    struct RasterizerStats
+    {
+        uint32_t Triangles = 0;
+        uint32_t Quads = 0;
+        uint32_t BinnedPrimitives = 0;  ///< Primitive references across all tile bins.
+        uint64_t PixelsShaded = 0;      ///< Pixels covered, counting overdraw.
+        float RasterMilliseconds = 0.0f;
+    };
+
+    /**
+     * @class SoftwareRasterizer
+     * @brief Tile-based CPU renderer for machines without a GPU.
+     *
+     * Primitives are set up as they are submitted and binned into the TileSize x TileSize tiles their
+     * bounds touch. EndFrame() hands every tile to the job system; a tile
+     * clears its pixels and rasterizes its bin in submission order, so tiles never share pixels and
+     * need no synchronization. Triangles are traversed with edge functions four pixels at a time and
+     * interpolate vertex colors; quads are axis-aligned, solid or textured (nearest, tinted). Colors with
+     * alpha below 255 and textures are blended over the framebuffer.
+     *
+     * Uses SSE2 on x86-64 and a scalar fallback elsewhere. Submission and EndFrame() belong to one thread.
+     */
+    class VEX_API SoftwareRasterizer
+    {
+    public:
+        static constexpr uint32_t TileSize = 64;
+
+        SoftwareRasterizer(JobSystem& jobSystem, uint32_t width, uint32_t height);
+
+        /** Resizes the framebuffer and the tile grid. Not allowed inside a frame. */
+        void Resize(uint32_t width, uint32_t height);
+
+        /**
+         * @brief Starts a frame; every tile is cleared to the given color when it is rendered.
+         */
+        void BeginFrame(uint32_t clearColor);
+
+        void DrawTriangle(const RasterVertex& v0, const RasterVertex& v1, const RasterVertex& v2);
+
+        /** @brief Draws a solid axis-aligned rectangle. */
+        void DrawQuad(float x, float y, float width, float height, uint32_t color);
+
+        /**
+         * @brief Draws an axis-aligned rectangle sampling a texture, multiplied by a tint.
+         * @param u0,v0,u1,v1 Texture coordinates of the top-left and bottom-right corners, in [0, 1].
+         */
+        void DrawQuad(float x, float y, float width, float height, const RasterTexture& texture,
+            float u0, float v0, float u1, float v1, uint32_t tint = 0xFFFFFFFFu);
+
+        /** @brief Renders all tiles in parallel. Blocks until done. */
+        void EndFrame();
+
+        /**
+         * @brief Copies the framebuffer to the window's SDL surface.
+         *
+         * Call from the thread that created the window. Not for windows presented through Vulkan.
+         * @return False if the window has no surface (e.g. headless).
+         */
+        bool Present(Window& window);
+
+        Framebuffer& GetFramebuffer() { return m_Framebuffer; }
+        const RasterizerStats& GetStats() const { return m_Stats; }
+
+    private:
+        /** Triangle after setup: edge equations, bounds and per-channel colors. */
+        struct TriangleSetup
+        {
+            float EdgeA[3], EdgeB[3];   ///< Edge function coefficients; inside is positive.
+            float EdgeX[3], EdgeY[3];   ///< Point each edge function is evaluated relative to.
+            bool TopLeft[3];            ///< Edge owns pixel centers exactly on it.
+            float InvArea;
+            float Color[3][4];          ///< RGBA of each vertex, 0..255.
+            int32_t MinX, MinY, MaxX, MaxY;
+            bool Blend;
+        };
+
+        struct QuadSetup
+        {
+            float X0, Y0, X1, Y1;       ///< Covered pixel centers satisfy X0 <= x + 0.5 < X1.
+            float U0, V0, DU, DV;       ///< Texture coordinate at (X0, Y0) and per pixel.
+            RasterTexture Texture;
+            uint32_t Color;
+            int32_t MinX, MinY, MaxX, MaxY;
+            bool Blend;
+        };
+
+        static constexpr uint32_t QuadFlag = 1u << 31;  ///< Marks a bin entry as an index into m_Quads.
+
+        void Bin(uint32_t entry, int32_t minX, int32_t minY, int32_t maxX, int32_t maxY);
+
+        /** Clears and renders one tile; returns the number of pixels shaded. */
+        uint64_t RenderTile(uint32_t tileIndex);
+
+        JobSystem& m_JobSystem;
+        Framebuffer m_Framebuffer;
+
+        uint32_t m_TilesX = 0, m_TilesY = 0;
+        std::vector<std::vector<uint32_t>> m_Bins;  ///< Per tile, primitives in submission order. Capacity is kept across frames.
+        std::vector<uint64_t> m_TilePixels;         ///< Pixels shaded per tile this frame.
+
+        std::vector<TriangleSetup> m_Triangles;
+        std::vector<QuadSetup> m_Quads;
+        uint32_t m_ClearColor = 0;
+
+        RasterizerStats m_Stats;
+    };
+}
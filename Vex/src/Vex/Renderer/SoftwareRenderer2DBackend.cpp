@@ -0,0 +1,53 @@
+﻿#include "VexPch.h"
+#include "SoftwareRenderer2DBackend.h"
+
+#include "Vex/Renderer/SoftwareRasterizer.h"
+
+namespace Vex
+{
+    SoftwareRenderer2DBackend::SoftwareRenderer2DBackend(SoftwareRasterizer& rasterizer)
+        : m_Rasterizer(rasterizer)
+    {
+    }
+
+    TextureHandle SoftwareRenderer2DBackend::CreateTexture(const uint32_t* pixels, uint32_t width, uint32_t height)
+    {
+        m_Textures.push_back({ std::vector<uint32_t>(pixels, pixels + static_cast<size_t>(width) * height), width, height });
+        return static_cast<TextureHandle>(m_Textures.size());
+    }
+
+    QuadVertex* SoftwareRenderer2DBackend::MapVertices(uint32_t vertexCount)
+    {
+        // The rasterizer copies what it needs at submission, so one buffer serves every frame
+        if (m_Vertices.size() < vertexCount)
+            m_Vertices.resize(vertexCount);
+        return m_Vertices.data();
+    }
+
+    void SoftwareRenderer2DBackend::Submit(const Renderer2DDrawCall* drawCalls, uint32_t drawCallCount)
+    {
+        for (uint32_t i = 0; i < drawCallCount; i++)
+        {
+            const Renderer2DDrawCall& drawCall = drawCalls[i];
+
+            RasterTexture texture;
+            if (drawCall.Texture != 0 && drawCall.Texture <= m_Textures.size())
+            {
+                const Texture& source = m_Textures[drawCall.Texture - 1];
+                texture = { source.Pixels.data(), source.Width, source.Height };
+            }
+
+            // Corners 0 and 2 are top-left and bottom-right
+            const QuadVertex* quad = m_Vertices.data() + drawCall.FirstVertex;
+            for (uint32_t q = 0; q < drawCall.QuadCount; q++, quad += 4)
+            {
+                float width = quad[2].X - quad[0].X, height = quad[2].Y - quad[0].Y;
+
+                if (texture.Pixels)
+                    m_Rasterizer.DrawQuad(quad[0].X, quad[0].Y, width, height, texture, quad[0].U, quad[0].V, quad[2].U, quad[2].V, quad[0].Color);
+                else
+                    m_Rasterizer.DrawQuad(quad[0].X, quad[0].Y, width, height, quad[0].Color);
+            }
+        }
+    }
+}
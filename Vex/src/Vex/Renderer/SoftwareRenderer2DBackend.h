@@ -0,0 +1,37 @@
+﻿#pragma once
+
+#include "Vex/Renderer/Renderer2DBackend.h"
+
+#include <vector>
+
+namespace Vex
+{
+    class SoftwareRasterizer;
+
+    /**
+     * Renderer2D backend drawing through a SoftwareRasterizer.
+     *
+     * Renderer2D::EndScene() must be called between the rasterizer's BeginFrame() and EndFrame(); the
+     * draw calls are turned into rasterizer quads in sorted order.
+     */
+    class VEX_API SoftwareRenderer2DBackend : public Renderer2DBackend
+    {
+    public:
+        explicit SoftwareRenderer2DBackend(SoftwareRasterizer& rasterizer);
+
+        TextureHandle CreateTexture(const uint32_t* pixels, uint32_t width, uint32_t height) override;
+        QuadVertex* MapVertices(uint32_t vertexCount) override;
+        void Submit(const Renderer2DDrawCall* drawCalls, uint32_t drawCallCount) override;
+
+    private:
+        struct Texture
+        {
+            std::vector<uint32_t> Pixels;
+            uint32_t Width, Height;
+        };
+
+        SoftwareRasterizer& m_Rasterizer;
+        std::vector<Texture> m_Textures;    ///< Handle n is m_Textures[n - 1].
+        std::vector<QuadVertex> m_Vertices;
+    };
+}
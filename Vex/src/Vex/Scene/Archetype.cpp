@@ -0,0 +1,178 @@
+﻿#include "VexPch.h"
+#include "Archetype.h"
+
+#include "Vex/Log.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace Vex
+{
+    static constexpr std::align_val_t ChunkAlignment{ 64 };
+
+    static uint32_t AlignUp(uint32_t value, uint32_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    Archetype::Archetype(const ComponentMask& mask)
+        : m_Mask(mask)
+    {
+        std::fill(std::begin(m_ColumnOfType), std::end(m_ColumnOfType), -1);
+
+        uint32_t bytesPerEntity = sizeof(Entity);
+        for (ComponentTypeId type = 0; type < MaxComponentTypes; type++)
+        {
+            if (!mask.Has(type))
+                continue;
+
+            const ComponentInfo& info = ComponentRegistry::GetInfo(type);
+            m_ColumnOfType[type] = static_cast<int32_t>(m_Columns.size());
+            m_Types.push_back(type);
+            m_Columns.push_back({ type, 0, info.Size, &info });
+            bytesPerEntity += info.Size;
+        }
+
+        // Largest capacity whose arrays, each aligned for its type (and at least 16 bytes for SIMD), fit the chunk
+        auto layout = [this](uint32_t capacity)
+        {
+            uint32_t offset = capacity * static_cast<uint32_t>(sizeof(Entity));
+            for (Column& column : m_Columns)
+            {
+                offset = AlignUp(offset, std::max(column.Info->Alignment, 16u));
+                column.Offset = offset;
+                offset += capacity * column.Size;
+            }
+            return offset;
+        };
+
+        m_ChunkCapacity = ChunkSize / bytesPerEntity;
+        while (m_ChunkCapacity > 0 && layout(m_ChunkCapacity) > ChunkSize)
+            m_ChunkCapacity--;
+
+        // Without a single row per chunk AllocateRow would write past the chunk
+        if (m_ChunkCapacity == 0)
+        {
+            VEX_CORE_FATAL("Components of an archetype ({0} bytes per entity) exceed the {1} byte chunk size", bytesPerEntity, ChunkSize);
+            Log::Shutdown();  // Flushes the message before the process dies
+            std::abort();
+        }
+    }
+
+    Archetype::~Archetype()
+    {
+        for (uint32_t chunkIndex = 0; chunkIndex < m_Chunks.size(); chunkIndex++)
+        {
+            for (uint32_t row = 0; row < m_Chunks[chunkIndex].Count; row++)
+                DestroyRow({ chunkIndex, row });
+
+            ::operator delete(m_Chunks[chunkIndex].Data, ChunkAlignment);
+        }
+    }
+
+    void Archetype::FreeChunks(std::vector<std::byte*>& chunks)
+    {
+        for (std::byte* chunk : chunks)
+            ::operator delete(chunk, ChunkAlignment);
+        chunks.clear();
+    }
+
+    uint32_t Archetype::GetEntityCount() const
+    {
+        if (m_Chunks.empty())
+            return 0;
+
+        return static_cast<uint32_t>(m_Chunks.size() - 1) * m_ChunkCapacity + m_Chunks.back().Count;
+    }
+
+    Archetype::Location Archetype::AllocateRow(Entity entity, std::vector<std::byte*>& freeChunks)
+    {
+        if (m_Chunks.empty() || m_Chunks.back().Count == m_ChunkCapacity)
+        {
+            Chunk chunk;
+            if (!freeChunks.empty())
+            {
+                chunk.Data = freeChunks.back();
+                freeChunks.pop_back();
+            }
+            else
+            {
+                chunk.Data = static_cast<std::byte*>(::operator new(ChunkSize, ChunkAlignment));
+            }
+            m_Chunks.push_back(chunk);
+        }
+
+        uint32_t chunkIndex = static_cast<uint32_t>(m_Chunks.size() - 1);
+        Chunk& chunk = m_Chunks[chunkIndex];
+        uint32_t row = chunk.Count++;
+        GetEntities(chunk)[row] = entity;
+        return { chunkIndex, row };
+    }
+
+    Entity Archetype::RemoveRow(Location location, std::vector<std::byte*>& freeChunks)
+    {
+        Chunk& last = m_Chunks.back();
+        uint32_t lastChunkIndex = static_cast<uint32_t>(m_Chunks.size() - 1);
+        uint32_t lastRow = last.Count - 1;
+
+        Entity moved;
+        if (location.ChunkIndex != lastChunkIndex || location.Row != lastRow)
+        {
+            // Keep the archetype dense: the last entity takes over the hole
+            Location from = { lastChunkIndex, lastRow };
+            for (int32_t column = 0; column < static_cast<int32_t>(m_Columns.size()); column++)
+            {
+                void* source = GetComponent(from, column);
+                void* destination = GetComponent(location, column);
+                if (m_Columns[column].Info->Relocate)
+                    m_Columns[column].Info->Relocate(destination, source);
+                else
+                    std::memcpy(destination, source, m_Columns[column].Size);
+            }
+
+            moved = GetEntities(last)[lastRow];
+            GetEntities(m_Chunks[location.ChunkIndex])[location.Row] = moved;
+        }
+
+        if (--last.Count == 0)
+        {
+            freeChunks.push_back(last.Data);
+            m_Chunks.pop_back();
+        }
+
+        return moved;
+    }
+
+    void Archetype::DestroyRow(Location location)
+    {
+        for (int32_t column = 0; column < static_cast<int32_t>(m_Columns.size()); column++)
+        {
+            if (m_Columns[column].Info->Destroy)
+                m_Columns[column].Info->Destroy(GetComponent(location, column));
+        }
+    }
+
+    void Archetype::MoveRow(Location from, Archetype& destination, Location to)
+    {
+        for (int32_t column = 0; column < static_cast<int32_t>(m_Columns.size()); column++)
+        {
+            const Column& source = m_Columns[column];
+            void* component = GetComponent(from, column);
+
+            int32_t destinationColumn = destination.GetColumn(source.Type);
+            if (destinationColumn < 0)
+            {
+                if (source.Info->Destroy)
+                    source.Info->Destroy(component);
+                continue;
+            }
+
+            void* target = destination.GetComponent(to, destinationColumn);
+            if (source.Info->Relocate)
+                source.Info->Relocate(target, component);
+            else
+                std::memcpy(target, component, source.Size);
+        }
+    }
+}
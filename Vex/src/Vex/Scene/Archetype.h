@@ -0,0 +1,136 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Vex/Scene/Component.h"
+
+#include <vector>
+
+namespace Vex
+{
+    /**
+     * Handle to an entity. The generation tells a destroyed entity apart from a later one that reuses its index.
+     */
+    struct Entity
+    {
+        uint32_t Index = UINT32_MAX;
+        uint32_t Generation = 0;
+
+        bool IsValid() const { return Index != UINT32_MAX; }
+        bool operator==(const Entity& other) const { return Index == other.Index && Generation == other.Generation; }
+        bool operator!=(const Entity& other) const { return !(*this == other); }
+    };
+
+    /**
+     * Fixed-size block holding up to an archetype's ChunkCapacity entities, one array per component.
+     */
+    struct Chunk
+    {
+        std::byte* Data = nullptr;
+        uint32_t Count = 0;
+    };
+
+    /**
+     * @class Archetype
+     * @brief Storage for every entity with exactly one set of component types.
+     *
+     * Entities live in ChunkSize chunks laid out as structure-of-arrays: the chunk starts with the
+     * entity handles, followed by one tightly packed array per component type, each sized for
+     * ChunkCapacity entities. Chunks are filled in order and kept dense: every chunk but the last
+     * is full, and removing an entity moves the archetype's last entity into the hole.
+     *
+     * Owned by a World, which keeps the entity records up to date as rows move.
+     */
+    class VEX_API Archetype
+    {
+    public:
+        static constexpr uint32_t ChunkSize = 16 * 1024;
+
+        /** Row of an entity inside an archetype. */
+        struct Location
+        {
+            uint32_t ChunkIndex;
+            uint32_t Row;
+        };
+
+        Archetype(const ComponentMask& mask);
+        ~Archetype();
+
+        Archetype(const Archetype&) = delete;
+        Archetype& operator=(const Archetype&) = delete;
+
+        /**
+         * @brief Appends a row for the entity. Its components are left uninitialized for the caller to construct.
+         * @param freeChunks Chunk memory to take from before allocating.
+         */
+        Location AllocateRow(Entity entity, std::vector<std::byte*>& freeChunks);
+
+        /**
+         * @brief Removes a row whose components have already been destroyed or moved out.
+         *
+         * The last entity of the archetype moves into the hole and is returned, or an invalid Entity if the
+         * removed row was the last one. An emptied chunk goes back to freeChunks.
+         */
+        Entity RemoveRow(Location location, std::vector<std::byte*>& freeChunks);
+
+        /** Returns chunk memory collected by RemoveRow() to the system. */
+        static void FreeChunks(std::vector<std::byte*>& chunks);
+
+        /** Destroys every component in a row. */
+        void DestroyRow(Location location);
+
+        /**
+         * @brief Moves a row's components into a row of another archetype.
+         *
+         * Types both archetypes have are relocated; types the destination lacks are destroyed, and types
+         * only the destination has are left uninitialized. The source row is left to RemoveRow().
+         */
+        void MoveRow(Location from, Archetype& destination, Location to);
+
+        /** @return Index of the type's array, or -1 if the archetype does not have the type. */
+        int32_t GetColumn(ComponentTypeId type) const { return m_ColumnOfType[type]; }
+
+        /** @return Start of a component array in a chunk. */
+        std::byte* GetColumnData(const Chunk& chunk, int32_t column) const { return chunk.Data + m_Columns[column].Offset; }
+
+        /** @return A component of the entity in a row; column comes from GetColumn(). */
+        void* GetComponent(Location location, int32_t column) const
+        {
+            const Column& array = m_Columns[column];
+            return m_Chunks[location.ChunkIndex].Data + array.Offset + static_cast<size_t>(location.Row) * array.Size;
+        }
+
+        Entity* GetEntities(const Chunk& chunk) const { return reinterpret_cast<Entity*>(chunk.Data); }
+
+        const ComponentMask& GetMask() const { return m_Mask; }
+        const std::vector<ComponentTypeId>& GetTypes() const { return m_Types; }
+        std::vector<Chunk>& GetChunks() { return m_Chunks; }
+        const std::vector<Chunk>& GetChunks() const { return m_Chunks; }
+        uint32_t GetChunkCapacity() const { return m_ChunkCapacity; }
+        uint32_t GetEntityCount() const;
+
+        /** @return The archetype reached by adding (or removing) a type, if the World has cached it. */
+        Archetype* GetAddEdge(ComponentTypeId type) const { return m_AddEdges[type]; }
+        Archetype* GetRemoveEdge(ComponentTypeId type) const { return m_RemoveEdges[type]; }
+        void SetAddEdge(ComponentTypeId type, Archetype* archetype) { m_AddEdges[type] = archetype; }
+        void SetRemoveEdge(ComponentTypeId type, Archetype* archetype) { m_RemoveEdges[type] = archetype; }
+
+    private:
+        struct Column
+        {
+            ComponentTypeId Type;
+            uint32_t Offset;    ///< Of the array from the start of the chunk.
+            uint32_t Size;
+            const ComponentInfo* Info;
+        };
+
+        ComponentMask m_Mask;
+        std::vector<ComponentTypeId> m_Types;   ///< Ascending.
+        std::vector<Column> m_Columns;          ///< Same order as m_Types.
+        int32_t m_ColumnOfType[MaxComponentTypes];
+        uint32_t m_ChunkCapacity = 0;
+        std::vector<Chunk> m_Chunks;
+
+        Archetype* m_AddEdges[MaxComponentTypes] = {};
+        Archetype* m_RemoveEdges[MaxComponentTypes] = {};
+    };
+}
@@ -0,0 +1,47 @@
+﻿#include "VexPch.h"
+#include "Component.h"
+
+#include "Vex/Log.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+namespace Vex
+{
+    static std::mutex s_RegistryMutex;
+    static ComponentInfo s_Components[MaxComponentTypes];
+    static uint32_t s_ComponentCount = 0;
+
+    ComponentTypeId ComponentRegistry::Register(const ComponentInfo& info)
+    {
+        std::lock_guard<std::mutex> lock(s_RegistryMutex);
+
+        for (uint32_t i = 0; i < s_ComponentCount; i++)
+        {
+            if (std::strcmp(s_Components[i].Name, info.Name) == 0)
+                return i;
+        }
+
+        if (s_ComponentCount == MaxComponentTypes)
+        {
+            VEX_CORE_FATAL("More than {0} component types registered; raise MaxComponentTypes", MaxComponentTypes);
+            Log::Shutdown();  // Flushes the message before the process dies
+            std::abort();
+        }
+
+        s_Components[s_ComponentCount] = info;
+        return s_ComponentCount++;
+    }
+
+    const ComponentInfo& ComponentRegistry::GetInfo(ComponentTypeId type)
+    {
+        return s_Components[type];
+    }
+
+    uint32_t ComponentRegistry::GetCount()
+    {
+        std::lock_guard<std::mutex> lock(s_RegistryMutex);
+        return s_ComponentCount;
+    }
+}
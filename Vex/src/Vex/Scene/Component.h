@@ -0,0 +1,141 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+
+namespace Vex
+{
+    using ComponentTypeId = uint32_t;
+
+    /** Component types a process may register. */
+    static constexpr uint32_t MaxComponentTypes = 128;
+
+    /** Largest component, so that a 16 KB chunk always holds a useful number of entities. */
+    static constexpr uint32_t MaxComponentSize = 4096;
+
+    /**
+     * How a component type is laid out and moved. Components are relocated with memcpy when
+     * trivially copyable and through Relocate() otherwise.
+     */
+    struct ComponentInfo
+    {
+        const char* Name = nullptr;     ///< typeid name; identifies the type across modules.
+        uint32_t Size = 0;
+        uint32_t Alignment = 0;
+        void (*Relocate)(void* destination, void* source) = nullptr;   ///< Move-constructs into uninitialized destination and destroys source.
+        void (*Destroy)(void* component) = nullptr;                    ///< Null for trivially destructible types.
+    };
+
+    /**
+     * Set of component types, one bit per ComponentTypeId.
+     */
+    struct ComponentMask
+    {
+        uint64_t Bits[MaxComponentTypes / 64] = {};
+
+        void Set(ComponentTypeId type) { Bits[type / 64] |= 1ull << (type % 64); }
+        void Clear(ComponentTypeId type) { Bits[type / 64] &= ~(1ull << (type % 64)); }
+        bool Has(ComponentTypeId type) const { return (Bits[type / 64] >> (type % 64)) & 1; }
+
+        /** @return True if every type in other is also in this mask. */
+        bool Contains(const ComponentMask& other) const
+        {
+            for (uint32_t i = 0; i < MaxComponentTypes / 64; i++)
+            {
+                if ((Bits[i] & other.Bits[i]) != other.Bits[i])
+                    return false;
+            }
+            return true;
+        }
+
+        bool Intersects(const ComponentMask& other) const
+        {
+            for (uint32_t i = 0; i < MaxComponentTypes / 64; i++)
+            {
+                if (Bits[i] & other.Bits[i])
+                    return true;
+            }
+            return false;
+        }
+
+        bool operator==(const ComponentMask& other) const
+        {
+            for (uint32_t i = 0; i < MaxComponentTypes / 64; i++)
+            {
+                if (Bits[i] != other.Bits[i])
+                    return false;
+            }
+            return true;
+        }
+    };
+
+    struct ComponentMaskHash
+    {
+        size_t operator()(const ComponentMask& mask) const
+        {
+            uint64_t hash = 0;
+            for (uint64_t bits : mask.Bits)
+                hash = (hash ^ bits) * 0x9E3779B97F4A7C15ull;
+            return static_cast<size_t>(hash ^ (hash >> 32));
+        }
+    };
+
+    /**
+     * @class ComponentRegistry
+     * @brief Process-wide table of component types.
+     *
+     * Types are registered by name, so the engine and the application agree on a type's id even though
+     * each module caches it in its own ComponentTypeOf<T>() instance.
+     */
+    class VEX_API ComponentRegistry
+    {
+    public:
+        /** @return The id of the type with info.Name, registering it on first use. Thread-safe. */
+        static ComponentTypeId Register(const ComponentInfo& info);
+
+        static const ComponentInfo& GetInfo(ComponentTypeId type);
+        static uint32_t GetCount();
+    };
+
+    template<typename T>
+    ComponentInfo MakeComponentInfo()
+    {
+        static_assert(sizeof(T) <= MaxComponentSize, "Component too large for archetype chunks; store a handle to the data instead");
+        static_assert(alignof(T) <= 64, "Component alignment exceeds the 64 byte alignment of archetype chunks");
+        static_assert(std::is_nothrow_move_constructible_v<T>, "Components are moved between chunks and must be nothrow move constructible");
+
+        ComponentInfo info;
+        info.Name = typeid(T).name();
+        info.Size = static_cast<uint32_t>(sizeof(T));
+        info.Alignment = static_cast<uint32_t>(alignof(T));
+
+        if constexpr (!std::is_trivially_copyable_v<T>)
+        {
+            info.Relocate = [](void* destination, void* source)
+            {
+                T* from = std::launder(static_cast<T*>(source));
+                new (destination) T(std::move(*from));
+                from->~T();
+            };
+        }
+
+        if constexpr (!std::is_trivially_destructible_v<T>)
+            info.Destroy = [](void* component) { std::launder(static_cast<T*>(component))->~T(); };
+
+        return info;
+    }
+
+    /** @return The id of component type T; const is ignored. */
+    template<typename T>
+    ComponentTypeId ComponentTypeOf()
+    {
+        using Component = std::remove_cv_t<T>;
+        static const ComponentTypeId id = ComponentRegistry::Register(MakeComponentInfo<Component>());
+        return id;
+    }
+}
@@ -0,0 +1,175 @@
+﻿#include "VexPch.h"
+#include "World.h"
+
+#include "Vex/Log.h"
+
+#include <cstdlib>
+
+namespace Vex
+{
+    World::World()
+    {
+        m_EmptyArchetype = &GetOrCreateArchetype(ComponentMask());
+    }
+
+    World::~World()
+    {
+        // Archetypes destroy their entities' components and free their chunks
+        m_Archetypes.clear();
+        Archetype::FreeChunks(m_FreeChunks);
+    }
+
+    Archetype& World::GetOrCreateArchetype(const ComponentMask& mask)
+    {
+        auto it = m_ArchetypeOfMask.find(mask);
+        if (it != m_ArchetypeOfMask.end())
+            return *it->second;
+
+        m_Archetypes.push_back(std::make_unique<Archetype>(mask));
+        Archetype* archetype = m_Archetypes.back().get();
+        m_ArchetypeOfMask.emplace(mask, archetype);
+        return *archetype;
+    }
+
+    Entity World::AllocateEntity(Archetype& archetype, Archetype::Location& location)
+    {
+        Entity entity;
+        if (!m_FreeIndices.empty())
+        {
+            entity.Index = m_FreeIndices.back();
+            m_FreeIndices.pop_back();
+        }
+        else
+        {
+            entity.Index = static_cast<uint32_t>(m_Records.size());
+            m_Records.emplace_back();
+        }
+
+        EntityRecord& record = m_Records[entity.Index];
+        entity.Generation = record.Generation;
+
+        location = archetype.AllocateRow(entity, m_FreeChunks);
+        record.Owner = &archetype;
+        record.Location = location;
+
+        m_EntityCount++;
+        return entity;
+    }
+
+    Entity World::CreateEntity()
+    {
+        Archetype::Location location;
+        return AllocateEntity(*m_EmptyArchetype, location);
+    }
+
+    bool World::IsAlive(Entity entity) const
+    {
+        return entity.Index < m_Records.size() && m_Records[entity.Index].Owner && m_Records[entity.Index].Generation == entity.Generation;
+    }
+
+    void World::DestroyEntity(Entity entity)
+    {
+        if (!IsAlive(entity))
+            return;
+
+        EntityRecord& record = m_Records[entity.Index];
+        record.Owner->DestroyRow(record.Location);
+
+        Entity moved = record.Owner->RemoveRow(record.Location, m_FreeChunks);
+        if (moved.IsValid())
+            m_Records[moved.Index].Location = record.Location;
+
+        // A new generation invalidates every handle to the old entity
+        record.Owner = nullptr;
+        record.Generation++;
+        m_FreeIndices.push_back(entity.Index);
+        m_EntityCount--;
+    }
+
+    void World::MoveEntity(EntityRecord& record, Entity entity, Archetype& destination)
+    {
+        Archetype& source = *record.Owner;
+        Archetype::Location location = destination.AllocateRow(entity, m_FreeChunks);
+
+        source.MoveRow(record.Location, destination, location);
+
+        Entity moved = source.RemoveRow(record.Location, m_FreeChunks);
+        if (moved.IsValid())
+            m_Records[moved.Index].Location = record.Location;
+
+        record.Owner = &destination;
+        record.Location = location;
+    }
+
+    void World::AbortOnDeadEntity(Entity entity)
+    {
+        VEX_CORE_FATAL("AddComponent<T> on an entity that is not alive ({0}:{1}) has no component to return", entity.Index, entity.Generation);
+        Log::Shutdown();  // Flushes the message before the process dies
+        std::abort();
+    }
+
+    void* World::AddComponent(Entity entity, ComponentTypeId type, bool& created)
+    {
+        created = false;
+        if (!IsAlive(entity))
+        {
+            VEX_CORE_ERROR("AddComponent on an entity that is not alive ({0}:{1})", entity.Index, entity.Generation);
+            return nullptr;
+        }
+
+        EntityRecord& record = m_Records[entity.Index];
+        Archetype& source = *record.Owner;
+
+        int32_t column = source.GetColumn(type);
+        if (column >= 0)
+            return source.GetComponent(record.Location, column);
+
+        Archetype* destination = source.GetAddEdge(type);
+        if (!destination)
+        {
+            ComponentMask mask = source.GetMask();
+            mask.Set(type);
+            destination = &GetOrCreateArchetype(mask);
+            source.SetAddEdge(type, destination);
+            destination->SetRemoveEdge(type, &source);
+        }
+
+        MoveEntity(record, entity, *destination);
+
+        created = true;
+        return destination->GetComponent(record.Location, destination->GetColumn(type));
+    }
+
+    void World::RemoveComponent(Entity entity, ComponentTypeId type)
+    {
+        if (!IsAlive(entity))
+            return;
+
+        EntityRecord& record = m_Records[entity.Index];
+        Archetype& source = *record.Owner;
+        if (source.GetColumn(type) < 0)
+            return;
+
+        Archetype* destination = source.GetRemoveEdge(type);
+        if (!destination)
+        {
+            ComponentMask mask = source.GetMask();
+            mask.Clear(type);
+            destination = &GetOrCreateArchetype(mask);
+            source.SetRemoveEdge(type, destination);
+            destination->SetAddEdge(type, &source);
+        }
+
+        MoveEntity(record, entity, *destination);
+    }
+
+    void* World::GetComponent(Entity entity, ComponentTypeId type) const
+    {
+        if (!IsAlive(entity))
+            return nullptr;
+
+        const EntityRecord& record = m_Records[entity.Index];
+        int32_t column = record.Owner->GetColumn(type);
+        return column >= 0 ? record.Owner->GetComponent(record.Location, column) : nullptr;
+    }
+}
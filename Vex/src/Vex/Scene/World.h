@@ -0,0 +1,300 @@
+﻿#pragma once
+
+#include "Vex/Core.h"
+#include "Vex/Jobs/JobSystem.h"
+#include "Vex/Scene/Archetype.h"
+
+#include <array>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Vex
+{
+    template<typename... Ts>
+    class Query;
+
+    /**
+     * @class World
+     * @brief Archetype-based entity-component store.
+     *
+     * Every entity belongs to the Archetype of its exact set of components, and its components live in that
+     * archetype's chunks as structure-of-arrays. Adding or removing a component moves the entity to the
+     * neighbouring archetype; those transitions are cached on the archetypes, so repeated changes of the
+     * same kind cost a row copy rather than a lookup. Emptied chunks are kept and reused.
+     *
+     * Components must be nothrow move constructible; each entity has at most one of each type, and one
+     * entity's components together must fit a chunk (Archetype::ChunkSize), or the World aborts. Adding,
+     * removing, creating or destroying while a Query iterates is not allowed. Not thread-safe; queries may
+     * hand chunks to other threads (see Query::ParallelForEach).
+     */
+    class VEX_API World
+    {
+    public:
+        World();
+        ~World();
+
+        World(const World&) = delete;
+        World& operator=(const World&) = delete;
+
+        /** Creates an entity without components. */
+        Entity CreateEntity();
+
+        /** Creates an entity directly in the archetype of the given components, without intermediate moves. */
+        template<typename... Ts>
+        Entity CreateEntity(Ts&&... components)
+        {
+            ComponentTypeId types[] = { ComponentTypeOf<std::decay_t<Ts>>()... };
+
+            ComponentMask mask;
+            for (ComponentTypeId type : types)
+                mask.Set(type);
+
+            Archetype& archetype = GetOrCreateArchetype(mask);
+            Archetype::Location location;
+            Entity entity = AllocateEntity(archetype, location);
+
+            (new (archetype.GetComponent(location, archetype.GetColumn(ComponentTypeOf<std::decay_t<Ts>>())))
+                std::decay_t<Ts>(std::forward<Ts>(components)), ...);
+            return entity;
+        }
+
+        void DestroyEntity(Entity entity);
+        bool IsAlive(Entity entity) const;
+
+        /**
+         * Adds a component, or replaces it if the entity already has one. The entity must be alive: there is no
+         * component to hand back for a dead one, so the call logs and aborts.
+         */
+        template<typename T, typename... Args>
+        T& AddComponent(Entity entity, Args&&... args)
+        {
+            bool created = false;
+            T* component = static_cast<T*>(AddComponent(entity, ComponentTypeOf<T>(), created));
+            if (!component)
+                AbortOnDeadEntity(entity);
+
+            if (!created)
+            {
+                *component = T(std::forward<Args>(args)...);
+                return *component;
+            }
+
+            return *new (component) T(std::forward<Args>(args)...);
+        }
+
+        template<typename T>
+        void RemoveComponent(Entity entity) { RemoveComponent(entity, ComponentTypeOf<T>()); }
+
+        template<typename T>
+        bool HasComponent(Entity entity) const { return GetComponent(entity, ComponentTypeOf<T>()) != nullptr; }
+
+        /** @return The entity's component, or nullptr if it has none or is not alive. */
+        template<typename T>
+        T* TryGetComponent(Entity entity) { return static_cast<T*>(GetComponent(entity, ComponentTypeOf<T>())); }
+
+        /** The entity must have the component. */
+        template<typename T>
+        T& GetComponent(Entity entity) { return *TryGetComponent<T>(entity); }
+
+        /**
+         * @brief Returns a query over every entity that has all of Ts.
+         *
+         * Keep the query around: it remembers which archetypes match and only checks archetypes created since
+         * its last use.
+         */
+        template<typename... Ts>
+        Query<Ts...> CreateQuery() { return Query<Ts...>(*this); }
+
+        uint32_t GetEntityCount() const { return m_EntityCount; }
+        const std::vector<std::unique_ptr<Archetype>>& GetArchetypes() const { return m_Archetypes; }
+
+        // Type-erased forms of the templates above
+
+        /**
+         * @return Storage for the component: uninitialized if created is set, the existing component otherwise,
+         * or nullptr if the entity is not alive.
+         */
+        void* AddComponent(Entity entity, ComponentTypeId type, bool& created);
+        void RemoveComponent(Entity entity, ComponentTypeId type);
+        void* GetComponent(Entity entity, ComponentTypeId type) const;
+
+    private:
+        struct EntityRecord
+        {
+            Archetype* Owner = nullptr;         ///< Null while the index is free.
+            Archetype::Location Location = {};
+            uint32_t Generation = 0;
+        };
+
+        Archetype& GetOrCreateArchetype(const ComponentMask& mask);
+
+        /** Out of line so the header needs no logging. */
+        [[noreturn]] static void AbortOnDeadEntity(Entity entity);
+
+        /** Takes a free index and appends a row for it to the archetype. */
+        Entity AllocateEntity(Archetype& archetype, Archetype::Location& location);
+
+        /** Moves an entity's row to another archetype and patches the record of the entity that filled the hole. */
+        void MoveEntity(EntityRecord& record, Entity entity, Archetype& destination);
+
+        std::vector<EntityRecord> m_Records;
+        std::vector<uint32_t> m_FreeIndices;
+        uint32_t m_EntityCount = 0;
+
+        std::vector<std::unique_ptr<Archetype>> m_Archetypes;   ///< Never removed, so queries can cache pointers.
+        std::unordered_map<ComponentMask, Archetype*, ComponentMaskHash> m_ArchetypeOfMask;
+        Archetype* m_EmptyArchetype = nullptr;
+        std::vector<std::byte*> m_FreeChunks;
+    };
+
+    /**
+     * @class Query
+     * @brief Compile-time typed iteration over every entity with all of Ts.
+     *
+     * Iterates matching archetypes chunk by chunk, walking each component array linearly. Declare a type
+     * const (Query<Position, const Velocity>) to get it by const reference. The function takes
+     * (Ts&...) or (Entity, Ts&...); the chunk variants take (uint32_t count, const Entity*, Ts*...), the
+     * arrays of one chunk, for loops the compiler can vectorize.
+     */
+    template<typename... Ts>
+    class Query
+    {
+    public:
+        explicit Query(World& world)
+            : m_World(world), m_Types{ ComponentTypeOf<Ts>()... }
+        {
+            for (ComponentTypeId type : m_Types)
+                m_Mask.Set(type);
+        }
+
+        template<typename F>
+        void ForEach(F&& function)
+        {
+            ForEachChunk([&function](uint32_t count, const Entity* entities, Ts*... components)
+            {
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    if constexpr (std::is_invocable_v<F&, Entity, Ts&...>)
+                        function(entities[i], components[i]...);
+                    else
+                        function(components[i]...);
+                }
+            });
+        }
+
+        template<typename F>
+        void ForEachChunk(F&& function)
+        {
+            Update();
+            for (Archetype* archetype : m_Archetypes)
+            {
+                std::array<int32_t, sizeof...(Ts)> columns = GetColumns(*archetype);
+                for (const Chunk& chunk : archetype->GetChunks())
+                    RunChunk(*archetype, chunk, columns, function, std::index_sequence_for<Ts...>());
+            }
+        }
+
+        /**
+         * @brief Like ForEach(), with the chunks split across the job system. Returns when all are done.
+         *
+         * The function runs concurrently for different chunks; it may write the entity's own components but
+         * must not touch other entities or change the World.
+         * @param chunksPerJob Chunks handed to each job; 0 picks enough jobs to keep every thread busy.
+         */
+        template<typename F>
+        void ParallelForEach(JobSystem& jobSystem, F&& function, uint32_t chunksPerJob = 0)
+        {
+            ParallelForEachChunk(jobSystem, [&function](uint32_t count, const Entity* entities, Ts*... components)
+            {
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    if constexpr (std::is_invocable_v<F&, Entity, Ts&...>)
+                        function(entities[i], components[i]...);
+                    else
+                        function(components[i]...);
+                }
+            }, chunksPerJob);
+        }
+
+        template<typename F>
+        void ParallelForEachChunk(JobSystem& jobSystem, F&& function, uint32_t chunksPerJob = 0)
+        {
+            Update();
+
+            m_Chunks.clear();
+            for (Archetype* archetype : m_Archetypes)
+            {
+                for (const Chunk& chunk : archetype->GetChunks())
+                    m_Chunks.push_back({ archetype, &chunk });
+            }
+
+            uint32_t chunkCount = static_cast<uint32_t>(m_Chunks.size());
+            if (chunksPerJob == 0)
+                chunksPerJob = std::max(chunkCount / (std::max(jobSystem.GetThreadCount(), 1u) * 4), 1u);
+
+            jobSystem.ParallelFor(chunkCount, chunksPerJob, [this, &function](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; i++)
+                {
+                    const Archetype& archetype = *m_Chunks[i].Owner;
+                    RunChunk(archetype, *m_Chunks[i].Block, GetColumns(archetype), function, std::index_sequence_for<Ts...>());
+                }
+            });
+        }
+
+        /** @return Number of entities the query currently matches. */
+        uint32_t GetEntityCount()
+        {
+            Update();
+
+            uint32_t count = 0;
+            for (Archetype* archetype : m_Archetypes)
+                count += archetype->GetEntityCount();
+            return count;
+        }
+
+    private:
+        struct ChunkReference
+        {
+            const Archetype* Owner;
+            const Chunk* Block;
+        };
+
+        /** Picks up archetypes created since the last call. */
+        void Update()
+        {
+            const std::vector<std::unique_ptr<Archetype>>& archetypes = m_World.GetArchetypes();
+            for (; m_ArchetypesChecked < archetypes.size(); m_ArchetypesChecked++)
+            {
+                Archetype* archetype = archetypes[m_ArchetypesChecked].get();
+                if (archetype->GetMask().Contains(m_Mask))
+                    m_Archetypes.push_back(archetype);
+            }
+        }
+
+        std::array<int32_t, sizeof...(Ts)> GetColumns(const Archetype& archetype) const
+        {
+            std::array<int32_t, sizeof...(Ts)> columns = {};
+            for (size_t i = 0; i < sizeof...(Ts); i++)
+                columns[i] = archetype.GetColumn(m_Types[i]);
+            return columns;
+        }
+
+        template<typename F, size_t... I>
+        static void RunChunk(const Archetype& archetype, const Chunk& chunk, const std::array<int32_t, sizeof...(Ts)>& columns,
+            F& function, std::index_sequence<I...>)
+        {
+            function(chunk.Count, archetype.GetEntities(chunk), reinterpret_cast<Ts*>(archetype.GetColumnData(chunk, columns[I]))...);
+        }
+
+        World& m_World;
+        std::array<ComponentTypeId, sizeof...(Ts)> m_Types;
+        ComponentMask m_Mask;
+        std::vector<Archetype*> m_Archetypes;
+        size_t m_ArchetypesChecked = 0;
+        std::vector<ChunkReference> m_Chunks;   ///< Flattened chunk list of a parallel run; kept for its capacity.
+    };
+}
@@ -0,0 +1,28 @@
+﻿#pragma once
+
+namespace Vex
+{
+    /**
+     * Duration of a frame or simulation step, stored in seconds.
+     */
+    class Timestep
+    {
+    public:
+        Timestep(float time = 0.0f)
+            : m_Time(time)
+        {
+        }
+
+        /** Allows a Timestep to be used directly as a number of seconds. */
+        operator float() const { return m_Time; }
+
+        /** Returns the duration in seconds. */
+        float GetSeconds() const { return m_Time; }
+
+        /** Returns the duration in milliseconds. */
+        float GetMilliseconds() const { return m_Time * 1000.0f; }
+
+    private:
+        float m_Time;
+    };
+}
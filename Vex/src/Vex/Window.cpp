@@ -0,0 +1,24 @@
+﻿#include "VexPch.h"
+#include "Window.h"
+
+#include "Platform/Headless/HeadlessWindow.h"
+
+#ifdef VEX_PLATFORM_WINDOWS
+    #include "Platform/Windows/WindowsWindow.h"
+#endif
+
+namespace Vex
+{
+    /**
+     * Factory method for creating a platform-specific Window instance.
+     */
+    Window* Window::Create(const WindowProps& props)
+    {
+#ifdef VEX_PLATFORM_WINDOWS
+        if (!props.Headless)
+            return new WindowsWindow(props);
+#endif
+
+        return new HeadlessWindow(props);
+    }
+}
@@ -2,9 +2,15 @@
 
 #include "Vex/Core.h"
 #include "Vex/Events/Event.h"
+#include "Vex/Events/MouseEventCoalescer.h"
+
+#include <functional>
+#include <string>
 
 namespace Vex
 {
+    class EventQueue;
+
     /**
      * Struct representing properties used to initialize a window.
      */
@@ -13,11 +19,14 @@ namespace Vex
         std::string Title;
         unsigned int Width;
         unsigned int Height;
+        bool Headless;      ///< Create a window without a display; always the case on Linux.
+        bool UpdateInputState = true;   ///< Feed the Input polling state while pumping; off when pumped off the main thread.
 
         WindowProps(const std::string& title = "Vex Engine",
             unsigned int width = 1280,
-            unsigned int height = 720)
-            : Title(title), Width(width), Height(height)
+            unsigned int height = 720,
+            bool headless = false)
+            : Title(title), Width(width), Height(height), Headless(headless)
         {
         }
     };
@@ -42,12 +51,47 @@ namespace Vex
         /** Returns the height of the window in pixels. */
         virtual unsigned int GetHeight() = 0;
 
+        /** Returns the platform window (an SDL_Window*), or nullptr for a window without a display. */
+        virtual void* GetNativeWindow() const = 0;
+
         /** Sets the callback function to handle events. */
         virtual void SetEventCallback(const EventCallbackFn& callback) = 0;
 
+        /**
+         * Routes events into the given queue instead of the event callback.
+         * Passing nullptr restores synchronous dispatch through the callback.
+         */
+        virtual void SetEventQueue(EventQueue* queue) = 0;
+
+        /**
+         * Enables or disables coalescing of consecutive mouse motion and scroll events.
+         * When enabled, runs of motion events are merged into one event carrying the final position and the
+         * accumulated delta, and scroll offsets are summed. Ordering relative to key and button events is kept.
+         */
+        virtual void SetEventCoalescing(bool enabled) = 0;
+
+        /** Returns true if mouse event coalescing is enabled. */
+        virtual bool IsEventCoalescing() const = 0;
+
+        /** Returns how many events have been merged away since the window was created. */
+        virtual const EventCoalescingStats& GetCoalescingStats() const = 0;
+
+        /**
+         * Enables or disables an event type at its source. Disabled types are dropped by the OS layer
+         * before they are queued or translated, which for key and mouse types also hides them from the
+         * Input polling state. The Application disables the types that no registry handler or layer asks
+         * for (see Layer::SetEventMask); a type set here by hand keeps that setting until the set of
+         * wanted types changes. WindowClose cannot be disabled. Safe to call from any thread; applied on
+         * the next pump.
+         */
+        virtual void SetEventTypeEnabled(EventType type, bool enabled) = 0;
+
+        /** Returns false if the event type is dropped at the source. */
+        virtual bool IsEventTypeEnabled(EventType type) const = 0;
+
         // Future: Additional attributes such as VSync control, fullscreen toggle, etc.
 
-        /** Factory method to create a platform-specific window instance. */
+        /** Factory method to create a platform-specific window instance, or a headless one if requested. */
         static Window* Create(const WindowProps& props = WindowProps());
     };
 }
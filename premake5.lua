@@ -1,3 +1,11 @@
+-- The Vulkan renderer needs the Vulkan SDK (VULKAN_SDK) on Windows, the loader and headers on Linux
+newoption {
+    trigger = "vulkan",
+    description = "Build the Vulkan renderer backend"
+}
+
+vulkanSdk = os.getenv("VULKAN_SDK") or ""
+
 workspace "Vex"
 architecture "x64"
 
@@ -22,43 +30,66 @@ includedirs {"%{prj.name}/src", "%{prj.name}/vendor/spdlog/include", "%{prj.name
 
 includedirs {"%{prj.name}/src", "%{prj.name}/vendor/spdlog/include", "%{prj.name}/vendor/thirdparty/SDL2-2.30.5/include"}
 
-libdirs {"Vex/vendor/thirdparty/SDL2-2.30.5/lib/x64"}
-
-links {"SDL2"}
-
 filter "system:windows"
 cppdialect "C++20"
 staticruntime "On"
 systemversion "latest"
+buildoptions "/utf-8"
 
 defines {"VEX_PLATFORM_WINDOWS", "VEX_BUILD_DLL"}
 
+removefiles {"%{prj.name}/src/Platform/Linux/**"}
+
+libdirs {"Vex/vendor/thirdparty/SDL2-2.30.5/lib/x64"}
+
+links {"SDL2", "winmm"}
+
 postbuildcommands {("{COPY} %{cfg.buildtarget.relpath} ../bin/" .. outputdir .. "/Sandbox")}
 
+-- Linux builds are headless only: no SDL, no Windows backend
+filter "system:linux"
+cppdialect "C++20"
+pic "On"
+
+defines {"VEX_PLATFORM_LINUX", "VEX_BUILD_DLL"}
+
+removefiles {"%{prj.name}/src/Platform/Windows/**"}
+
+links {"pthread"}
+
+filter "options:vulkan"
+defines {"VEX_VULKAN"}
+
+filter {"options:vulkan", "system:windows"}
+includedirs {vulkanSdk .. "/Include"}
+libdirs {vulkanSdk .. "/Lib"}
+links {"vulkan-1"}
+
+filter {"options:vulkan", "system:linux"}
+links {"vulkan"}
+
 filter "configurations:Debug"
 defines "VEX_DEBUG"
 symbols "On"
-buildoptions "/utf-8"
 
 filter "configurations:Release"
 defines "VEX_RELEASE"
 optimize "On"
-buildoptions "/utf-8"
 
 filter "configurations:Dist"
 defines "VEX_DIST"
 optimize "On"
-buildoptions "/utf-8"
 
 project "Sandbox"
-location "Sandbox"
+-- The directory is spelled SandBox; case matters outside Windows
+location "SandBox"
 kind "ConsoleApp"
 language "C++"
 
 targetdir("bin/" .. outputdir .. "/%{prj.name}")
 objdir("bin-int/" .. outputdir .. "/%{prj.name}")
 
-files {"%{prj.name}/src/**.h", "%{prj.name}/src/**.cpp"}
+files {"SandBox/src/**.h", "SandBox/src/**.cpp"}
 
 includedirs {"Vex/vendor/spdlog/include", "Vex/vendor/thirdparty/SDL2-2.30.5/include", "Vex/src"}
 
@@ -68,21 +99,36 @@ filter "system:windows"
 cppdialect "C++20"
 staticruntime "On"
 systemversion "latest"
+buildoptions "/utf-8"
 
 defines {"VEX_PLATFORM_WINDOWS"}
 
+filter "system:linux"
+cppdialect "C++20"
+
+defines {"VEX_PLATFORM_LINUX"}
+
+links {"pthread"}
+
+-- Find libVex.so next to the executable
+linkoptions {"-Wl,-rpath,'$$ORIGIN/../Vex'"}
+
+-- Lets the application reach the renderer through the Vulkan headers
+filter "options:vulkan"
+defines {"VEX_VULKAN"}
+
+filter {"options:vulkan", "system:windows"}
+includedirs {vulkanSdk .. "/Include"}
+
 filter "configurations:Debug"
 defines "VEX_DEBUG"
 symbols "On"
-buildoptions "/utf-8"
 
 filter "configurations:Release"
 defines "VEX_RELEASE"
 optimize "On"
-buildoptions "/utf-8"
 
 filter "configurations:Dist"
 defines "VEX_DIST"
 optimize "On"
-buildoptions "/utf-8"
 